@@ -6,6 +6,7 @@
 #include "features/world/world.hpp"
 #include "features/ui/ui.hpp"
 #include "features/enemy_slime/enemy_slime.hpp"
+#include "features/enemies/spawn.hpp"
 #include "features/player/molecules/hearts_controller.hpp"
 
 int main() {
@@ -22,6 +23,9 @@ int main() {
     ui::init_ui();     // Initialize UI systems
     enemy::init_enemies(); // Initialize enemy systems
     
+    // Authored spawns materialise through the enemy factories as chunks stream in
+    world::set_spawn_handlers(enemies::spawn, enemies::retire);
+    
     // Initialize the hearts controller
     player::HeartsController::init();
     
@@ -105,15 +109,22 @@ int main() {
         BeginDrawing();
         ClearBackground(BLACK);
         
-        // Render world first (background)
+        // Render world first (ground now, trees and bushes queued)
+        core::render::begin_frame();
         world::render();
         
-        // Render player
+        // Queue player and enemies with the world objects
         player::render();
-        
-        // Render enemies
         enemy::render_enemies();
         
+        // Draw all queued sprites in one depth-sorted pass
+        core::render::flush();
+        
+        // Debug overlays go above the sprites
+        world::render_debug();
+        player::render_debug();
+        enemy::render_enemies_debug();
+        
         // Render UI on top
         ui::render_ui();
         
@@ -5,5 +5,6 @@
 #include "entity.hpp"
 #include "world.hpp"
 #include "ui.hpp"
+#include "render_queue.hpp"
 
 // Add any other core interfaces here as they are developed 
\ No newline at end of file
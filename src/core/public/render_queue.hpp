@@ -0,0 +1,51 @@
+/// render_queue.hpp — frame-level depth-sorted sprite queue shared by all slices
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+
+namespace core {
+namespace render {
+
+// Draw layers; everything on a lower layer is drawn before any higher one
+enum class Layer : std::uint8_t {
+    GROUND = 0,     // Decals lying flat on the ground
+    ENTITIES = 1,   // World objects, player and enemies, y-sorted together
+    OVERLAY = 2     // Effects drawn above the whole world
+};
+
+// One queued sprite in screen space
+struct SpriteCommand {
+    Texture2D texture;
+    Rectangle source;     // Texture region (negative height flips, as in DrawTextureRec)
+    Vector2 position;     // Top-left corner on screen
+    Color tint;
+};
+
+// Pack a layer and a world-space y depth (usually the sprite's bottom edge)
+// into one integer sort key: layer in the top 4 bits, biased depth below
+std::uint32_t make_sort_key(Layer layer, float depth_y);
+
+// Start a new frame (drops anything not flushed)
+void begin_frame();
+
+// Queue a whole texture or a texture region
+void submit(Layer layer, float depth_y, const Texture2D& texture, Vector2 position, Color tint);
+void submit(Layer layer, float depth_y, const Texture2D& texture, Rectangle source, Vector2 position, Color tint);
+
+// Sort queued sprites by key and draw them in one pass; equal keys keep submit order
+// PERF: O(n) LSD radix sort over 32-bit keys, buffers reused across frames
+void flush();
+
+// Number of sprites queued since the last begin_frame/flush
+int get_queued_count();
+
+// Sort (key, payload) pairs by key, stable; scratch must have the same size.
+// Exposed for testing.
+struct SortEntry {
+    std::uint32_t key;
+    std::uint32_t index;
+};
+void radix_sort(SortEntry* entries, SortEntry* scratch, int count);
+
+} // namespace render
+} // namespace core
@@ -14,6 +14,9 @@ void set_camera_target(const Vector2& target);
 // Collision detection
 bool is_position_walkable(float world_x, float world_y);
 
+// Terrain movement speed multiplier (1 on open ground)
+float get_speed_factor(float world_x, float world_y);
+
 // Coordinate conversion
 Vector2 screen_to_world(const Vector2& screen_pos);
 Vector2 world_to_screen(const Vector2& world_pos);
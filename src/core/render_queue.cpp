@@ -0,0 +1,99 @@
+/// render_queue.cpp — implementation of the frame render queue
+#include "public/render_queue.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace core {
+namespace render {
+
+namespace {
+    // Queued commands and their sort entries, kept allocated between frames
+    std::vector<SpriteCommand> commands;
+    std::vector<SortEntry> entries;
+    std::vector<SortEntry> scratch;
+
+    // Depth occupies the low 28 bits, biased so negative world y still sorts
+    constexpr int LAYER_SHIFT = 28;
+    constexpr std::uint32_t DEPTH_MASK = (1u << LAYER_SHIFT) - 1;
+    constexpr std::int64_t DEPTH_BIAS = 1 << (LAYER_SHIFT - 1);
+}
+
+std::uint32_t make_sort_key(Layer layer, float depth_y) {
+    // Clamp as float first so huge depths cannot overflow the integer conversion
+    float clamped = std::clamp(std::floor(depth_y), -static_cast<float>(DEPTH_BIAS), static_cast<float>(DEPTH_BIAS));
+    std::int64_t depth = std::clamp<std::int64_t>(static_cast<std::int64_t>(clamped) + DEPTH_BIAS, 0, DEPTH_MASK);
+    return (static_cast<std::uint32_t>(layer) << LAYER_SHIFT) | static_cast<std::uint32_t>(depth);
+}
+
+void begin_frame() {
+    commands.clear();
+    entries.clear();
+}
+
+void submit(Layer layer, float depth_y, const Texture2D& texture, Vector2 position, Color tint) {
+    Rectangle source = { 0.0f, 0.0f, static_cast<float>(texture.width), static_cast<float>(texture.height) };
+    submit(layer, depth_y, texture, source, position, tint);
+}
+
+void submit(Layer layer, float depth_y, const Texture2D& texture, Rectangle source, Vector2 position, Color tint) {
+    entries.push_back({ make_sort_key(layer, depth_y), static_cast<std::uint32_t>(commands.size()) });
+    commands.push_back({ texture, source, position, tint });
+}
+
+void radix_sort(SortEntry* entries, SortEntry* scratch, int count) {
+    if (count < 2) return;
+
+    SortEntry* from = entries;
+    SortEntry* to = scratch;
+
+    // Four stable counting passes, one per key byte
+    for (int shift = 0; shift < 32; shift += 8) {
+        int offsets[256] = {};
+        for (int i = 0; i < count; i++) {
+            offsets[(from[i].key >> shift) & 0xFF]++;
+        }
+
+        // Every key shares this byte: the pass would not move anything
+        if (offsets[(from[0].key >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        int total = 0;
+        for (int& offset : offsets) {
+            int bucket = offset;
+            offset = total;
+            total += bucket;
+        }
+        for (int i = 0; i < count; i++) {
+            to[offsets[(from[i].key >> shift) & 0xFF]++] = from[i];
+        }
+        std::swap(from, to);
+    }
+
+    if (from != entries) {
+        std::copy(from, from + count, entries);
+    }
+}
+
+void flush() {
+    int count = static_cast<int>(entries.size());
+    if (count > 0) {
+        scratch.resize(entries.size());
+        radix_sort(entries.data(), scratch.data(), count);
+
+        for (const SortEntry& entry : entries) {
+            const SpriteCommand& cmd = commands[entry.index];
+            DrawTextureRec(cmd.texture, cmd.source, cmd.position, cmd.tint);
+        }
+    }
+
+    begin_frame();
+}
+
+int get_queued_count() {
+    return static_cast<int>(entries.size());
+}
+
+} // namespace render
+} // namespace core
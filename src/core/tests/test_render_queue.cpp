@@ -0,0 +1,54 @@
+/// test_render_queue.cpp — Unit tests for the frame render queue sort
+
+#include <catch2/catch_all.hpp>
+#include "../public/render_queue.hpp"
+#include <random>
+#include <vector>
+
+using namespace core::render;
+
+TEST_CASE("Sort keys order by layer, then depth", "[core][render]") {
+    REQUIRE(make_sort_key(Layer::ENTITIES, -100.0f) < make_sort_key(Layer::ENTITIES, -99.0f));
+    REQUIRE(make_sort_key(Layer::ENTITIES, -1.0f) < make_sort_key(Layer::ENTITIES, 0.0f));
+    REQUIRE(make_sort_key(Layer::ENTITIES, 0.0f) < make_sort_key(Layer::ENTITIES, 1600.0f));
+    REQUIRE(make_sort_key(Layer::GROUND, 1.0e6f) < make_sort_key(Layer::ENTITIES, -1.0e6f));
+    REQUIRE(make_sort_key(Layer::ENTITIES, 1.0e12f) < make_sort_key(Layer::OVERLAY, -1.0e12f));
+}
+
+TEST_CASE("Radix sort is a stable sort by key", "[core][render]") {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> depth(-500, 3000);
+    std::uniform_int_distribution<int> layer(0, 2);
+
+    std::vector<SortEntry> entries;
+    for (std::uint32_t i = 0; i < 2000; i++) {
+        entries.push_back({ make_sort_key(static_cast<Layer>(layer(rng)), static_cast<float>(depth(rng))), i });
+    }
+
+    std::vector<SortEntry> expected = entries;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const SortEntry& a, const SortEntry& b) { return a.key < b.key; });
+
+    std::vector<SortEntry> scratch(entries.size());
+    radix_sort(entries.data(), scratch.data(), static_cast<int>(entries.size()));
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        REQUIRE(entries[i].key == expected[i].key);
+        REQUIRE(entries[i].index == expected[i].index);
+    }
+}
+
+TEST_CASE("Radix sort handles trivial inputs", "[core][render]") {
+    SortEntry scratch[4];
+
+    SortEntry same[3] = { { 7, 0 }, { 7, 1 }, { 7, 2 } };
+    radix_sort(same, scratch, 3);
+    REQUIRE(same[0].index == 0);
+    REQUIRE(same[2].index == 2);
+
+    SortEntry one[1] = { { 9, 5 } };
+    radix_sort(one, scratch, 1);
+    REQUIRE(one[0].index == 5);
+
+    radix_sort(nullptr, nullptr, 0);
+}
@@ -20,6 +20,11 @@ bool is_position_walkable(float world_x, float world_y) {
     return ::world::is_walkable(world_x, world_y);
 }
 
+float get_speed_factor(float world_x, float world_y) {
+    // Delegate to world module
+    return ::world::get_speed_factor(world_x, world_y);
+}
+
 Vector2 screen_to_world(const Vector2& screen_pos) {
     // Delegate to world module
     return ::world::screen_to_world(screen_pos);
@@ -71,8 +71,14 @@ BehaviorResult wander_noise(EnemyRuntime& enemy, float dt) {
         wander.spawn_point.y + noise_val_y * wander.radius
     };
     
-    // Apply seeking behavior toward the wander target
-    apply_seek_weights(enemy, wander_target, 0.8f); // Lower gain for gentler wandering
+    // Far from home (after a chase) walk a path back; otherwise seek the
+    // wander target directly
+    if (distance(enemy.position, wander.spawn_point) > wander.radius * 2.0f) {
+        apply_path_weights(enemy, wander.spawn_point, dt, 0.8f);
+    } else {
+        apply_seek_weights(enemy, wander_target, 0.8f); // Lower gain for gentler wandering
+        clear_path(enemy);
+    }
     
     // Apply the steering movement
     enemy.apply_steering_movement(enemy.spec->speed, dt);
@@ -371,8 +377,8 @@ BehaviorResult apply_context_steering(EnemyRuntime& enemy, float dt) {
     // Get direction vector from the best ray
     Vector2 move_dir = enemy.get_ray_dir(best_ray);
     
-    // Apply movement
-    float adjusted_speed = enemy.spec->speed * dt;
+    // Apply movement, slowed by the terrain underfoot
+    float adjusted_speed = enemy.spec->speed * world::get_speed_factor(enemy.position.x, enemy.position.y) * dt;
     enemy.position.x += move_dir.x * adjusted_speed;
     enemy.position.y += move_dir.y * adjusted_speed;
     
@@ -413,6 +419,93 @@ void apply_seek_weights(EnemyRuntime& enemy, Vector2 target, float gain) {
     }
 }
 
+// Apply weights for seeking along the shared flow field
+void apply_flow_weights(EnemyRuntime& enemy, Vector2 target, float gain) {
+    Vector2 flow_dir;
+    if (world::get_flow_direction(enemy.position, &flow_dir)) {
+        target = { enemy.position.x + flow_dir.x, enemy.position.y + flow_dir.y };
+    }
+    apply_seek_weights(enemy, target, gain);
+}
+
+// Apply weights for walking a searched path
+void apply_path_weights(EnemyRuntime& enemy, Vector2 target, float dt, float gain) {
+    auto& follow = enemy.follow_path;
+    constexpr float REPATH_DISTANCE = 32.0f;   // About a tile
+    constexpr float ARRIVE_RADIUS = 12.0f;     // Close enough to a waypoint to take the next
+    
+    // Collect a finished leg search
+    if (follow.request != 0) {
+        switch (world::poll_path(follow.request, &follow.waypoints)) {
+            case world::PathStatus::PENDING:
+                break;
+            case world::PathStatus::FOUND:
+                follow.next = 0;
+                follow.request = 0;
+                break;
+            default:
+                follow.waypoints.clear();
+                follow.request = 0;
+                break;
+        }
+    }
+    
+    // Drop the current leg's path (and its search, if still running)
+    auto drop_leg = [&follow]() {
+        if (follow.request != 0) {
+            world::cancel_path(follow.request);
+            follow.request = 0;
+        }
+        follow.waypoints.clear();
+        follow.repath_timer = 0.0f;
+    };
+    
+    // Plan the route again when the target moved
+    if (follow.route.empty() || distance(follow.goal, target) > REPATH_DISTANCE) {
+        if (!world::plan_route(enemy.position, target, &follow.route)) {
+            follow.route = { target };
+        }
+        follow.route_next = 0;
+        follow.goal = target;
+        drop_leg();
+    }
+    
+    // Legs end at the first tile of the next chunk; take the next leg on arrival
+    if (follow.route_next + 1 < follow.route.size() &&
+        distance(enemy.position, follow.route[follow.route_next]) < ARRIVE_RADIUS) {
+        follow.route_next++;
+        drop_leg();
+    }
+    Vector2 leg_end = follow.route[follow.route_next];
+    
+    // Refine the leg, and refresh it now and then (repeats are cache hits)
+    follow.repath_timer -= dt;
+    if (follow.request == 0 && follow.repath_timer <= 0.0f) {
+        follow.request = world::request_path(enemy.position, leg_end);
+        follow.repath_timer = follow.repath_interval;
+    }
+    
+    while (follow.next < follow.waypoints.size() &&
+           distance(enemy.position, follow.waypoints[follow.next]) < ARRIVE_RADIUS) {
+        follow.next++;
+    }
+    if (follow.next < follow.waypoints.size()) {
+        leg_end = follow.waypoints[follow.next];
+    }
+    apply_seek_weights(enemy, leg_end, gain);
+}
+
+// Forget the route being followed
+void clear_path(EnemyRuntime& enemy) {
+    auto& follow = enemy.follow_path;
+    if (follow.request != 0) {
+        world::cancel_path(follow.request);
+        follow.request = 0;
+    }
+    follow.route.clear();
+    follow.waypoints.clear();
+}
+
 // Apply weights for strafing around a target
 void apply_strafe_weights(EnemyRuntime& enemy, Vector2 target, int direction, float gain) {
     // Get direction to target
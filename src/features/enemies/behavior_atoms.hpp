@@ -51,6 +51,21 @@ void draw_steering_weights(const EnemyRuntime& enemy, bool screen_space = true);
 /// Apply weights for seeking a target
 void apply_seek_weights(EnemyRuntime& enemy, Vector2 target, float gain = 1.0f);
 
+/// Apply weights for seeking the world's flow target (see world::set_flow_target)
+/// along the shared flow field, around water and trees; seeks target directly
+/// where the field has no direction
+void apply_flow_weights(EnemyRuntime& enemy, Vector2 target, float gain = 1.0f);
+
+/// Apply weights for walking a searched path to target: the route is planned
+/// (world::plan_route) when the target moves a tile, and each leg's path is
+/// requested (world::request_path) as the leg starts and every repath_interval.
+/// Seeks the leg end directly while its path is pending or if there is none.
+/// PERF: O(1) per frame apart from route plans; leg searches run on the world's worker thread
+void apply_path_weights(EnemyRuntime& enemy, Vector2 target, float dt, float gain = 1.0f);
+
+/// Forget the route being followed (cancels its pending search)
+void clear_path(EnemyRuntime& enemy);
+
 /// Apply weights for strafing around a target
 void apply_strafe_weights(EnemyRuntime& enemy, Vector2 target, int direction, float gain = 1.0f);
 
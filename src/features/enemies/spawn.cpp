@@ -0,0 +1,40 @@
+/// spawn.cpp — Implementation of spawn request dispatch
+
+#include "spawn.hpp"
+#include <array>
+
+namespace enemies {
+
+namespace {
+    struct FactoryEntry {
+        SpawnFactory spawn;
+        RetireFactory retire;
+    };
+
+    // One slot per EnemyID
+    std::array<FactoryEntry, ENEMY_ID_COUNT> factories;
+}
+
+void register_spawn_factory(EnemyID id, SpawnFactory spawn, RetireFactory retire) {
+    factories[static_cast<int>(id)] = { std::move(spawn), std::move(retire) };
+}
+
+void clear_spawn_factories() {
+    factories.fill({});
+}
+
+int spawn(const EnemySpawnRequest& request) {
+    const FactoryEntry& entry = factories[static_cast<int>(request.id)];
+    if (!entry.spawn) {
+        TraceLog(LOG_WARNING, "No spawn factory for %s", to_string(request.id));
+        return -1;
+    }
+    return entry.spawn(request);
+}
+
+bool retire(const EnemySpawnRequest& request, int handle) {
+    const FactoryEntry& entry = factories[static_cast<int>(request.id)];
+    return entry.retire ? entry.retire(handle) : false;
+}
+
+} // namespace enemies
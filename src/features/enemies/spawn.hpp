@@ -0,0 +1,27 @@
+/// spawn.hpp — Spawn request dispatch to type-specific enemy factories
+#pragma once
+
+#include "types.hpp"
+#include <functional>
+
+namespace enemies {
+
+/// Creates a live enemy for a request, returns a handle (>= 0) or -1 on failure
+using SpawnFactory = std::function<int(const EnemySpawnRequest& request)>;
+
+/// Removes the enemy behind a handle, returns true if it was still alive
+using RetireFactory = std::function<bool(int handle)>;
+
+/// Register the factories an enemy slice provides for one enemy ID
+void register_spawn_factory(EnemyID id, SpawnFactory spawn, RetireFactory retire);
+
+/// Drop all registered factories
+void clear_spawn_factories();
+
+/// Dispatch a request to its factory, returns -1 if no factory is registered
+int spawn(const EnemySpawnRequest& request);
+
+/// Retire an enemy created by spawn(), returns true if it was still alive
+bool retire(const EnemySpawnRequest& request, int handle);
+
+} // namespace enemies
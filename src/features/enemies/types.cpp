@@ -111,8 +111,8 @@ void EnemyRuntime::apply_steering_movement(float speed, float dt) {
     // Get direction vector from the best ray
     Vector2 move_dir = get_ray_dir(best_ray);
     
-    // Apply movement
-    float adjusted_speed = speed * dt;
+    // Apply movement, slowed by the terrain underfoot
+    float adjusted_speed = speed * world::get_speed_factor(position.x, position.y) * dt;
     position.x += move_dir.x * adjusted_speed;
     position.y += move_dir.y * adjusted_speed;
     
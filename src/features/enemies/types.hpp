@@ -23,6 +23,28 @@ enum class EnemyID {
     RUN_DRONE
 };
 
+/// Number of EnemyID values
+constexpr int ENEMY_ID_COUNT = static_cast<int>(EnemyID::RUN_DRONE) + 1;
+
+/// Schema name of an enemy ID ("FOR_SLIME", ...), as used in spawn files
+inline const char* to_string(EnemyID id) {
+    static const char* const names[ENEMY_ID_COUNT] = {
+        "FOR_SLIME", "FOR_BOAR", "CAV_BAT", "DES_SCARAB", "SNW_WOLF", "RUN_DRONE"
+    };
+    return names[static_cast<int>(id)];
+}
+
+/// Parse a schema name back into an enemy ID, returns false if unknown
+inline bool parse_enemy_id(const std::string& name, EnemyID& out_id) {
+    for (int i = 0; i < ENEMY_ID_COUNT; i++) {
+        if (name == to_string(static_cast<EnemyID>(i))) {
+            out_id = static_cast<EnemyID>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
 /// Types of items an enemy can drop
 enum class DropType {
     Heart,
@@ -200,6 +222,18 @@ struct AvoidObstacle {
     float avoidance_gain = 2.0f;                  // How strongly to avoid obstacles
 };
 
+/// Follow a searched path to a far target (see world::plan_route, world::request_path)
+struct FollowPath {
+    std::vector<Vector2> route;                   // Leg ends, the last one is the goal
+    std::size_t route_next = 0;                   // Leg being walked
+    unsigned request = 0;                         // Path request for the leg, 0 if none
+    std::vector<Vector2> waypoints;               // Turn points of the leg's path
+    std::size_t next = 0;                         // Waypoint being walked to
+    Vector2 goal = {0.0f, 0.0f};                  // Target the path was requested for
+    float repath_timer = 0.0f;                    // Time until the path is refreshed
+    float repath_interval = 1.0f;                 // Refresh period (cached paths are cheap)
+};
+
 /// NEW: Charge and dash attack
 struct ChargeDash {
     enum class State {
@@ -260,6 +294,7 @@ struct EnemyRuntime {
     float anim_timer;                             // Animation timer
     int anim_frame;                               // Current animation frame
     bool is_moving;                               // Whether enemy is currently moving
+    int spawn_handle = -1;                        // Handle given to a streamed spawn request, -1 if none
     
     // NEW: 16-ray steering grid for context steering
     static constexpr int NUM_RAYS = 16;           // Rays spread every 22.5 degrees
@@ -276,6 +311,7 @@ struct EnemyRuntime {
     StrafeTarget strafe_target;                   // Target strafing
     SeparateAllies separate_allies;               // Ally separation
     AvoidObstacle avoid_obstacle;                 // Obstacle avoidance
+    FollowPath follow_path;                       // Path to a far target
     ChargeDash charge_dash;                       // Charge and dash attack
     RangedShoot ranged_shoot;                     // Ranged attacks
     AttackMelee attack_melee;                     // Melee attacks
@@ -6,6 +6,7 @@
 #include "../../enemies/behavior_atoms.hpp"
 #include "../../world/world.hpp"
 #include "../../core/public/entity.hpp"
+#include <array>
 #include <cmath>
 #include <raymath.h>
 
@@ -45,29 +46,38 @@ enemies::BehaviorResult enhanced_obstacle_avoidance(enemies::EnemyRuntime& enemy
         dir_to_player = {0, 0};
     }
     
+    // Seek along the shared flow field where it has a direction, so paths bend
+    // around water and trees instead of pressing into them
+    Vector2 seek_dir = dir_to_player;
+    Vector2 flow_dir;
+    if (world::get_flow_direction(enemy.position, &flow_dir)) {
+        seek_dir = flow_dir;
+    }
+    
     // Apply seeking weights (stronger in direction of player)
     for (int i = 0; i < enemy.NUM_RAYS; i++) {
         // Get ray direction
         Vector2 ray_dir = enemy.get_ray_dir(i);
         
-        // Calculate dot product (alignment between ray and player direction)
-        float dot = ray_dir.x * dir_to_player.x + ray_dir.y * dir_to_player.y;
+        // Calculate dot product (alignment between ray and seek direction)
+        float dot = ray_dir.x * seek_dir.x + ray_dir.y * seek_dir.y;
         
         // Apply weight (higher when ray points toward player)
         enemy.weights[i] += powf(fmaxf(0.0f, dot), 2.0f) * 1.5f;
     }
     
-    // Now apply obstacle avoidance using world::raycast
+    // Now apply obstacle avoidance using world::get_steering_distances
     const float FAR_LOOKAHEAD = 150.0f;   // Look further ahead
     const float NEAR_LOOKAHEAD = 50.0f;   // Look nearby
     
-    // Cast rays in all directions for obstacle detection
+    // The ray directions match the world's steering fan, so the distances come
+    // from its per-tile cache rather than fresh raycasts
+    std::array<float, enemies::EnemyRuntime::NUM_RAYS> distances;
+    world::get_steering_distances(enemy.position, distances.data(), enemy.NUM_RAYS, FAR_LOOKAHEAD);
+    
     for (int i = 0; i < enemy.NUM_RAYS; i++) {
-        // Get ray direction
         Vector2 ray_dir = enemy.get_ray_dir(i);
-        
-        // Use world::raycast to get distance to obstacles
-        float distance = world::raycast(enemy.position, ray_dir, FAR_LOOKAHEAD);
+        float distance = distances[i];
         
         // Apply strong avoidance for nearby obstacles
         if (distance < NEAR_LOOKAHEAD) {
@@ -145,10 +155,11 @@ enemies::BehaviorResult chase_player(enemies::EnemyRuntime& enemy, float dt) {
     // Calculate distance to player
     float dist = Vector2Distance(enemy.position, player_pos);
     
-    // If player is within detection radius, chase
-    if (dist <= enemy.spec->detection_radius) {
-        // Apply seeking weights toward player
-        enemies::atoms::apply_seek_weights(enemy, player_pos, 1.0f);
+    // If player is within detection radius, in sight and can be reached, chase
+    if (dist <= enemy.spec->detection_radius && world::has_line_of_sight(enemy.position) &&
+        world::is_reachable(enemy.position, player_pos)) {
+        // Apply seeking weights toward player, along the flow field
+        enemies::atoms::apply_flow_weights(enemy, player_pos, 1.0f);
         return enemies::BehaviorResult::Running;
     }
     
@@ -164,8 +175,9 @@ enemies::BehaviorResult chase_player_smart(enemies::EnemyRuntime& enemy, float d
     // Calculate distance to player
     float dist = Vector2Distance(enemy.position, player_pos);
     
-    // If player is within detection radius, chase with obstacle avoidance
-    if (dist <= enemy.spec->detection_radius) {
+    // If player is within detection radius, in sight and can be reached, chase with obstacle avoidance
+    if (dist <= enemy.spec->detection_radius && world::has_line_of_sight(enemy.position) &&
+        world::is_reachable(enemy.position, player_pos)) {
         // Use the enhanced obstacle avoidance implementation
         return enhanced_obstacle_avoidance(enemy, dt);
     }
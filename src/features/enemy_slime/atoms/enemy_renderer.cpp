@@ -5,6 +5,7 @@
 #include "behavior_atoms.hpp"  // Include to access debug flag functions
 #include "../../world/world.hpp"
 #include "features/enemies/behavior_atoms.hpp" // Include for steering visualization
+#include "core/public/render_queue.hpp"
 #include <raylib.h>
 
 namespace enemy {
@@ -40,11 +41,23 @@ void render_enemies() {
             texture = &slime_squash_texture;
         }
         
-        // Draw the enemy
+        // Draw the enemy, sorted against the world and the player by its bottom edge
         // Center the texture on the enemy position
-        DrawTextureV(*texture, 
-                   Vector2{screen_pos.x - texture->width/2, screen_pos.y - texture->height/2}, 
-                   enemy.color);
+        core::render::submit(core::render::Layer::ENTITIES,
+                             enemy.position.y + texture->height / 2.0f,
+                             *texture,
+                             Vector2{screen_pos.x - texture->width/2, screen_pos.y - texture->height/2}, 
+                             enemy.color);
+    }
+}
+
+void render_enemies_debug() {
+    const std::vector<enemies::EnemyRuntime>& enemies = get_enemies();
+    
+    for (const auto& enemy : enemies) {
+        if (!enemy.active) continue;
+        
+        Vector2 screen_pos = world::world_to_screen(enemy.position);
         
         // Draw debug visualization if enabled
         if (is_debug_visualization_enabled()) {
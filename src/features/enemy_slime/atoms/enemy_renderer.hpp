@@ -11,10 +11,13 @@ namespace atoms {
 /// Initialize the enemy renderer with textures
 void init_renderer();
 
-/// Render all active enemies
+/// Submit all active enemies to the core::render queue
 /// PERF: ~0.2-1.0ms depending on enemy count and screen size
 void render_enemies();
 
+/// Draw debug overlays for all active enemies (if enabled), after the queue is flushed
+void render_enemies_debug();
+
 /// Enable or disable debug visualization
 void set_debug_visualization(bool enabled);
 
@@ -179,8 +179,11 @@ void spawn_enemies_around_player(const Vector2& player_position,
                 type = enemies::EnemyType::SLIME_SMALL;
             }
             
-            // Verify spawn position is walkable
-            if (world::is_walkable(spawn_pos.x, spawn_pos.y)) {
+            // Verify spawn position is walkable, and that the player can be
+            // reached from it (is_reachable alone lets a blocked tile borrow
+            // an open neighbour's region)
+            if (world::is_walkable(spawn_pos.x, spawn_pos.y) &&
+                world::is_reachable(spawn_pos, player_position)) {
                 // Spawn the enemy and add to list
                 enemies.push_back(spawn_enemy(spawn_pos, type));
                 break;
@@ -68,6 +68,11 @@ float calculate_distance(const Vector2& a, const Vector2& b) {
 void update_enemy_states(float dt) {
     Vector2 player_pos = player::get_position();
     
+    // Every chasing enemy follows the same flow field toward the player,
+    // and sees the player through the same field of view
+    world::set_flow_target(player_pos);
+    world::set_sight_origin(player_pos);
+    
     for (auto& enemy : enemies) {
         if (!enemy.active) continue;
         
@@ -94,24 +99,25 @@ void update_enemy_states(float dt) {
             }
         }
         
-        // If not attacking, determine movement behaviors
+        // If not attacking, determine movement behaviors. A player hidden
+        // behind trees or cut off by water is not chased; the enemy keeps wandering.
+        float dist_to_player = calculate_distance(enemy.position, player_pos);
+        bool can_chase = dist_to_player <= enemy.spec->detection_radius &&
+                         world::has_line_of_sight(enemy.position) &&
+                         world::is_reachable(enemy.position, player_pos);
         
         // Chase behavior
         if (static_cast<int>(enemy.spec->behavior_flags & enemies::BehaviorFlags::BASIC_CHASE) != 0) {
-            float dist_to_player = calculate_distance(enemy.position, player_pos);
-            
-            if (dist_to_player <= enemy.spec->detection_radius) {
+            if (can_chase) {
                 // Player is within detection range - chase
-                enemies::atoms::apply_seek_weights(enemy, player_pos, 1.0f);
+                enemies::atoms::apply_flow_weights(enemy, player_pos, 1.0f);
             }
         } else if (static_cast<int>(enemy.spec->behavior_flags & enemies::BehaviorFlags::ADVANCED_CHASE) != 0) {
-            float dist_to_player = calculate_distance(enemy.position, player_pos);
-            
-            if (dist_to_player <= enemy.spec->detection_radius) {
+            if (can_chase) {
                 // Player is within detection range
                 if (dist_to_player > enemy.spec->attack_radius * 1.5f) {
                     // Far enough - seek player
-                    enemies::atoms::apply_seek_weights(enemy, player_pos, 1.0f);
+                    enemies::atoms::apply_flow_weights(enemy, player_pos, 1.0f);
                 } else {
                     // Close enough - strafe around player
                     enemies::atoms::apply_strafe_weights(
@@ -125,9 +131,7 @@ void update_enemy_states(float dt) {
         
         // Wander behavior (only if not chasing)
         if (static_cast<int>(enemy.spec->behavior_flags & enemies::BehaviorFlags::WANDER_NOISE) != 0) {
-            float dist_to_player = calculate_distance(enemy.position, player_pos);
-            
-            if (dist_to_player > enemy.spec->detection_radius) {
+            if (!can_chase) {
                 // Not chasing player, apply wandering
                 enemies::atoms::wander_noise(enemy, dt);
             }
@@ -206,6 +210,26 @@ void add_enemy(const enemies::EnemyRuntime& enemy) {
     enemies.push_back(enemy);
 }
 
+int add_spawned_enemy(const enemies::EnemyRuntime& enemy) {
+    static int next_spawn_handle = 0;
+    enemies.push_back(enemy);
+    enemies.back().spawn_handle = next_spawn_handle;
+    return next_spawn_handle++;
+}
+
+bool remove_spawned_enemy(int handle) {
+    auto it = std::find_if(enemies.begin(), enemies.end(), [handle](const enemies::EnemyRuntime& enemy) {
+        return enemy.spawn_handle == handle;
+    });
+    if (it == enemies.end()) {
+        return false;
+    }
+    
+    bool alive = it->is_alive();
+    enemies.erase(it);
+    return alive;
+}
+
 void cleanup_inactive_enemies() {
     enemies.erase(
         std::remove_if(enemies.begin(), enemies.end(), [](const enemies::EnemyRuntime& enemy) {
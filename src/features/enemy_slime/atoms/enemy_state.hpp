@@ -18,6 +18,12 @@ void update_enemy_states(float dt);
 /// Add a new enemy instance to the state system
 void add_enemy(const EnemyRuntime& enemy);
 
+/// Add an enemy created for a streamed spawn request, returns its spawn handle
+int add_spawned_enemy(const EnemyRuntime& enemy);
+
+/// Remove the enemy with a spawn handle, returns true if it was still alive
+bool remove_spawned_enemy(int handle);
+
 /// Get all active enemy instances
 const std::vector<EnemyRuntime>& get_enemies();
 
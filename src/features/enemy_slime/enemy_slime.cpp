@@ -5,6 +5,7 @@
 #include "atoms/enemy_state.hpp"
 #include "atoms/enemy_renderer.hpp"
 #include "atoms/enemy_spawning.hpp"
+#include "features/enemies/spawn.hpp"
 #include "../player/player.hpp"
 #include "../world/world.hpp"
 #include "core/public/entity.hpp"
@@ -38,6 +39,15 @@ void init_enemies() {
     atoms::init_enemy_state();
     atoms::init_renderer();
     atoms::init_spawning();
+    
+    // Authored FOR_SLIME spawns stream in through the enemies spawn dispatch
+    enemies::register_spawn_factory(enemies::EnemyID::FOR_SLIME,
+        [](const enemies::EnemySpawnRequest& request) {
+            return atoms::add_spawned_enemy(atoms::spawn_enemy(request.position, enemies::EnemyType::SLIME_SMALL));
+        },
+        [](int handle) {
+            return atoms::remove_spawned_enemy(handle);
+        });
 }
 
 // PERF: ~0.05-0.5ms depending on enemy count
@@ -97,6 +107,10 @@ void render_enemies() {
     atoms::render_enemies();
 }
 
+void render_enemies_debug() {
+    atoms::render_enemies_debug();
+}
+
 void spawn_slime(Vector2 position) {
     // Create a slime at the given position using spawn_enemy
     enemies::EnemyRuntime slime = atoms::spawn_enemy(position, enemies::EnemyType::SLIME_SMALL);
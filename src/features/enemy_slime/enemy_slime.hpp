@@ -24,9 +24,12 @@ void init_enemies();
 /// Update all active enemies
 void update_enemies(float dt);
 
-/// Render all active enemies
+/// Render all active enemies (sprites go into the core::render queue)
 void render_enemies();
 
+/// Draw enemy debug overlays, after the render queue is flushed
+void render_enemies_debug();
+
 /// Spawn a slime at the given position
 void spawn_slime(Vector2 position);
 
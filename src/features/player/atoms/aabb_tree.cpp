@@ -0,0 +1,226 @@
+/// aabb_tree.cpp — implementation of the dynamic bounding volume tree atom
+#include "aabb_tree.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace player {
+namespace atoms {
+
+namespace {
+    // Insertion cost measure; perimeter behaves better than area for thin boxes
+    float perimeter(const Aabb& box) {
+        return 2.0f * ((box.max.x - box.min.x) + (box.max.y - box.min.y));
+    }
+}
+
+int AabbTree::create_proxy(const Aabb& box, int user_data) {
+    int proxy = allocate_node();
+    Node& node = nodes_[proxy];
+    node.box = {
+        { box.min.x - FAT_MARGIN, box.min.y - FAT_MARGIN },
+        { box.max.x + FAT_MARGIN, box.max.y + FAT_MARGIN }
+    };
+    node.user_data = user_data;
+    node.height = 0;
+    insert_leaf(proxy);
+    proxy_count_++;
+    return proxy;
+}
+
+void AabbTree::destroy_proxy(int proxy) {
+    remove_leaf(proxy);
+    free_node(proxy);
+    proxy_count_--;
+}
+
+bool AabbTree::move_proxy(int proxy, const Aabb& box, Vector2 displacement) {
+    if (aabb_contains(nodes_[proxy].box, box)) return false;
+
+    // Fatten, and stretch ahead of the motion so steady movement reinserts rarely
+    Aabb fat = {
+        { box.min.x - FAT_MARGIN, box.min.y - FAT_MARGIN },
+        { box.max.x + FAT_MARGIN, box.max.y + FAT_MARGIN }
+    };
+    float ahead_x = displacement.x * DISPLACEMENT_MULTIPLIER;
+    float ahead_y = displacement.y * DISPLACEMENT_MULTIPLIER;
+    if (ahead_x < 0.0f) fat.min.x += ahead_x; else fat.max.x += ahead_x;
+    if (ahead_y < 0.0f) fat.min.y += ahead_y; else fat.max.y += ahead_y;
+
+    remove_leaf(proxy);
+    nodes_[proxy].box = fat;
+    insert_leaf(proxy);
+    return true;
+}
+
+int AabbTree::allocate_node() {
+    if (free_list_ < 0) {
+        nodes_.emplace_back();
+        return static_cast<int>(nodes_.size()) - 1;
+    }
+    int node = free_list_;
+    free_list_ = nodes_[node].parent;
+    nodes_[node] = Node{};
+    return node;
+}
+
+void AabbTree::free_node(int node) {
+    nodes_[node].parent = free_list_;
+    nodes_[node].height = -1;
+    free_list_ = node;
+}
+
+void AabbTree::insert_leaf(int leaf) {
+    if (root_ < 0) {
+        root_ = leaf;
+        nodes_[leaf].parent = -1;
+        return;
+    }
+
+    // Descend towards the sibling that grows the tree's perimeter least
+    const Aabb leaf_box = nodes_[leaf].box;
+    int index = root_;
+    while (!nodes_[index].is_leaf()) {
+        const Node& node = nodes_[index];
+        float area = perimeter(node.box);
+        float combined_area = perimeter(aabb_union(node.box, leaf_box));
+
+        // Cost of pairing with this node, and of pushing the leaf further down
+        float cost = 2.0f * combined_area;
+        float inheritance = 2.0f * (combined_area - area);
+        auto descend_cost = [&](int child) {
+            const Node& c = nodes_[child];
+            float grown = perimeter(aabb_union(c.box, leaf_box));
+            return (c.is_leaf() ? grown : grown - perimeter(c.box)) + inheritance;
+        };
+        float cost1 = descend_cost(node.child1);
+        float cost2 = descend_cost(node.child2);
+
+        if (cost < cost1 && cost < cost2) break;
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+    const int sibling = index;
+
+    // New parent for the sibling and the leaf
+    const int old_parent = nodes_[sibling].parent;
+    const int new_parent = allocate_node();
+    Node& parent = nodes_[new_parent];
+    parent.parent = old_parent;
+    parent.box = aabb_union(leaf_box, nodes_[sibling].box);
+    parent.height = nodes_[sibling].height + 1;
+    parent.child1 = sibling;
+    parent.child2 = leaf;
+    nodes_[sibling].parent = new_parent;
+    nodes_[leaf].parent = new_parent;
+
+    if (old_parent < 0) {
+        root_ = new_parent;
+    } else if (nodes_[old_parent].child1 == sibling) {
+        nodes_[old_parent].child1 = new_parent;
+    } else {
+        nodes_[old_parent].child2 = new_parent;
+    }
+
+    refit_ancestors(new_parent);
+}
+
+void AabbTree::remove_leaf(int leaf) {
+    if (leaf == root_) {
+        root_ = -1;
+        return;
+    }
+
+    // The sibling takes the parent's place
+    const int parent = nodes_[leaf].parent;
+    const int grand_parent = nodes_[parent].parent;
+    const int sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+    free_node(parent);
+    nodes_[sibling].parent = grand_parent;
+    if (grand_parent < 0) {
+        root_ = sibling;
+        return;
+    }
+    if (nodes_[grand_parent].child1 == parent) {
+        nodes_[grand_parent].child1 = sibling;
+    } else {
+        nodes_[grand_parent].child2 = sibling;
+    }
+    refit_ancestors(grand_parent);
+}
+
+void AabbTree::refit_ancestors(int node) {
+    while (node >= 0) {
+        node = balance(node);
+        Node& n = nodes_[node];
+        n.height = 1 + std::max(nodes_[n.child1].height, nodes_[n.child2].height);
+        n.box = aabb_union(nodes_[n.child1].box, nodes_[n.child2].box);
+        node = n.parent;
+    }
+}
+
+int AabbTree::balance(int a) {
+    Node& node_a = nodes_[a];
+    if (node_a.is_leaf() || node_a.height < 2) return a;
+
+    const int b = node_a.child1;
+    const int c = node_a.child2;
+    const int difference = nodes_[c].height - nodes_[b].height;
+    if (difference >= -1 && difference <= 1) return a;
+
+    // Rotate the taller child (up) into a's place; a keeps the other child
+    // and the shorter of up's children, up keeps its taller child
+    const bool c_taller = difference > 1;
+    const int up = c_taller ? c : b;
+    const int stay = c_taller ? b : c;
+    Node& node_up = nodes_[up];
+    const int f = node_up.child1;
+    const int g = node_up.child2;
+    const int tall = nodes_[f].height > nodes_[g].height ? f : g;
+    const int short_child = tall == f ? g : f;
+
+    node_up.parent = node_a.parent;
+    node_a.parent = up;
+    if (node_up.parent < 0) {
+        root_ = up;
+    } else if (nodes_[node_up.parent].child1 == a) {
+        nodes_[node_up.parent].child1 = up;
+    } else {
+        nodes_[node_up.parent].child2 = up;
+    }
+
+    node_up.child1 = a;
+    node_up.child2 = tall;
+    node_a.child1 = stay;
+    node_a.child2 = short_child;
+    nodes_[short_child].parent = a;
+
+    node_a.box = aabb_union(nodes_[stay].box, nodes_[short_child].box);
+    node_a.height = 1 + std::max(nodes_[stay].height, nodes_[short_child].height);
+    node_up.box = aabb_union(node_a.box, nodes_[tall].box);
+    node_up.height = 1 + std::max(node_a.height, nodes_[tall].height);
+    return up;
+}
+
+bool AabbTree::validate() const {
+    if (root_ < 0) return proxy_count_ == 0;
+    if (nodes_[root_].parent != -1) return false;
+    int leaves = 0;
+    return validate_node(root_, &leaves) && leaves == proxy_count_;
+}
+
+bool AabbTree::validate_node(int node, int* leaves) const {
+    const Node& n = nodes_[node];
+    if (n.is_leaf()) {
+        (*leaves)++;
+        return n.height == 0 && n.child2 < 0;
+    }
+    const Node& c1 = nodes_[n.child1];
+    const Node& c2 = nodes_[n.child2];
+    if (c1.parent != node || c2.parent != node) return false;
+    if (n.height != 1 + std::max(c1.height, c2.height)) return false;
+    if (!aabb_contains(n.box, c1.box) || !aabb_contains(n.box, c2.box)) return false;
+    return validate_node(n.child1, leaves) && validate_node(n.child2, leaves);
+}
+
+} // namespace atoms
+} // namespace player
@@ -0,0 +1,184 @@
+/// aabb_tree.hpp — dynamic bounding volume tree atom for player slice
+#pragma once
+#include <raylib.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace player {
+namespace atoms {
+
+// Axis-aligned bounding box
+struct Aabb {
+    Vector2 min;
+    Vector2 max;
+};
+
+// Box helpers; inline since the tree queries call them per node
+inline bool aabb_overlaps(const Aabb& a, const Aabb& b) {
+    return a.min.x <= b.max.x && b.min.x <= a.max.x &&
+           a.min.y <= b.max.y && b.min.y <= a.max.y;
+}
+
+inline bool aabb_contains(const Aabb& outer, const Aabb& inner) {
+    return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y &&
+           inner.max.x <= outer.max.x && inner.max.y <= outer.max.y;
+}
+
+inline Aabb aabb_union(const Aabb& a, const Aabb& b) {
+    return {
+        { std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y) },
+        { std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y) }
+    };
+}
+
+// Slab test: true if the segment from + t * delta, t in [0, max_fraction],
+// touches the box; enter gets the first such t (0 if from is inside)
+inline bool aabb_ray_enter(const Aabb& box, Vector2 from, Vector2 delta, float max_fraction, float* enter) {
+    float t_enter = 0.0f;
+    float t_exit = max_fraction;
+    const float origin[2] = { from.x, from.y };
+    const float direction[2] = { delta.x, delta.y };
+    const float low[2] = { box.min.x, box.min.y };
+    const float high[2] = { box.max.x, box.max.y };
+    for (int axis = 0; axis < 2; axis++) {
+        if (direction[axis] == 0.0f) {
+            if (origin[axis] < low[axis] || origin[axis] > high[axis]) return false;
+            continue;
+        }
+        float t1 = (low[axis] - origin[axis]) / direction[axis];
+        float t2 = (high[axis] - origin[axis]) / direction[axis];
+        if (t1 > t2) std::swap(t1, t2);
+        t_enter = std::max(t_enter, t1);
+        t_exit = std::min(t_exit, t2);
+        if (t_enter > t_exit) return false;
+    }
+    *enter = t_enter;
+    return true;
+}
+
+// Dynamic AABB tree: leaves hold fattened boxes, so an object that moves a
+// little stays inside its leaf and costs nothing. When it escapes, the leaf
+// is reinserted at the cheapest sibling (by perimeter growth) and the boxes
+// and heights of its ancestors are refit on the way up, rotating subtrees
+// that get out of balance. Object sizes don't matter, unlike a grid.
+class AabbTree {
+public:
+    // Margin added around each side of a leaf's box
+    static constexpr float FAT_MARGIN = 8.0f;
+    // Leaves also stretch this many displacements ahead of a moving object
+    static constexpr float DISPLACEMENT_MULTIPLIER = 2.0f;
+
+    // Add a leaf for a tight box, returns its proxy id
+    int create_proxy(const Aabb& box, int user_data);
+
+    void destroy_proxy(int proxy);
+
+    // Update a leaf's tight box; displacement is how far the object just moved.
+    // Returns true if the leaf had to be reinserted.
+    // PERF: O(1) while the box stays inside the fat box, O(log n) otherwise
+    bool move_proxy(int proxy, const Aabb& box, Vector2 displacement);
+
+    int get_user_data(int proxy) const { return nodes_[proxy].user_data; }
+    const Aabb& get_fat_aabb(int proxy) const { return nodes_[proxy].box; }
+
+    // Call callback(user_data) for every leaf whose fat box overlaps the box;
+    // the callback returns false to stop
+    // PERF: no heap allocation
+    template <typename Callback>
+    void query(const Aabb& box, Callback&& callback) const;
+
+    // Call callback(user_data, max_fraction) for every leaf whose fat box the
+    // segment crosses before max_fraction (0 at from, 1 at to). The callback
+    // returns the new max_fraction: its own hit to clip the ray, the old
+    // value to ignore the leaf, 0 to stop.
+    // PERF: no heap allocation
+    template <typename Callback>
+    void ray_cast(Vector2 from, Vector2 to, Callback&& callback) const;
+
+    int get_height() const { return root_ < 0 ? 0 : nodes_[root_].height; }
+    int get_proxy_count() const { return proxy_count_; }
+
+    // Check parent links, heights and that every box contains its children (for tests)
+    bool validate() const;
+
+private:
+    // Balanced height stays far below this for any handle count
+    static constexpr int MAX_STACK = 64;
+
+    struct Node {
+        Aabb box;
+        int parent = -1;      // Next free node while on the free list
+        int child1 = -1;      // -1 for leaves
+        int child2 = -1;
+        int height = -1;      // 0 for leaves, -1 for free nodes
+        int user_data = -1;
+
+        bool is_leaf() const { return child1 < 0; }
+    };
+
+    std::vector<Node> nodes_;
+    int root_ = -1;
+    int free_list_ = -1;
+    int proxy_count_ = 0;
+
+    int allocate_node();
+    void free_node(int node);
+    void insert_leaf(int leaf);
+    void remove_leaf(int leaf);
+
+    // Refit boxes and heights from a node to the root, balancing on the way
+    void refit_ancestors(int node);
+
+    // Rotate a grandchild up if the node's subtrees differ in height by more
+    // than one; returns the node now at its place
+    int balance(int node);
+
+    bool validate_node(int node, int* leaves) const;
+};
+
+template <typename Callback>
+void AabbTree::query(const Aabb& box, Callback&& callback) const {
+    if (root_ < 0) return;
+    int stack[MAX_STACK];
+    int top = 0;
+    stack[top++] = root_;
+    while (top > 0) {
+        const Node& node = nodes_[stack[--top]];
+        if (!aabb_overlaps(node.box, box)) continue;
+        if (node.is_leaf()) {
+            if (!callback(node.user_data)) return;
+        } else {
+            stack[top++] = node.child1;
+            stack[top++] = node.child2;
+        }
+    }
+}
+
+template <typename Callback>
+void AabbTree::ray_cast(Vector2 from, Vector2 to, Callback&& callback) const {
+    if (root_ < 0) return;
+    Vector2 delta = { to.x - from.x, to.y - from.y };
+    float max_fraction = 1.0f;
+
+    int stack[MAX_STACK];
+    int top = 0;
+    stack[top++] = root_;
+    while (top > 0) {
+        const Node& node = nodes_[stack[--top]];
+
+        float enter;
+        if (!aabb_ray_enter(node.box, from, delta, max_fraction, &enter)) continue;
+
+        if (node.is_leaf()) {
+            max_fraction = callback(node.user_data, max_fraction);
+            if (max_fraction <= 0.0f) return;
+        } else {
+            stack[top++] = node.child1;
+            stack[top++] = node.child2;
+        }
+    }
+}
+
+} // namespace atoms
+} // namespace player
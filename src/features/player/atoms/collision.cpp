@@ -2,10 +2,18 @@
 #include "collision.hpp"
 #include <algorithm>
 #include <cmath>
+#include <utility>
 
 namespace player {
 namespace atoms {
 
+namespace {
+    // Spatial hash key for a cell
+    std::uint64_t pack_cell(int x, int y) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+    }
+}
+
 // Factory functions for collision shapes
 CollisionShape CollisionShape::Rectangle(float width, float height, Vector2 offset) {
     CollisionShape shape;
@@ -25,28 +33,95 @@ CollisionShape CollisionShape::Circle(float radius, Vector2 offset) {
 }
 
 // CollisionWorld implementation
-CollisionWorld::CollisionWorld(float cell_size, int max_objects_per_cell)
-    : cell_size_(cell_size), max_objects_per_cell_(max_objects_per_cell) {
-    // Initialize spatial grid with a default size
-    // It will grow as needed based on world bounds
-    grid_width_ = 20;
-    grid_height_ = 20;
-    grid_.resize(grid_width_ * grid_height_);
+CollisionWorld::CollisionWorld(float cell_size, int max_objects_per_cell, CollisionBroadphase broadphase)
+    : cell_size_(cell_size), max_objects_per_cell_(max_objects_per_cell), broadphase_(broadphase) {
+    // Cells are created as objects enter them
+    table_.assign(MIN_TABLE_SIZE, -1);
+}
+
+int CollisionWorld::get_cell_coord(float v) const {
+    // Floor so cells left of / above the origin don't share cell 0
+    return static_cast<int>(std::floor(v / cell_size_));
+}
+
+int CollisionWorld::home_slot(std::uint64_t key) const {
+    // Fibonacci hashing: high bits of the product are well mixed
+    std::uint64_t hash = key * 0x9E3779B97F4A7C15ull;
+    return static_cast<int>((hash >> 32) & (table_.size() - 1));
+}
+
+int CollisionWorld::find_table_slot(std::uint64_t key) const {
+    const int mask = static_cast<int>(table_.size()) - 1;
+    for (int slot = home_slot(key); ; slot = (slot + 1) & mask) {
+        int index = table_[slot];
+        if (index < 0) return -1;
+        if (cells_[index].key == key) return slot;
+    }
+}
+
+int CollisionWorld::find_cell(int x, int y) const {
+    int slot = find_table_slot(pack_cell(x, y));
+    return slot < 0 ? -1 : table_[slot];
 }
 
-int CollisionWorld::get_cell_index(float x, float y) const {
-    int cell_x = static_cast<int>(x / cell_size_);
-    int cell_y = static_cast<int>(y / cell_size_);
+int CollisionWorld::find_or_add_cell(int x, int y) {
+    int index = find_cell(x, y);
+    if (index >= 0) return index;
     
-    // Clamp to grid bounds
-    cell_x = std::max(0, std::min(cell_x, grid_width_ - 1));
-    cell_y = std::max(0, std::min(cell_y, grid_height_ - 1));
+    if ((cells_.size() + 1) * 2 > table_.size()) {
+        rehash(table_.size() * 2);
+    }
+    std::uint64_t key = pack_cell(x, y);
+    const int mask = static_cast<int>(table_.size()) - 1;
+    int slot = home_slot(key);
+    while (table_[slot] >= 0) slot = (slot + 1) & mask;
+    
+    index = static_cast<int>(cells_.size());
+    table_[slot] = index;
+    cells_.push_back(SpatialCell{key, x, y, {}});
+    return index;
+}
+
+void CollisionWorld::erase_cell(int index) {
+    const int mask = static_cast<int>(table_.size()) - 1;
+    
+    // Backward-shift deletion: pull later entries of the probe run into the
+    // hole when their home slot allows it, so lookups never need tombstones
+    int hole = find_table_slot(cells_[index].key);
+    table_[hole] = -1;
+    for (int next = (hole + 1) & mask; table_[next] >= 0; next = (next + 1) & mask) {
+        int home = home_slot(cells_[table_[next]].key);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            table_[hole] = table_[next];
+            table_[next] = -1;
+            hole = next;
+        }
+    }
+    
+    // Swap the last cell into the freed index and repoint its table entry
+    int last = static_cast<int>(cells_.size()) - 1;
+    if (index != last) {
+        table_[find_table_slot(cells_[last].key)] = index;
+        cells_[index] = std::move(cells_[last]);
+    }
+    cells_.pop_back();
     
-    return cell_y * grid_width_ + cell_x;
+    if (table_.size() > MIN_TABLE_SIZE && cells_.size() * 8 < table_.size()) {
+        rehash(table_.size() / 2);
+    }
+}
+
+void CollisionWorld::rehash(std::size_t table_size) {
+    table_.assign(table_size, -1);
+    const int mask = static_cast<int>(table_size) - 1;
+    for (int index = 0; index < static_cast<int>(cells_.size()); index++) {
+        int slot = home_slot(cells_[index].key);
+        while (table_[slot] >= 0) slot = (slot + 1) & mask;
+        table_[slot] = index;
+    }
 }
 
-std::vector<int> CollisionWorld::get_neighboring_cells(const CollisionObject& object) const {
-    std::vector<int> cells;
+Aabb CollisionWorld::get_bounds(const CollisionObject& object) const {
     Vector2 pos = object.position;
     float radius = 0.0f;
     
@@ -65,96 +140,164 @@ std::vector<int> CollisionWorld::get_neighboring_cells(const CollisionObject& ob
         max_y = pos.y + object.shape.offset.y + radius;
     }
     
-    // Get cell indices for min and max bounds
-    int min_cell_x = static_cast<int>(min_x / cell_size_);
-    int min_cell_y = static_cast<int>(min_y / cell_size_);
-    int max_cell_x = static_cast<int>(max_x / cell_size_);
-    int max_cell_y = static_cast<int>(max_y / cell_size_);
-    
-    // Clamp to grid bounds
-    min_cell_x = std::max(0, std::min(min_cell_x, grid_width_ - 1));
-    min_cell_y = std::max(0, std::min(min_cell_y, grid_height_ - 1));
-    max_cell_x = std::max(0, std::min(max_cell_x, grid_width_ - 1));
-    max_cell_y = std::max(0, std::min(max_cell_y, grid_height_ - 1));
+    return { {min_x, min_y}, {max_x, max_y} };
+}
+
+CollisionWorld::CellRange CollisionWorld::get_cell_range(const Aabb& bounds) const {
+    // Get cell coordinates for min and max bounds
+    CellRange range;
+    range.min_x = get_cell_coord(bounds.min.x);
+    range.min_y = get_cell_coord(bounds.min.y);
+    range.max_x = get_cell_coord(bounds.max.x);
+    range.max_y = get_cell_coord(bounds.max.y);
+    
+    return range;
+}
+
+template <typename Callback>
+void CollisionWorld::for_each_candidate(const Aabb& bounds, Callback&& callback) {
+    if (broadphase_ == CollisionBroadphase::TREE) {
+        // Leaves are unique, no dedupe needed
+        tree_.query(bounds, callback);
+        return;
+    }
     
-    // Add all cells in the range
-    for (int y = min_cell_y; y <= max_cell_y; y++) {
-        for (int x = min_cell_x; x <= max_cell_x; x++) {
-            cells.push_back(y * grid_width_ + x);
+    next_query_stamp();
+    CellRange range = get_cell_range(bounds);
+    for (int y = range.min_y; y <= range.max_y; y++) {
+        for (int x = range.min_x; x <= range.max_x; x++) {
+            int cell_idx = find_cell(x, y);
+            if (cell_idx < 0) continue;
+            
+            for (int other_id : cells_[cell_idx].object_ids) {
+                // Skip if already seen (objects can span several cells)
+                Slot& other_slot = slots_[other_id & HANDLE_INDEX_MASK];
+                if (other_slot.query_stamp == query_stamp_) continue;
+                other_slot.query_stamp = query_stamp_;
+                
+                if (!callback(other_id)) return;
+            }
         }
     }
-    
-    return cells;
 }
 
-void CollisionWorld::update_object_in_grid(int id) {
-    // First remove from all cells
-    for (auto& cell : grid_) {
-        cell.object_ids.erase(
-            std::remove(cell.object_ids.begin(), cell.object_ids.end(), id),
-            cell.object_ids.end()
-        );
-    }
-    
-    // Find the object
-    const CollisionObject* obj = nullptr;
-    for (const auto& object : objects_) {
-        if (object.id == id) {
-            obj = &object;
-            break;
-        }
+void CollisionWorld::next_query_stamp() {
+    if (++query_stamp_ == 0) {
+        for (Slot& slot : slots_) slot.query_stamp = 0;
+        query_stamp_ = 1;
     }
-    
+}
+
+void CollisionWorld::update_object_in_grid(int id) {
+    const CollisionObject* obj = find_object(id);
     if (!obj) return; // Object not found
     
-    // Add to new cells
-    auto cells = get_neighboring_cells(*obj);
-    for (int cell_idx : cells) {
-        if (cell_idx >= 0 && cell_idx < grid_.size()) {
-            grid_[cell_idx].object_ids.push_back(id);
+    Slot& slot = slots_[id & HANDLE_INDEX_MASK];
+    CellRange old_range = slot.cells;
+    CellRange new_range = get_cell_range(get_bounds(*obj));
+    if (new_range == old_range) return; // Still in the same cells
+    
+    // Leave the cells no longer overlapped, enter the newly overlapped ones
+    remove_from_cells(id, old_range, new_range);
+    for (int y = new_range.min_y; y <= new_range.max_y; y++) {
+        for (int x = new_range.min_x; x <= new_range.max_x; x++) {
+            if (!old_range.contains(x, y)) {
+                cells_[find_or_add_cell(x, y)].object_ids.push_back(id);
+            }
+        }
+    }
+    slot.cells = new_range;
+    cell_moves_++;
+}
+
+void CollisionWorld::remove_from_cells(int id, const CellRange& range, const CellRange& keep) {
+    for (int y = range.min_y; y <= range.max_y; y++) {
+        for (int x = range.min_x; x <= range.max_x; x++) {
+            if (keep.contains(x, y)) continue;
+            int index = find_cell(x, y);
+            if (index < 0) continue;
+            std::vector<int>& ids = cells_[index].object_ids;
+            auto it = std::find(ids.begin(), ids.end(), id);
+            if (it != ids.end()) {
+                // Order within a cell doesn't matter
+                *it = ids.back();
+                ids.pop_back();
+            }
+            if (ids.empty()) erase_cell(index);
         }
     }
 }
 
 // Update object position implementation
 void CollisionWorld::update_object_position(int id, Vector2 position) {
-    for (auto& object : objects_) {
-        if (object.id == id) {
-            object.position = position;
-            update_object_in_grid(id);
-            return;
-        }
+    CollisionObject* object = find_object(id);
+    if (!object) return;
+    
+    Vector2 displacement = { position.x - object->position.x, position.y - object->position.y };
+    object->position = position;
+    if (broadphase_ == CollisionBroadphase::TREE) {
+        tree_.move_proxy(slots_[id & HANDLE_INDEX_MASK].proxy, get_bounds(*object), displacement);
+    } else {
+        update_object_in_grid(id);
     }
 }
 
 // Add object implementation
 int CollisionWorld::add_object(const CollisionObject& object) {
+    // Reuse a freed slot if there is one
+    int slot;
+    if (!free_slots_.empty()) {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        slot = static_cast<int>(slots_.size());
+        if (slot > HANDLE_INDEX_MASK) {
+            TraceLog(LOG_WARNING, "CollisionWorld: out of handles (%d objects)", slot);
+            return -1;
+        }
+        slots_.push_back(Slot{});
+    }
+    
     CollisionObject new_object = object;
-    new_object.id = next_id_++;
+    new_object.id = static_cast<int>(slots_[slot].generation << HANDLE_INDEX_BITS) | slot;
+    slots_[slot].dense = static_cast<int>(objects_.size());
     objects_.push_back(new_object);
     
-    // Add to spatial grid
-    update_object_in_grid(new_object.id);
+    // Add to the broadphase
+    if (broadphase_ == CollisionBroadphase::TREE) {
+        slots_[slot].proxy = tree_.create_proxy(get_bounds(new_object), new_object.id);
+    } else {
+        update_object_in_grid(new_object.id);
+    }
     
     return new_object.id;
 }
 
 // Remove object implementation
 void CollisionWorld::remove_object(int id) {
-    // Remove from grid first
-    for (auto& cell : grid_) {
-        cell.object_ids.erase(
-            std::remove(cell.object_ids.begin(), cell.object_ids.end(), id),
-            cell.object_ids.end()
-        );
+    if (!find_object(id)) return;
+    
+    // Remove from the broadphase first
+    Slot& slot = slots_[id & HANDLE_INDEX_MASK];
+    if (slot.proxy >= 0) {
+        tree_.destroy_proxy(slot.proxy);
+        slot.proxy = -1;
+    }
+    remove_from_cells(id, slot.cells, CellRange{});
+    slot.cells = CellRange{};
+    
+    // Swap the last object into the hole and repoint its slot
+    int dense = slot.dense;
+    if (dense != static_cast<int>(objects_.size()) - 1) {
+        objects_[dense] = objects_.back();
+        slots_[objects_[dense].id & HANDLE_INDEX_MASK].dense = dense;
     }
+    objects_.pop_back();
     
-    // Then remove from objects list
-    objects_.erase(
-        std::remove_if(objects_.begin(), objects_.end(),
-            [id](const CollisionObject& obj) { return obj.id == id; }),
-        objects_.end()
-    );
+    // Retire the handle
+    slot.dense = -1;
+    slot.generation = (slot.generation + 1) & HANDLE_GENERATION_MASK;
+    free_slots_.push_back(id & HANDLE_INDEX_MASK);
 }
 
 // Get all objects in the world
@@ -164,46 +307,61 @@ const std::vector<CollisionObject>& CollisionWorld::get_objects() const {
 
 // Get object by ID
 const CollisionObject* CollisionWorld::get_object(int id) const {
-    for (const auto& obj : objects_) {
-        if (obj.id == id) {
-            return &obj;
-        }
-    }
-    return nullptr;
+    return find_object(id);
+}
+
+CollisionObject* CollisionWorld::find_object(int id) {
+    return const_cast<CollisionObject*>(static_cast<const CollisionWorld*>(this)->find_object(id));
+}
+
+const CollisionObject* CollisionWorld::find_object(int id) const {
+    if (id < 0) return nullptr;
+    
+    // The stored handle carries the generation: a stale handle never matches it
+    int slot = id & HANDLE_INDEX_MASK;
+    if (slot >= static_cast<int>(slots_.size()) || slots_[slot].dense < 0) return nullptr;
+    const CollisionObject& object = objects_[slots_[slot].dense];
+    return object.id == id ? &object : nullptr;
 }
 
 // Draw debug visualization of the spatial grid
 void CollisionWorld::draw_debug_grid() const {
-    // Draw grid cells
-    for (int y = 0; y < grid_height_; y++) {
-        for (int x = 0; x < grid_width_; x++) {
-            int cell_idx = y * grid_width_ + x;
-            
-            // Calculate cell rectangle
-            Rectangle cell_rect = {
-                x * cell_size_,
-                y * cell_size_,
-                cell_size_,
-                cell_size_
-            };
-            
-            // Color based on object count
-            int object_count = grid_[cell_idx].object_ids.size();
-            Color cell_color = GRAY;
-            cell_color.a = (object_count > 0) ? 50 + std::min(object_count * 20, 205) : 20;
-            
-            DrawRectangleLinesEx(cell_rect, 1.0f, cell_color);
-            
-            // Draw object count in cell if non-zero
-            if (object_count > 0) {
-                char count_text[8];
-                sprintf(count_text, "%d", object_count);
-                DrawText(count_text, 
-                         static_cast<int>(cell_rect.x + cell_rect.width/2 - 5), 
-                         static_cast<int>(cell_rect.y + cell_rect.height/2 - 10),
-                         20, WHITE);
-            }
+    if (broadphase_ == CollisionBroadphase::TREE) {
+        // Draw each object's fattened leaf box
+        for (const CollisionObject& object : objects_) {
+            const Aabb& box = tree_.get_fat_aabb(slots_[object.id & HANDLE_INDEX_MASK].proxy);
+            Rectangle leaf_rect = { box.min.x, box.min.y, box.max.x - box.min.x, box.max.y - box.min.y };
+            Color leaf_color = GRAY;
+            leaf_color.a = 120;
+            DrawRectangleLinesEx(leaf_rect, 1.0f, leaf_color);
         }
+        return;
+    }
+    
+    // Draw occupied cells (empty cells don't exist)
+    for (const SpatialCell& cell : cells_) {
+        // Calculate cell rectangle
+        Rectangle cell_rect = {
+            cell.x * cell_size_,
+            cell.y * cell_size_,
+            cell_size_,
+            cell_size_
+        };
+        
+        // Color based on object count
+        int object_count = cell.object_ids.size();
+        Color cell_color = GRAY;
+        cell_color.a = 50 + std::min(object_count * 20, 205);
+        
+        DrawRectangleLinesEx(cell_rect, 1.0f, cell_color);
+        
+        // Draw object count in cell
+        char count_text[8];
+        sprintf(count_text, "%d", object_count);
+        DrawText(count_text, 
+                 static_cast<int>(cell_rect.x + cell_rect.width/2 - 5), 
+                 static_cast<int>(cell_rect.y + cell_rect.height/2 - 10),
+                 20, WHITE);
     }
 }
 
@@ -212,14 +370,7 @@ CollisionResult CollisionWorld::test_collision(int object_id, Vector2 new_positi
     CollisionResult result = { false, {0, 0}, -1 };
     
     // Find the object to test
-    CollisionObject* test_object = nullptr;
-    for (auto& obj : objects_) {
-        if (obj.id == object_id) {
-            test_object = &obj;
-            break;
-        }
-    }
-    
+    const CollisionObject* test_object = find_object(object_id);
     if (!test_object) {
         return result; // Object not found
     }
@@ -228,53 +379,137 @@ CollisionResult CollisionWorld::test_collision(int object_id, Vector2 new_positi
     CollisionObject test_copy = *test_object;
     test_copy.position = new_position;
     
-    // Get potential collision cells
-    std::vector<int> cells = get_neighboring_cells(test_copy);
+    // Test against objects the broadphase finds around the new bounds
+    for_each_candidate(get_bounds(test_copy), [&](int other_id) {
+        // Skip self
+        if (other_id == object_id) return true;
+        
+        // Find the other object
+        const CollisionObject* other = find_object(other_id);
+        if (!other || !other->is_solid) return true;
+        
+        // Check for collision
+        Vector2 penetration = {0, 0};
+        if (check_collision(test_copy, *other, &penetration)) {
+            result.collided = true;
+            result.penetration = penetration;
+            result.object_id = other_id;
+            return false; // Stop on first collision
+        }
+        return true;
+    });
     
-    // Store IDs we've already checked to avoid duplicates
-    std::vector<int> checked_ids;
+    return result;
+}
+
+int CollisionWorld::query_region(Rectangle region, int* out_ids, int max_ids) {
+    if (max_ids <= 0) return 0;
+    
+    // The region as a rectangle object, so the narrow phase can test it
+    CollisionObject region_object;
+    region_object.position = { region.x + region.width / 2, region.y + region.height / 2 };
+    region_object.shape = CollisionShape::Rectangle(region.width, region.height);
+    region_object.is_solid = false;
+    region_object.id = -1;
+    
+    int count = 0;
+    for_each_candidate(get_bounds(region_object), [&](int other_id) {
+        const CollisionObject* other = find_object(other_id);
+        if (other && check_collision(region_object, *other)) {
+            out_ids[count++] = other_id;
+        }
+        return count < max_ids;
+    });
+    return count;
+}
+
+RayCastResult CollisionWorld::ray_cast(Vector2 from, Vector2 to) {
+    RayCastResult result = { false, 1.0f, to, -1 };
+    const Vector2 delta = { to.x - from.x, to.y - from.y };
+    
+    // Clip the ray to a candidate's shape; returns the (possibly shorter) ray length
+    auto test_candidate = [&](int other_id, float max_fraction) {
+        const CollisionObject* other = find_object(other_id);
+        float fraction;
+        if (other && other->is_solid && ray_hits_object(*other, from, delta, max_fraction, &fraction)) {
+            result.hit = true;
+            result.fraction = fraction;
+            result.object_id = other_id;
+            return fraction;
+        }
+        return max_fraction;
+    };
     
-    // Test against objects in neighboring cells
-    for (int cell_idx : cells) {
-        if (cell_idx < 0 || cell_idx >= grid_.size()) continue;
+    if (broadphase_ == CollisionBroadphase::TREE) {
+        tree_.ray_cast(from, to, test_candidate);
+    } else {
+        // Walk the cells the segment crosses in order (Amanatides-Woo)
+        next_query_stamp();
+        int cell_x = get_cell_coord(from.x);
+        int cell_y = get_cell_coord(from.y);
+        const int step_x = delta.x > 0 ? 1 : -1;
+        const int step_y = delta.y > 0 ? 1 : -1;
+        const float infinity = 1e30f;
+        float next_x = delta.x != 0 ? ((cell_x + (step_x > 0)) * cell_size_ - from.x) / delta.x : infinity;
+        float next_y = delta.y != 0 ? ((cell_y + (step_y > 0)) * cell_size_ - from.y) / delta.y : infinity;
+        const float span_x = delta.x != 0 ? cell_size_ / std::fabs(delta.x) : infinity;
+        const float span_y = delta.y != 0 ? cell_size_ / std::fabs(delta.y) : infinity;
         
-        for (int other_id : grid_[cell_idx].object_ids) {
-            // Skip self
-            if (other_id == object_id) continue;
-            
-            // Skip if already checked
-            if (std::find(checked_ids.begin(), checked_ids.end(), other_id) != checked_ids.end()) {
-                continue;
-            }
-            
-            // Find the other object
-            const CollisionObject* other = nullptr;
-            for (const auto& obj : objects_) {
-                if (obj.id == other_id) {
-                    other = &obj;
-                    break;
+        while (true) {
+            int cell_idx = find_cell(cell_x, cell_y);
+            if (cell_idx >= 0) {
+                for (int other_id : cells_[cell_idx].object_ids) {
+                    Slot& other_slot = slots_[other_id & HANDLE_INDEX_MASK];
+                    if (other_slot.query_stamp == query_stamp_) continue;
+                    other_slot.query_stamp = query_stamp_;
+                    test_candidate(other_id, result.fraction);
                 }
             }
             
-            if (!other || !other->is_solid) continue;
-            
-            // Mark as checked
-            checked_ids.push_back(other_id);
-            
-            // Check for collision
-            Vector2 penetration = {0, 0};
-            if (check_collision(test_copy, *other, &penetration)) {
-                result.collided = true;
-                result.penetration = penetration;
-                result.object_id = other_id;
-                return result; // Return on first collision
+            // Every hit up to where the ray leaves this cell has been seen
+            float cell_exit = std::min(next_x, next_y);
+            if (cell_exit >= result.fraction) break;
+            if (next_x < next_y) {
+                cell_x += step_x;
+                next_x += span_x;
+            } else {
+                cell_y += step_y;
+                next_y += span_y;
             }
         }
     }
     
+    if (result.hit) {
+        result.point = { from.x + delta.x * result.fraction, from.y + delta.y * result.fraction };
+    }
     return result;
 }
 
+bool CollisionWorld::ray_hits_object(const CollisionObject& object, Vector2 from, Vector2 delta,
+                                     float max_fraction, float* fraction) const {
+    if (object.shape.type == CollisionShapeType::RECTANGLE) {
+        return aabb_ray_enter(get_bounds(object), from, delta, max_fraction, fraction);
+    }
+    
+    // Circle: smallest t with |from + t * delta - centre| = radius
+    float radius = object.shape.circle.radius;
+    float mx = from.x - (object.position.x + object.shape.offset.x);
+    float my = from.y - (object.position.y + object.shape.offset.y);
+    float c = mx * mx + my * my - radius * radius;
+    if (c <= 0.0f) {
+        *fraction = 0.0f;   // Starts inside
+        return true;
+    }
+    float a = delta.x * delta.x + delta.y * delta.y;
+    float b = mx * delta.x + my * delta.y;
+    float discriminant = b * b - a * c;
+    if (a == 0.0f || discriminant < 0.0f) return false;
+    float t = (-b - std::sqrt(discriminant)) / a;
+    if (t < 0.0f || t > max_fraction) return false;
+    *fraction = t;
+    return true;
+}
+
 bool CollisionWorld::check_collision(const CollisionObject& a, const CollisionObject& b, Vector2* penetration) {
     // Dispatch to appropriate collision check function based on shape types
     if (a.shape.type == CollisionShapeType::RECTANGLE && b.shape.type == CollisionShapeType::RECTANGLE) {
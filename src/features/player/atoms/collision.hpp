@@ -1,7 +1,9 @@
 /// collision.hpp — collision detection atom for player slice
 #pragma once
 #include <raylib.h>
+#include <cstdint>
 #include <vector>
+#include "aabb_tree.hpp"
 
 namespace player {
 namespace atoms {
@@ -39,7 +41,7 @@ struct CollisionObject {
     Vector2 position;
     CollisionShape shape;
     bool is_solid;
-    int id;  // Optional identifier
+    int id;  // Handle assigned by CollisionWorld::add_object
 };
 
 // Collision result stores information about a collision
@@ -49,57 +51,169 @@ struct CollisionResult {
     int object_id;        // ID of the object collided with
 };
 
-// Create a collision world to manage and test collision objects
+// Ray cast result: the nearest solid object along a segment
+struct RayCastResult {
+    bool hit;
+    float fraction;       // 0 at the start of the segment, 1 at the end
+    Vector2 point;
+    int object_id;
+};
+
+// Broadphase used to find candidate objects
+enum class CollisionBroadphase {
+    GRID,   // Sparse spatial hash; best for many objects of similar size
+    TREE    // Dynamic AABB tree; best when object sizes vary widely
+};
+
+// Create a collision world to manage and test collision objects.
+// Objects are addressed by generational handles: a slot index plus the
+// slot's generation, so a handle to a removed object never matches the
+// object that reuses its slot. Objects live densely in one array (removal
+// swaps the last object into the hole), and each slot points at its object.
+// The default broadphase is a sparse spatial hash over square cells: only
+// cells that hold objects exist, so the world is unbounded (negative
+// coordinates too). The tree broadphase answers the same queries.
 class CollisionWorld {
 public:
-    // Constructor with optional grid settings
-    CollisionWorld(float cell_size = 128.0f, int max_objects_per_cell = 10);
+    // Constructor with optional grid settings (cell size is unused by the tree)
+    CollisionWorld(float cell_size = 128.0f, int max_objects_per_cell = 10,
+                   CollisionBroadphase broadphase = CollisionBroadphase::GRID);
     
-    // Add an object to the collision world
+    // Add an object to the collision world, returns its handle
+    // PERF: O(1) slot allocation (plus grid insertion)
     int add_object(const CollisionObject& object);
     
     // Update an object's position
     void update_object_position(int id, Vector2 position);
     
-    // Remove an object from the world
+    // Remove an object from the world; its handle (and any copy of it) goes stale
+    // PERF: O(1) swap-and-pop (plus grid removal)
     void remove_object(int id);
     
     // Test if an object would collide at a new position
+    // PERF: no heap allocation; each candidate is tested once per query
     CollisionResult test_collision(int object_id, Vector2 new_position);
     
-    // Get all objects in the world
+    // Collect objects (solid or not) overlapping a rectangle into out_ids,
+    // at most max_ids; returns how many were written
+    // PERF: no heap allocation
+    int query_region(Rectangle region, int* out_ids, int max_ids);
+    
+    // Nearest solid object crossed by the segment from -> to
+    // PERF: no heap allocation; the grid walks cells in ray order and stops at the first hit
+    RayCastResult ray_cast(Vector2 from, Vector2 to);
+    
+    CollisionBroadphase get_broadphase() const { return broadphase_; }
+    
+    // Get all objects in the world (dense; order changes when objects are removed)
     const std::vector<CollisionObject>& get_objects() const;
     
-    // Get collision object by ID
+    // Get collision object by handle, nullptr if stale or unknown
+    // PERF: O(1) slot lookup
     const CollisionObject* get_object(int id) const;
     
+    // Number of times an object's grid cell range changed (for tests and profiling)
+    int get_cell_move_count() const { return cell_moves_; }
+    
+    // Number of occupied grid cells
+    int get_cell_count() const { return static_cast<int>(cells_.size()); }
+    
     // Debug visualization
     void draw_debug_grid() const;
     
 private:
     struct SpatialCell {
+        std::uint64_t key;             // Packed cell coordinates
+        int x;
+        int y;
         std::vector<int> object_ids;
     };
     
-    std::vector<CollisionObject> objects_;
-    int next_id_ = 0;
+    // Handle layout: generation above the slot index bits
+    static constexpr int HANDLE_INDEX_BITS = 20;
+    static constexpr int HANDLE_INDEX_MASK = (1 << HANDLE_INDEX_BITS) - 1;
+    static constexpr std::uint32_t HANDLE_GENERATION_MASK = (1u << (31 - HANDLE_INDEX_BITS)) - 1;
+    
+    // Inclusive range of grid cells; empty when min_x > max_x
+    struct CellRange {
+        int min_x = 0;
+        int min_y = 0;
+        int max_x = -1;
+        int max_y = -1;
+        
+        bool contains(int x, int y) const { return x >= min_x && x <= max_x && y >= min_y && y <= max_y; }
+        bool operator==(const CellRange& other) const {
+            return min_x == other.min_x && min_y == other.min_y && max_x == other.max_x && max_y == other.max_y;
+        }
+    };
+    
+    struct Slot {
+        int dense = -1;                // Index into objects_, -1 when free
+        std::uint32_t generation = 0;  // Bumped on every removal
+        CellRange cells;               // Grid cells the object is listed in
+        std::uint32_t query_stamp = 0; // Last query that tested the object
+        int proxy = -1;                // Tree leaf (tree broadphase)
+    };
+    
+    std::vector<CollisionObject> objects_;   // Dense storage
+    std::vector<Slot> slots_;
+    std::vector<int> free_slots_;
     
-    // Spatial partitioning grid
-    std::vector<SpatialCell> grid_;
+    // Spatial hash: occupied cells stored densely, found through an
+    // open-addressing table (linear probing, power-of-two size, at most half full)
+    static constexpr int MIN_TABLE_SIZE = 64;
+    std::vector<SpatialCell> cells_;
+    std::vector<int> table_;                 // Index into cells_, -1 when empty
     float cell_size_;
-    int grid_width_ = 0;
-    int grid_height_ = 0;
     int max_objects_per_cell_;
     
-    // Get cell index from world position
-    int get_cell_index(float x, float y) const;
+    CollisionBroadphase broadphase_;
+    AabbTree tree_;
+    int cell_moves_ = 0;
+    std::uint32_t query_stamp_ = 0;          // Current query, dedupes objects listed in several cells
+    
+    // Object for a handle, nullptr if stale or unknown
+    CollisionObject* find_object(int id);
+    const CollisionObject* find_object(int id) const;
+    
+    // Cell coordinate of a world coordinate
+    int get_cell_coord(float v) const;
+    
+    // Bounding box of an object's shape
+    Aabb get_bounds(const CollisionObject& object) const;
     
-    // Get neighboring cells for an object
-    std::vector<int> get_neighboring_cells(const CollisionObject& object) const;
+    // Grid cells overlapped by a box
+    CellRange get_cell_range(const Aabb& bounds) const;
     
-    // Update object's position in the spatial grid
+    // Call callback(id) once for each object the broadphase finds near the
+    // box; the callback returns false to stop
+    template <typename Callback>
+    void for_each_candidate(const Aabb& bounds, Callback&& callback);
+    
+    // Fraction along from + t * delta where the segment enters the object's
+    // shape, if it does before max_fraction
+    bool ray_hits_object(const CollisionObject& object, Vector2 from, Vector2 delta,
+                         float max_fraction, float* fraction) const;
+    
+    // New query stamp; clears the old stamps on wrap-around
+    void next_query_stamp();
+    
+    // Spatial hash operations
+    // PERF: O(1) expected; the table doubles or halves to stay between 1/8 and 1/2 full
+    int find_cell(int x, int y) const;       // Index into cells_, -1 if unoccupied
+    int find_or_add_cell(int x, int y);
+    void erase_cell(int index);
+    int find_table_slot(std::uint64_t key) const;
+    int home_slot(std::uint64_t key) const;
+    void rehash(std::size_t table_size);
+    
+    // Update object's cells in the spatial grid; only cells entered or left are touched
+    // PERF: no grid work while the object stays within its cell range
     void update_object_in_grid(int id);
     
+    // Drop the id from a range of cells
+    void remove_from_cells(int id, const CellRange& range, const CellRange& keep);
+    
     // Collision detection helpers
     bool check_collision(const CollisionObject& a, const CollisionObject& b, Vector2* penetration = nullptr);
     bool check_rect_rect(const CollisionObject& a, const CollisionObject& b, Vector2* penetration);
@@ -3,6 +3,7 @@
 #include "../atoms/debug_draw.hpp"
 #include "core/public/world.hpp"
 #include "core/public/ui.hpp"
+#include "core/public/render_queue.hpp"
 
 namespace player {
 namespace molecules {
@@ -66,8 +67,10 @@ void PlayerController::update(float dt) {
     
     // Only process movement if not attacking
     if (!actions_.attacking) {
-        // Process input (this updates movement_.position based on input)
-        atoms::process_movement(movement_, dt);
+        // Process input (this updates movement_.position based on input),
+        // slowed by the terrain underfoot
+        float terrain_dt = dt * core::world::get_speed_factor(previous_position.x, previous_position.y);
+        atoms::process_movement(movement_, terrain_dt);
         
         // Handle X and Y movement separately to allow sliding along walls
         Vector2 test_position_x = { movement_.position.x, previous_position.y };
@@ -153,11 +156,16 @@ void PlayerController::render() {
     // Draw player sprite centered on position with appropriate color
     Color player_color = is_alive() ? WHITE : GRAY; // Use is_alive() for color
     
-    DrawTextureV(texture, 
-                Vector2{screen_pos.x - texture.width / 2.0f, 
-                        screen_pos.y - texture.height / 2.0f}, 
-                player_color);
-    
+    // Sorted against world objects and enemies by the bottom of the sprite
+    core::render::submit(core::render::Layer::ENTITIES,
+                         movement_.position.y + texture.height / 2.0f,
+                         texture,
+                         Vector2{screen_pos.x - texture.width / 2.0f, 
+                                 screen_pos.y - texture.height / 2.0f}, 
+                         player_color);
+}
+
+void PlayerController::render_debug() {
     // Draw collision shapes if enabled
     if (show_collision_shapes_) {
         // Draw our collision objects transformed to screen space
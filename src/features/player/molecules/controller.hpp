@@ -17,9 +17,12 @@ public:
     // Update player state based on input and time
     void update(float dt);
     
-    // Render the player
+    // Submit the player sprite to the render queue
     void render();
     
+    // Draw collision shapes and debug state (if enabled)
+    void render_debug();
+    
     // Clean up resources
     void cleanup();
     
@@ -28,6 +28,12 @@ void render() {
     }
 }
 
+void render_debug() {
+    if (controller) {
+        controller->render_debug();
+    }
+}
+
 void cleanup() {
     if (controller) {
         controller->cleanup();
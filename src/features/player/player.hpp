@@ -16,9 +16,12 @@ void init(float start_x, float start_y);
 // Update the player (movement, animation, etc)
 void update(float dt);
 
-// Render the player
+// Render the player (sprite goes into the core::render queue)
 void render();
 
+// Render collision/debug overlays, after the render queue is flushed
+void render_debug();
+
 // Cleanup player resources
 void cleanup();
 
@@ -0,0 +1,119 @@
+/// test_aabb_tree.cpp — Unit tests for the dynamic bounding volume tree atom
+
+#include <catch2/catch_all.hpp>
+#include "../atoms/aabb_tree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace player::atoms;
+
+namespace {
+    Aabb make_box(float x, float y, float width, float height) {
+        return { {x, y}, {x + width, y + height} };
+    }
+
+    std::vector<int> query_ids(const AabbTree& tree, const Aabb& box) {
+        std::vector<int> ids;
+        tree.query(box, [&ids](int id) {
+            ids.push_back(id);
+            return true;
+        });
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+}
+
+TEST_CASE("AABB tree", "[player][atom][aabb_tree]") {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> coord(-2000.0f, 2000.0f);
+    std::uniform_real_distribution<float> size(4.0f, 64.0f);
+
+    // Mixed sizes: mostly small boxes, a few long walls
+    AabbTree tree;
+    std::vector<Aabb> boxes;
+    std::vector<int> proxies;
+    for (int i = 0; i < 400; i++) {
+        Aabb box = i % 40 == 0 ? make_box(coord(rng), coord(rng), 50, 400) : make_box(coord(rng), coord(rng), size(rng), size(rng));
+        boxes.push_back(box);
+        proxies.push_back(tree.create_proxy(box, i));
+    }
+    REQUIRE(tree.validate());
+    REQUIRE(tree.get_proxy_count() == 400);
+    REQUIRE(tree.get_height() <= 20);
+
+    // Expected hits: every box whose fat box overlaps
+    auto brute_force = [&](const Aabb& query) {
+        std::vector<int> ids;
+        for (int i = 0; i < static_cast<int>(boxes.size()); i++) {
+            if (proxies[i] >= 0 && aabb_overlaps(tree.get_fat_aabb(proxies[i]), query)) ids.push_back(i);
+        }
+        return ids;
+    };
+
+    SECTION("Queries match a brute-force scan") {
+        for (int i = 0; i < 50; i++) {
+            Aabb query = make_box(coord(rng), coord(rng), 300, 200);
+            REQUIRE(query_ids(tree, query) == brute_force(query));
+        }
+    }
+
+    SECTION("Small moves stay inside the fat box") {
+        Aabb moved = boxes[1];
+        moved.min.x += 2;
+        moved.max.x += 2;
+        REQUIRE_FALSE(tree.move_proxy(proxies[1], moved, {2, 0}));
+        moved.min.x += 100;
+        moved.max.x += 100;
+        REQUIRE(tree.move_proxy(proxies[1], moved, {100, 0}));
+        REQUIRE(aabb_contains(tree.get_fat_aabb(proxies[1]), moved));
+        REQUIRE(tree.validate());
+    }
+
+    SECTION("Moves and removals keep the tree valid") {
+        for (int round = 0; round < 20; round++) {
+            for (int i = 0; i < static_cast<int>(boxes.size()); i++) {
+                if (proxies[i] < 0) continue;
+                float dx = coord(rng) * 0.05f;
+                float dy = coord(rng) * 0.05f;
+                boxes[i] = { {boxes[i].min.x + dx, boxes[i].min.y + dy}, {boxes[i].max.x + dx, boxes[i].max.y + dy} };
+                tree.move_proxy(proxies[i], boxes[i], {dx, dy});
+            }
+            // Drop one in ten each round
+            for (int i = round; i < static_cast<int>(boxes.size()); i += 10) {
+                if (proxies[i] < 0 || round % 2) continue;
+                tree.destroy_proxy(proxies[i]);
+                proxies[i] = -1;
+            }
+            REQUIRE(tree.validate());
+        }
+        REQUIRE(tree.get_height() <= 20);
+        for (int i = 0; i < 50; i++) {
+            Aabb query = make_box(coord(rng), coord(rng), 300, 200);
+            REQUIRE(query_ids(tree, query) == brute_force(query));
+        }
+    }
+
+    SECTION("Ray casts visit every leaf the segment crosses") {
+        for (int i = 0; i < 50; i++) {
+            Vector2 from = { coord(rng), coord(rng) };
+            Vector2 to = { coord(rng), coord(rng) };
+            Vector2 delta = { to.x - from.x, to.y - from.y };
+
+            std::vector<int> visited;
+            tree.ray_cast(from, to, [&visited](int id, float max_fraction) {
+                visited.push_back(id);
+                return max_fraction;   // Never clip
+            });
+            std::sort(visited.begin(), visited.end());
+
+            std::vector<int> expected;
+            for (int j = 0; j < static_cast<int>(boxes.size()); j++) {
+                float enter;
+                if (aabb_ray_enter(tree.get_fat_aabb(proxies[j]), from, delta, 1.0f, &enter)) expected.push_back(j);
+            }
+            REQUIRE(visited == expected);
+        }
+    }
+}
@@ -0,0 +1,263 @@
+/// test_collision.cpp — Unit tests for the player collision atom
+
+#include <catch2/catch_all.hpp>
+#include "../atoms/collision.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace player::atoms;
+
+namespace {
+    CollisionObject make_box(float x, float y, float size = 32.0f) {
+        CollisionObject object;
+        object.position = {x, y};
+        object.shape = CollisionShape::Rectangle(size, size);
+        object.is_solid = true;
+        object.id = -1;
+        return object;
+    }
+}
+
+TEST_CASE("Collision world handles", "[player][atom][collision]") {
+    CollisionWorld world;
+    int a = world.add_object(make_box(100, 100));
+    int b = world.add_object(make_box(200, 100));
+    int c = world.add_object(make_box(300, 100));
+
+    SECTION("Handles look up their objects") {
+        REQUIRE(world.get_objects().size() == 3);
+        REQUIRE(world.get_object(a)->position.x == 100);
+        REQUIRE(world.get_object(b)->position.x == 200);
+        REQUIRE(world.get_object(c)->id == c);
+        REQUIRE(world.get_object(-1) == nullptr);
+        REQUIRE(world.get_object(12345) == nullptr);
+    }
+
+    SECTION("Removal keeps the other handles valid") {
+        world.remove_object(a);
+        REQUIRE(world.get_objects().size() == 2);
+        REQUIRE(world.get_object(a) == nullptr);
+        REQUIRE(world.get_object(b)->position.x == 200);
+        REQUIRE(world.get_object(c)->position.x == 300);
+
+        world.update_object_position(c, {400, 100});
+        REQUIRE(world.get_object(c)->position.x == 400);
+
+        // Removing twice is a no-op
+        world.remove_object(a);
+        REQUIRE(world.get_objects().size() == 2);
+    }
+
+    SECTION("A reused slot does not revive a stale handle") {
+        world.remove_object(b);
+        int d = world.add_object(make_box(500, 100));
+        REQUIRE(d != b);
+        REQUIRE(world.get_object(b) == nullptr);
+        REQUIRE(world.get_object(d)->position.x == 500);
+
+        // Stale handles are ignored by every call
+        world.update_object_position(b, {0, 0});
+        world.remove_object(b);
+        REQUIRE(world.get_object(d)->position.x == 500);
+        REQUIRE_FALSE(world.test_collision(b, {500, 100}).collided);
+    }
+
+    SECTION("Collisions report the other object's handle") {
+        CollisionResult result = world.test_collision(a, {190, 100});
+        REQUIRE(result.collided);
+        REQUIRE(result.object_id == b);
+
+        world.remove_object(b);
+        REQUIRE_FALSE(world.test_collision(a, {190, 100}).collided);
+        result = world.test_collision(a, {290, 100});
+        REQUIRE(result.collided);
+        REQUIRE(result.object_id == c);
+    }
+}
+
+TEST_CASE("Collision grid membership", "[player][atom][collision]") {
+    CollisionWorld world(128.0f);
+    int mover = world.add_object(make_box(64, 64));
+    int wall = world.add_object(make_box(300, 64));
+    int moves = world.get_cell_move_count();
+
+    SECTION("Moving within a cell touches no cells") {
+        for (int step = 0; step < 20; step++) {
+            world.update_object_position(mover, {40.0f + step, 64});
+        }
+        REQUIRE(world.get_cell_move_count() == moves);
+    }
+
+    SECTION("Crossing into other cells is tracked") {
+        world.update_object_position(mover, {280, 64});
+        REQUIRE(world.get_cell_move_count() == moves + 1);
+        REQUIRE(world.test_collision(mover, {285, 64}).object_id == wall);
+
+        // Back home: the wall's cell no longer lists the mover
+        world.update_object_position(mover, {64, 64});
+        REQUIRE_FALSE(world.test_collision(wall, {290, 64}).collided);
+        REQUIRE(world.test_collision(wall, {80, 64}).object_id == mover);
+    }
+
+    SECTION("Removed objects leave their cells") {
+        world.remove_object(wall);
+        REQUIRE_FALSE(world.test_collision(mover, {300, 64}).collided);
+        int other = world.add_object(make_box(300, 64));
+        REQUIRE(world.test_collision(mover, {300, 64}).object_id == other);
+    }
+}
+
+TEST_CASE("Collision spatial hash", "[player][atom][collision]") {
+    CollisionWorld world(128.0f);
+
+    SECTION("Objects far outside the old grid don't share cells") {
+        int a = world.add_object(make_box(10000, 10000));
+        int b = world.add_object(make_box(20000, 10000));
+        REQUIRE(world.get_cell_count() == 2);
+        REQUIRE_FALSE(world.test_collision(a, {10010, 10000}).collided);
+        REQUIRE(world.test_collision(a, {19990, 10000}).object_id == b);
+    }
+
+    SECTION("Negative coordinates") {
+        int a = world.add_object(make_box(-64, -64));
+        int b = world.add_object(make_box(0, 0));   // Straddles four cells
+        REQUIRE(world.get_cell_count() == 4);
+        REQUIRE_FALSE(world.test_collision(a, {-40, -40}).collided);
+        REQUIRE(world.test_collision(a, {-20, -20}).object_id == b);
+    }
+
+    SECTION("Only occupied cells are kept") {
+        std::vector<int> ids;
+        for (int i = 0; i < 500; i++) {
+            ids.push_back(world.add_object(make_box(i * 1024.0f + 64, -i * 768.0f - 64)));   // Cell centres
+        }
+        REQUIRE(world.get_cell_count() == 500);
+        for (int i = 0; i < 500; i++) {
+            REQUIRE(world.test_collision(ids[(i + 1) % 500], {i * 1024.0f + 69, -i * 768.0f - 64}).object_id == ids[i]);
+        }
+
+        // Move them all through fresh cells, then remove every other one
+        for (int i = 0; i < 500; i++) {
+            world.update_object_position(ids[i], {i * 1024.0f + 576, -i * 768.0f - 64});
+        }
+        REQUIRE(world.get_cell_count() == 500);
+        for (int i = 0; i < 500; i += 2) {
+            world.remove_object(ids[i]);
+        }
+        REQUIRE(world.get_cell_count() == 250);
+        for (int i = 1; i < 500; i += 2) {
+            REQUIRE(world.test_collision(ids[(i + 2) % 500], {i * 1024.0f + 581, -i * 768.0f - 64}).object_id == ids[i]);
+        }
+        for (int i = 1; i < 500; i += 2) {
+            world.remove_object(ids[i]);
+        }
+        REQUIRE(world.get_cell_count() == 0);
+    }
+}
+
+TEST_CASE("Collision broadphases agree", "[player][atom][collision]") {
+    CollisionWorld grid(128.0f, 10, CollisionBroadphase::GRID);
+    CollisionWorld tree(128.0f, 10, CollisionBroadphase::TREE);
+    REQUIRE(tree.get_broadphase() == CollisionBroadphase::TREE);
+
+    // Slimes, a few long walls and some non-solid circles
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> coord(-1500.0f, 1500.0f);
+    std::vector<int> ids;
+    for (int i = 0; i < 300; i++) {
+        CollisionObject object = make_box(coord(rng), coord(rng), 48);
+        if (i % 30 == 0) object.shape = CollisionShape::Rectangle(50, 400);
+        if (i % 7 == 0) {
+            object.shape = CollisionShape::Circle(24);
+            object.is_solid = i % 2 == 0;
+        }
+        int id = grid.add_object(object);
+        REQUIRE(tree.add_object(object) == id);
+        ids.push_back(id);
+    }
+
+    // Wander, and drop some
+    for (int round = 0; round < 5; round++) {
+        for (int id : ids) {
+            const CollisionObject* object = grid.get_object(id);
+            if (!object) continue;
+            Vector2 position = { object->position.x + coord(rng) * 0.02f, object->position.y + coord(rng) * 0.02f };
+            grid.update_object_position(id, position);
+            tree.update_object_position(id, position);
+        }
+        grid.remove_object(ids[round * 11]);
+        tree.remove_object(ids[round * 11]);
+    }
+
+    SECTION("Collision tests") {
+        for (int id : ids) {
+            const CollisionObject* object = grid.get_object(id);
+            if (!object) continue;
+            Vector2 probe = { object->position.x + 20, object->position.y - 10 };
+            CollisionResult a = grid.test_collision(id, probe);
+            CollisionResult b = tree.test_collision(id, probe);
+            REQUIRE(a.collided == b.collided);
+        }
+    }
+
+    SECTION("Region queries") {
+        int grid_ids[64];
+        int tree_ids[64];
+        for (int i = 0; i < 40; i++) {
+            Rectangle region = { coord(rng), coord(rng), 250, 180 };
+            int grid_count = grid.query_region(region, grid_ids, 64);
+            int tree_count = tree.query_region(region, tree_ids, 64);
+            REQUIRE(grid_count == tree_count);
+            std::sort(grid_ids, grid_ids + grid_count);
+            std::sort(tree_ids, tree_ids + tree_count);
+            REQUIRE(std::equal(grid_ids, grid_ids + grid_count, tree_ids));
+        }
+
+        // Output is capped
+        Rectangle everything = { -3000, -3000, 6000, 6000 };
+        REQUIRE(grid.query_region(everything, grid_ids, 5) == 5);
+        REQUIRE(tree.query_region(everything, tree_ids, 5) == 5);
+    }
+
+    SECTION("Ray casts find the nearest solid object") {
+        for (int i = 0; i < 60; i++) {
+            Vector2 from = { coord(rng), coord(rng) };
+            Vector2 to = { coord(rng), coord(rng) };
+            RayCastResult a = grid.ray_cast(from, to);
+            RayCastResult b = tree.ray_cast(from, to);
+            REQUIRE(a.hit == b.hit);
+            if (!a.hit) continue;
+            REQUIRE(a.fraction == Catch::Approx(b.fraction).margin(1e-5));
+            REQUIRE(a.point.x == Catch::Approx(from.x + (to.x - from.x) * a.fraction));
+            REQUIRE(grid.get_object(a.object_id)->is_solid);
+        }
+    }
+}
+
+TEST_CASE("Collision ray casts", "[player][atom][collision]") {
+    for (CollisionBroadphase broadphase : { CollisionBroadphase::GRID, CollisionBroadphase::TREE }) {
+        CollisionWorld world(128.0f, 10, broadphase);
+        int wall = world.add_object(make_box(600, 0, 64));
+        CollisionObject ghost = make_box(300, 0, 64);
+        ghost.is_solid = false;
+        world.add_object(ghost);
+        CollisionObject rock = make_box(-400, 0);
+        rock.shape = CollisionShape::Circle(50);
+        int rock_id = world.add_object(rock);
+
+        RayCastResult result = world.ray_cast({0, 0}, {1000, 0});
+        REQUIRE(result.hit);
+        REQUIRE(result.object_id == wall);
+        REQUIRE(result.point.x == Catch::Approx(568));
+
+        result = world.ray_cast({0, 0}, {-1000, 0});
+        REQUIRE(result.object_id == rock_id);
+        REQUIRE(result.point.x == Catch::Approx(-350));
+
+        REQUIRE_FALSE(world.ray_cast({0, 0}, {500, 0}).hit);
+        REQUIRE_FALSE(world.ray_cast({0, 100}, {1000, 100}).hit);
+        REQUIRE(world.ray_cast({600, 0}, {1000, 0}).fraction == 0.0f);   // Starts inside
+    }
+}
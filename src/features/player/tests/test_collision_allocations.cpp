@@ -0,0 +1,61 @@
+/// test_collision_allocations.cpp — Heap allocation checks for collision queries
+
+#include <catch2/catch_all.hpp>
+#include "../atoms/collision.hpp"
+#include <cstdlib>
+#include <new>
+
+using namespace player::atoms;
+
+// Count every heap allocation in the test binary; the tests only read the
+// counter around the calls they measure
+namespace {
+    std::size_t allocation_count = 0;
+}
+
+void* operator new(std::size_t size) {
+    allocation_count++;
+    if (void* memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+TEST_CASE("Collision queries do not allocate", "[player][atom][collision]") {
+    for (CollisionBroadphase broadphase : { CollisionBroadphase::GRID, CollisionBroadphase::TREE }) {
+        CollisionWorld world(128.0f, 10, broadphase);
+
+        // A crowd straddling cell borders, so candidates repeat across cells
+        int player_id = world.add_object(CollisionObject{{0, 0}, CollisionShape::Circle(16), true, -1});
+        for (int i = 0; i < 64; i++) {
+            float x = (i % 8) * 40.0f - 140.0f;
+            float y = (i / 8) * 40.0f - 140.0f;
+            world.add_object(CollisionObject{{x, y}, CollisionShape::Rectangle(24, 24), true, -1});
+        }
+
+        int collisions = 0;
+        int found = 0;
+        int hits = 0;
+        int region_ids[16];
+        std::size_t before = allocation_count;
+        for (int i = 0; i < 1000; i++) {
+            float offset = (i % 50) * 4.0f - 100.0f;
+            if (world.test_collision(player_id, {offset, offset * 0.5f}).collided) collisions++;
+            if (world.test_collision(player_id, {offset + 400.0f, 0}).collided) collisions++;
+            found += world.query_region({offset, offset, 100, 60}, region_ids, 16);
+            if (world.ray_cast({-400, offset}, {400, -offset}).hit) hits++;
+        }
+        std::size_t allocations = allocation_count - before;
+
+        REQUIRE(collisions > 0);
+        REQUIRE(found > 0);
+        REQUIRE(hits > 0);
+        REQUIRE(allocations == 0);
+    }
+}
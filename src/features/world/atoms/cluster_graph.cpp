@@ -0,0 +1,375 @@
+/// cluster_graph.cpp — implementation of the hierarchical path planning atom
+#include "cluster_graph.hpp"
+#include "tilemap.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <unordered_map>
+
+namespace world {
+namespace atoms {
+
+namespace {
+    constexpr int STEP_X[8] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+    constexpr int STEP_Y[8] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+
+    constexpr int BUCKET_COUNT = diagonal_step_cost(MAX_MOVE_COST, MAX_MOVE_COST) + 1;
+    constexpr std::uint32_t UNREACHED = 0xFFFFFFFFu;
+
+    // Abstract node ids: cluster index and node index packed, plus two specials.
+    // A border of CHUNK_SIZE tiles has at most CHUNK_SIZE / 2 entrances, so a
+    // cluster has at most 2 * CHUNK_SIZE nodes.
+    constexpr int NODE_SHIFT = 8;
+    constexpr int START_ID = -1;
+    constexpr int GOAL_ID = -2;
+    static_assert(2 * CHUNK_SIZE <= (1 << NODE_SHIFT), "cluster nodes must fit the node id");
+}
+
+void ClusterGraph::init(const Tilemap* tilemap) {
+    tilemap_ = tilemap;
+    clusters_x_ = tilemap ? tilemap->get_chunks_x() : 0;
+    clusters_y_ = tilemap ? tilemap->get_chunks_y() : 0;
+    buckets_.assign(BUCKET_COUNT, {});
+    clear();
+}
+
+void ClusterGraph::clear() {
+    std::size_t count = static_cast<std::size_t>(clusters_x_) * clusters_y_;
+    clusters_.assign(count, Cluster{});
+    east_borders_.assign(count, Border{});
+    south_borders_.assign(count, Border{});
+}
+
+int ClusterGraph::cluster_of(TilePoint tile) const {
+    if (!tilemap_ || tile.x < 0 || tile.y < 0 || tile.x >= tilemap_->get_width() || tile.y >= tilemap_->get_height()) {
+        return -1;
+    }
+    return (tile.y >> CHUNK_SHIFT) * clusters_x_ + (tile.x >> CHUNK_SHIFT);
+}
+
+bool ClusterGraph::plan(TilePoint start, TilePoint goal, std::vector<TilePoint>& out_route) {
+    out_route.clear();
+    int start_index = cluster_of(start);
+    int goal_index = cluster_of(goal);
+    if (start_index < 0 || goal_index < 0 || !tilemap_->is_walkable(goal.x, goal.y)) return false;
+
+    // Near trips fit one windowed search
+    if (std::abs(start_index % clusters_x_ - goal_index % clusters_x_) <= 1 &&
+        std::abs(start_index / clusters_x_ - goal_index / clusters_x_) <= 1) {
+        out_route = { start, goal };
+        return true;
+    }
+
+    // Temporary edges from the start to its cluster's entrances and from the
+    // goal cluster's entrances to the goal
+    const Cluster& start_cluster = cluster_at(start_index);
+    capture_cluster(start_index);
+    flood(start);
+    std::vector<int> start_costs;
+    for (const Node& node : start_cluster.nodes) start_costs.push_back(flood_cost(node.tile));
+
+    const Cluster& goal_cluster = cluster_at(goal_index);
+    capture_cluster(goal_index);
+    flood(goal);
+    std::vector<int> goal_costs;
+    for (const Node& node : goal_cluster.nodes) goal_costs.push_back(flood_cost(node.tile));
+
+    // A* over entrance nodes
+    struct Visit {
+        std::uint32_t cost = UNREACHED;
+        int parent = START_ID;
+        bool closed = false;
+    };
+    std::unordered_map<int, Visit> visits;
+    std::vector<std::pair<std::uint32_t, int>> open;
+    auto tile_of = [this, goal](int id) {
+        return id == GOAL_ID ? goal : clusters_[id >> NODE_SHIFT].nodes[id & ((1 << NODE_SHIFT) - 1)].tile;
+    };
+    auto relax = [&](int id, std::uint32_t cost, int parent) {
+        Visit& visit = visits[id];
+        if (visit.closed || cost >= visit.cost) return;
+        visit.cost = cost;
+        visit.parent = parent;
+        open.emplace_back(cost + PathSearch::octile_cost(tile_of(id), goal), id);
+        std::push_heap(open.begin(), open.end(), std::greater<>());
+    };
+
+    for (std::size_t i = 0; i < start_costs.size(); i++) {
+        if (start_costs[i] != NO_COST) {
+            relax((start_index << NODE_SHIFT) | static_cast<int>(i), start_costs[i], START_ID);
+        }
+    }
+
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), std::greater<>());
+        int id = open.back().second;
+        open.pop_back();
+        Visit& visit = visits[id];
+        if (visit.closed) continue;
+        visit.closed = true;
+        const std::uint32_t cost = visit.cost;
+
+        if (id == GOAL_ID) {
+            std::vector<TilePoint> tiles;
+            for (int node = id; node != START_ID; node = visits[node].parent) {
+                tiles.push_back(tile_of(node));
+            }
+            std::reverse(tiles.begin(), tiles.end());
+
+            // Keep the first tile of each cluster entered, then the goal
+            out_route.push_back(start);
+            for (const TilePoint& tile : tiles) {
+                if (cluster_of(tile) != cluster_of(out_route.back())) out_route.push_back(tile);
+            }
+            if (out_route.back() != goal) out_route.push_back(goal);
+            return true;
+        }
+
+        const int index = id >> NODE_SHIFT;
+        const int node_index = id & ((1 << NODE_SHIFT) - 1);
+        const Cluster& cluster = cluster_at(index);
+        const Node node = cluster.nodes[node_index];
+        const int count = static_cast<int>(cluster.nodes.size());
+
+        for (int j = 0; j < count; j++) {
+            int edge = cluster.costs[node_index * count + j];
+            if (j != node_index && edge != NO_COST) {
+                relax((index << NODE_SHIFT) | j, cost + edge, id);
+            }
+        }
+        if (index == goal_index && goal_costs[node_index] != NO_COST) {
+            relax(GOAL_ID, cost + goal_costs[node_index], id);
+        }
+
+        // Step across the border to the paired node
+        const Cluster& other = cluster_at(node.link_cluster);
+        std::uint32_t crossing = straight_step_cost(tilemap_->get_move_cost(node.tile.x, node.tile.y),
+                                                    tilemap_->get_move_cost(node.link.x, node.link.y));
+        for (std::size_t k = 0; k < other.nodes.size(); k++) {
+            if (other.nodes[k].tile == node.link && other.nodes[k].link == node.tile) {
+                relax((node.link_cluster << NODE_SHIFT) | static_cast<int>(k), cost + crossing, id);
+                break;
+            }
+        }
+    }
+    return false;
+}
+
+void ClusterGraph::invalidate(int min_x, int min_y, int max_x, int max_y) {
+    if (!tilemap_ || clusters_.empty()) return;
+
+    const int width = tilemap_->get_width();
+    const int height = tilemap_->get_height();
+    if (min_x <= 0 && min_y <= 0 && max_x >= width - 1 && max_y >= height - 1) {
+        clear();
+        return;
+    }
+
+    auto overlaps = [&](int x0, int y0, int x1, int y1) {
+        return max_x >= x0 && min_x <= x1 && max_y >= y0 && min_y <= y1;
+    };
+
+    // One tile of slack reaches the borders of the clusters to the west and north
+    int cx0 = std::max((min_x - 1) >> CHUNK_SHIFT, 0);
+    int cy0 = std::max((min_y - 1) >> CHUNK_SHIFT, 0);
+    int cx1 = std::min(max_x >> CHUNK_SHIFT, clusters_x_ - 1);
+    int cy1 = std::min(max_y >> CHUNK_SHIFT, clusters_y_ - 1);
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            int index = cy * clusters_x_ + cx;
+            int x0 = cx << CHUNK_SHIFT;
+            int y0 = cy << CHUNK_SHIFT;
+            int x1 = x0 + CHUNK_SIZE - 1;
+            int y1 = y0 + CHUNK_SIZE - 1;
+
+            // Paths inside the cluster
+            if (overlaps(x0, y0, x1, y1)) {
+                clusters_[index].built = false;
+            }
+
+            // Entrances on the two tiles either side of a border
+            if (cx + 1 < clusters_x_ && overlaps(x1, y0, x1 + 1, y1)) {
+                east_borders_[index].built = false;
+                clusters_[index].built = false;
+                clusters_[index + 1].built = false;
+            }
+            if (cy + 1 < clusters_y_ && overlaps(x0, y1, x1, y1 + 1)) {
+                south_borders_[index].built = false;
+                clusters_[index].built = false;
+                clusters_[index + clusters_x_].built = false;
+            }
+        }
+    }
+}
+
+int ClusterGraph::get_built_cluster_count() const {
+    return static_cast<int>(std::count_if(clusters_.begin(), clusters_.end(),
+                                          [](const Cluster& cluster) { return cluster.built; }));
+}
+
+int ClusterGraph::get_node_count() const {
+    int count = 0;
+    for (const Cluster& cluster : clusters_) {
+        if (cluster.built) count += static_cast<int>(cluster.nodes.size());
+    }
+    return count;
+}
+
+ClusterGraph::Cluster& ClusterGraph::cluster_at(int index) {
+    Cluster& cluster = clusters_[index];
+    if (!cluster.built) {
+        build_cluster(index, cluster);
+    }
+    return cluster;
+}
+
+ClusterGraph::Border& ClusterGraph::border_at(int index, bool east) {
+    Border& border = east ? east_borders_[index] : south_borders_[index];
+    if (!border.built) {
+        build_border(index, east, border);
+    }
+    return border;
+}
+
+void ClusterGraph::build_border(int index, bool east, Border& border) {
+    border.entrances.clear();
+    border.built = true;
+
+    // Tiles along the border on the near side; the far side is one step east / south
+    const int cx = index % clusters_x_;
+    const int cy = index / clusters_x_;
+    const int length = east ? std::min(CHUNK_SIZE, tilemap_->get_height() - (cy << CHUNK_SHIFT))
+                            : std::min(CHUNK_SIZE, tilemap_->get_width() - (cx << CHUNK_SHIFT));
+    auto near_tile = [&](int i) -> TilePoint {
+        return east ? TilePoint{ ((cx + 1) << CHUNK_SHIFT) - 1, (cy << CHUNK_SHIFT) + i }
+                    : TilePoint{ (cx << CHUNK_SHIFT) + i, ((cy + 1) << CHUNK_SHIFT) - 1 };
+    };
+    auto far_tile = [&](int i) -> TilePoint {
+        TilePoint tile = near_tile(i);
+        return east ? TilePoint{ tile.x + 1, tile.y } : TilePoint{ tile.x, tile.y + 1 };
+    };
+    auto add = [&](int i) { border.entrances.push_back({ near_tile(i), far_tile(i) }); };
+
+    // Each run of tiles open on both sides gets an entrance in its middle,
+    // or one at each end if it is wide
+    int run_start = -1;
+    for (int i = 0; i <= length; i++) {
+        bool open = false;
+        if (i < length) {
+            TilePoint a = near_tile(i);
+            TilePoint b = far_tile(i);
+            open = tilemap_->is_walkable(a.x, a.y) && tilemap_->is_walkable(b.x, b.y);
+        }
+        if (open && run_start < 0) run_start = i;
+        if (!open && run_start >= 0) {
+            int run_end = i - 1;
+            if (run_end - run_start + 1 >= WIDE_ENTRANCE) {
+                add(run_start);
+                add(run_end);
+            } else {
+                add((run_start + run_end) / 2);
+            }
+            run_start = -1;
+        }
+    }
+}
+
+void ClusterGraph::build_cluster(int index, Cluster& cluster) {
+    cluster.nodes.clear();
+    const int cx = index % clusters_x_;
+    const int cy = index / clusters_x_;
+
+    // West and north borders belong to the neighbours; this cluster is their far side
+    if (cx > 0) {
+        for (const Entrance& entrance : border_at(index - 1, true).entrances) {
+            cluster.nodes.push_back({ entrance.far_tile, entrance.near_tile, index - 1 });
+        }
+    }
+    if (cy > 0) {
+        for (const Entrance& entrance : border_at(index - clusters_x_, false).entrances) {
+            cluster.nodes.push_back({ entrance.far_tile, entrance.near_tile, index - clusters_x_ });
+        }
+    }
+    if (cx + 1 < clusters_x_) {
+        for (const Entrance& entrance : border_at(index, true).entrances) {
+            cluster.nodes.push_back({ entrance.near_tile, entrance.far_tile, index + 1 });
+        }
+    }
+    if (cy + 1 < clusters_y_) {
+        for (const Entrance& entrance : border_at(index, false).entrances) {
+            cluster.nodes.push_back({ entrance.near_tile, entrance.far_tile, index + clusters_x_ });
+        }
+    }
+
+    // Path costs between every pair of entrances, one flood per entrance
+    const int count = static_cast<int>(cluster.nodes.size());
+    cluster.costs.assign(static_cast<std::size_t>(count) * count, NO_COST);
+    capture_cluster(index);
+    for (int i = 0; i < count; i++) {
+        flood(cluster.nodes[i].tile);
+        for (int j = 0; j < count; j++) {
+            cluster.costs[i * count + j] = flood_cost(cluster.nodes[j].tile);
+        }
+    }
+    cluster.built = true;
+}
+
+void ClusterGraph::capture_cluster(int index) {
+    int x0 = (index % clusters_x_) << CHUNK_SHIFT;
+    int y0 = (index / clusters_x_) << CHUNK_SHIFT;
+    grid_.capture(*tilemap_, x0, y0, x0 + CHUNK_SIZE - 1, y0 + CHUNK_SIZE - 1);
+}
+
+void ClusterGraph::flood(TilePoint source) {
+    const int width = grid_.width;
+    const int height = grid_.height;
+    flood_costs_.assign(static_cast<std::size_t>(width) * height, UNREACHED);
+    int sx = source.x - grid_.origin_x;
+    int sy = source.y - grid_.origin_y;
+    if (sx < 0 || sx >= width || sy < 0 || sy >= height) return;
+
+    // Dial's algorithm as in FlowField::rebuild
+    for (auto& bucket : buckets_) bucket.clear();
+    int source_index = sy * width + sx;
+    flood_costs_[source_index] = 0;
+    buckets_[0].push_back(source_index);
+    int pending = 1;
+    for (std::uint32_t cost = 0; pending > 0; cost++) {
+        std::vector<int>& bucket = buckets_[cost % BUCKET_COUNT];
+        for (std::size_t b = 0; b < bucket.size(); b++) {
+            int index = bucket[b];
+            pending--;
+            if (flood_costs_[index] != cost) continue;
+
+            int x = index % width;
+            int y = index / width;
+            for (int code = 0; code < 8; code++) {
+                int nx = x + STEP_X[code];
+                int ny = y + STEP_Y[code];
+                if (!grid_.is_open(nx, ny)) continue;
+                if ((code & 1) && !(grid_.is_open(nx, y) && grid_.is_open(x, ny))) continue;
+                int next = ny * width + nx;
+                std::uint8_t from = grid_.cost_at(index);
+                std::uint8_t to = grid_.cost_at(next);
+                std::uint32_t next_cost = cost + ((code & 1) ? diagonal_step_cost(from, to) : straight_step_cost(from, to));
+                if (next_cost < flood_costs_[next]) {
+                    flood_costs_[next] = next_cost;
+                    buckets_[next_cost % BUCKET_COUNT].push_back(next);
+                    pending++;
+                }
+            }
+        }
+        bucket.clear();
+    }
+}
+
+int ClusterGraph::flood_cost(TilePoint tile) const {
+    int x = tile.x - grid_.origin_x;
+    int y = tile.y - grid_.origin_y;
+    if (x < 0 || x >= grid_.width || y < 0 || y >= grid_.height) return NO_COST;
+    std::uint32_t cost = flood_costs_[y * grid_.width + x];
+    return cost == UNREACHED ? NO_COST : static_cast<int>(cost);
+}
+
+} // namespace atoms
+} // namespace world
@@ -0,0 +1,104 @@
+/// cluster_graph.hpp — hierarchical (HPA*) path planning atom for world slice
+#pragma once
+#include "path_search.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace world {
+namespace atoms {
+
+// Forward declarations
+class Tilemap;
+
+// Abstract graph for long trips (HPA*, Botea et al.). Each tilemap chunk is a
+// cluster; where open tiles face each other across a cluster border an
+// entrance joins the two clusters, and inside a cluster every pair of
+// entrance tiles is linked with its precomputed path cost. Long paths are
+// planned over this graph as a list of entrances and refined one leg at a
+// time as the agent walks. Clusters are built the first time a plan reaches
+// them; edits only mark the clusters and borders they touch for rebuild.
+class ClusterGraph {
+public:
+    void init(const Tilemap* tilemap);
+
+    // Plan from start to goal. out_route receives the start, the first tile
+    // entered in each cluster along the way, and the goal; each leg stays
+    // within one cluster plus the step across its border. Trips between the
+    // same or neighbouring clusters skip the graph and return {start, goal}.
+    // Paths run only through cluster entrances, so they can be a few
+    // percent longer than the shortest path.
+    // PERF: two cluster floods for start and goal plus A* over entrance nodes;
+    // building a cluster costs one flood of it per entrance
+    bool plan(TilePoint start, TilePoint goal, std::vector<TilePoint>& out_route);
+
+    // Walkability changed in the inclusive range: clusters it overlaps and
+    // borders it touches are rebuilt when next reached
+    void invalidate(int min_x, int min_y, int max_x, int max_y);
+
+    void clear();
+
+    int get_built_cluster_count() const;
+    int get_node_count() const;
+
+    // Runs of open border tiles at least this long get an entrance at both ends
+    static constexpr int WIDE_ENTRANCE = 6;
+
+private:
+    static constexpr int NO_COST = -1;
+
+    // Entrance pair across a border, first tile on the west / north side
+    struct Entrance {
+        TilePoint near_tile;
+        TilePoint far_tile;
+    };
+
+    struct Border {
+        bool built = false;
+        std::vector<Entrance> entrances;
+    };
+
+    // Entrance tile on this cluster's side and the tile it steps across to
+    struct Node {
+        TilePoint tile;
+        TilePoint link;
+        int link_cluster;
+    };
+
+    struct Cluster {
+        bool built = false;
+        std::vector<Node> nodes;
+        std::vector<int> costs;    // nodes x nodes path costs inside the cluster, NO_COST if none
+    };
+
+    const Tilemap* tilemap_ = nullptr;
+    int clusters_x_ = 0;
+    int clusters_y_ = 0;
+    std::vector<Cluster> clusters_;
+    std::vector<Border> east_borders_;    // Border with the cluster to the east, per cluster
+    std::vector<Border> south_borders_;   // Border with the cluster to the south, per cluster
+
+    // Flood scratch
+    PathGrid grid_;
+    std::vector<std::uint32_t> flood_costs_;
+    std::vector<std::vector<int>> buckets_;
+
+    Cluster& cluster_at(int index);
+    Border& border_at(int index, bool east);
+    void build_border(int index, bool east, Border& border);
+    void build_cluster(int index, Cluster& cluster);
+
+    // Index of the cluster holding a tile, -1 outside the map
+    int cluster_of(TilePoint tile) const;
+
+    // Capture a cluster's tiles into grid_
+    void capture_cluster(int index);
+
+    // Path costs from source to every tile of grid_ (step costs from the
+    // tiles' move costs, no corner cutting); the source counts as open
+    void flood(TilePoint source);
+    int flood_cost(TilePoint tile) const;
+};
+
+} // namespace atoms
+} // namespace world
@@ -0,0 +1,256 @@
+/// distance_field.cpp — implementation of the nearest-blocked-tile distance field atom
+#include "distance_field.hpp"
+#include "tilemap.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace world {
+namespace atoms {
+
+namespace {
+    // Distance from a point to the square of tile (x, y)
+    float square_distance(Vector2 point, int x, int y, float tile_size) {
+        float gap_x = std::max(std::max(x * tile_size - point.x, point.x - (x + 1) * tile_size), 0.0f);
+        float gap_y = std::max(std::max(y * tile_size - point.y, point.y - (y + 1) * tile_size), 0.0f);
+        return std::sqrt(gap_x * gap_x + gap_y * gap_y);
+    }
+}
+
+void DistanceField::init(const Tilemap* tilemap) {
+    tilemap_ = tilemap;
+    clear();
+}
+
+float DistanceField::get_clearance(Vector2 point, float max_distance) {
+    if (!tilemap_) return max_distance;
+
+    const float tile_size = static_cast<float>(tilemap_->get_tile_size());
+    int tile_x = static_cast<int>(std::floor(point.x / tile_size));
+    int tile_y = static_cast<int>(std::floor(point.y / tile_size));
+    int width = tilemap_->get_width();
+    int height = tilemap_->get_height();
+    if (tile_x < 0 || tile_x >= width || tile_y < 0 || tile_y >= height) {
+        return scan_clearance(point, max_distance);
+    }
+
+    // Every blocked tile is at least the tile's own feature distance from its
+    // centre, so nothing is nearer the point than that minus a tile diagonal
+    const Cell& own = cell_at(tile_x, tile_y);
+    float own_tiles = own.dx == NO_FEATURE ? static_cast<float>(MAX_TILES)
+                                           : std::sqrt(static_cast<float>(own.dx * own.dx + own.dy * own.dy));
+    if (max_distance <= (own_tiles - 1.4143f) * tile_size) {
+        return max_distance;
+    }
+    float best = max_distance;
+    if (own.dx != NO_FEATURE) {
+        best = std::min(best, square_distance(point, tile_x + own.dx, tile_y + own.dy, tile_size));
+    }
+
+    // The nearest square in each column is the nearest blocked tile straight up
+    // or down from the point's row; columns are swept outwards until they are
+    // further away sideways than the best square so far
+    const Page* page = nullptr;
+    int page_chunk_x = -1;
+    for (int step = 0; step <= MAX_TILES && (step - 1) * tile_size < best; step++) {
+        for (int x : { tile_x - step, tile_x + step }) {
+            if (x >= 0 && x < width) {
+                if ((x >> CHUNK_SHIFT) != page_chunk_x) {
+                    page_chunk_x = x >> CHUNK_SHIFT;
+                    page = &page_for(page_chunk_x, tile_y >> CHUNK_SHIFT);
+                }
+                const Cell& cell = page->cells[(tile_y & CHUNK_MASK) * CHUNK_SIZE + (x & CHUNK_MASK)];
+                if (cell.up != NO_ROW) {
+                    best = std::min(best, square_distance(point, x, tile_y - cell.up, tile_size));
+                }
+                if (cell.down != NO_ROW) {
+                    best = std::min(best, square_distance(point, x, tile_y + cell.down, tile_size));
+                }
+            }
+            if (step == 0) break;
+        }
+    }
+
+    // Columns only track MAX_TILES rows each way
+    if (best > (MAX_TILES - 1) * tile_size) {
+        return scan_clearance(point, max_distance);
+    }
+    return best;
+}
+
+float DistanceField::get_tile_distance(int x, int y) {
+    if (!tilemap_ || x < 0 || x >= tilemap_->get_width() || y < 0 || y >= tilemap_->get_height()) {
+        return -1.0f;
+    }
+    const Cell& cell = cell_at(x, y);
+    if (cell.dx == NO_FEATURE) return -1.0f;
+    return std::sqrt(static_cast<float>(cell.dx * cell.dx + cell.dy * cell.dy));
+}
+
+void DistanceField::update(int min_x, int min_y, int max_x, int max_y) {
+    if (!tilemap_ || pages_.empty()) return;
+
+    // A whole-map change (new chunk source) is cheaper to rebuild on demand
+    if (min_x <= 0 && min_y <= 0 && max_x >= tilemap_->get_width() - 1 && max_y >= tilemap_->get_height() - 1) {
+        clear();
+        return;
+    }
+
+    // Tiles up to MAX_TILES away may have had their nearest blocked tile change
+    min_x -= MAX_TILES;
+    min_y -= MAX_TILES;
+    max_x += MAX_TILES;
+    max_y += MAX_TILES;
+
+    int chunks_x = tilemap_->get_chunks_x();
+    for (auto& entry : pages_) {
+        int origin_x = (entry.first % chunks_x) * CHUNK_SIZE;
+        int origin_y = (entry.first / chunks_x) * CHUNK_SIZE;
+        int x0 = std::max(min_x, origin_x);
+        int x1 = std::min(max_x, origin_x + CHUNK_SIZE - 1);
+        int y0 = std::max(min_y, origin_y);
+        int y1 = std::min(max_y, origin_y + CHUNK_SIZE - 1);
+        if (x0 <= x1 && y0 <= y1) {
+            build_region(*entry.second, x0, y0, x1, y1);
+        }
+    }
+}
+
+void DistanceField::clear() {
+    pages_.clear();
+    use_counter_ = 0;
+}
+
+DistanceField::Page& DistanceField::page_for(int chunk_x, int chunk_y) {
+    int key = chunk_y * tilemap_->get_chunks_x() + chunk_x;
+    auto it = pages_.find(key);
+    if (it == pages_.end()) {
+        // Over budget: drop the page queried least recently
+        while (max_pages_ > 0 && static_cast<int>(pages_.size()) >= max_pages_) {
+            auto oldest = std::min_element(pages_.begin(), pages_.end(), [](const auto& a, const auto& b) {
+                return a.second->last_used < b.second->last_used;
+            });
+            pages_.erase(oldest);
+        }
+
+        auto page = std::make_unique<Page>();
+        page->cells.resize(CHUNK_AREA);
+        int origin_x = chunk_x * CHUNK_SIZE;
+        int origin_y = chunk_y * CHUNK_SIZE;
+        build_region(*page, origin_x, origin_y, origin_x + CHUNK_SIZE - 1, origin_y + CHUNK_SIZE - 1);
+        it = pages_.emplace(key, std::move(page)).first;
+    }
+    it->second->last_used = ++use_counter_;
+    return *it->second;
+}
+
+void DistanceField::build_region(Page& page, int min_x, int min_y, int max_x, int max_y) {
+    // Only blocked tiles within MAX_TILES of the region can be nearest to it
+    const int window_x = min_x - MAX_TILES;
+    const int window_y = min_y - MAX_TILES;
+    const int w = max_x - min_x + 1 + 2 * MAX_TILES;
+    const int h = max_y - min_y + 1 + 2 * MAX_TILES;
+    const int words = (w + 63) / 64;
+
+    blocked_.resize(static_cast<std::size_t>(words) * h);
+    for (int y = 0; y < h; y++) {
+        for (int word = 0; word < words; word++) {
+            blocked_[y * words + word] = ~tilemap_->get_walkable_bits(window_x + word * 64, window_y + y);
+        }
+    }
+    auto is_blocked = [&](int x, int y) {
+        return (blocked_[y * words + (x >> 6)] >> (x & 63)) & 1;
+    };
+
+    // Column pass: nearest blocked rows above and below each cell (-1 = none)
+    std::size_t area = static_cast<std::size_t>(w) * h;
+    above_.assign(area, -1);
+    below_.assign(area, -1);
+    nearest_row_.assign(area, -1);
+    for (int x = 0; x < w; x++) {
+        int last = -1;
+        for (int y = 0; y < h; y++) {
+            if (is_blocked(x, y)) last = y;
+            above_[y * w + x] = last;
+        }
+        int next = -1;
+        for (int y = h - 1; y >= 0; y--) {
+            if (is_blocked(x, y)) next = y;
+            below_[y * w + x] = next;
+            int above = above_[y * w + x];
+            nearest_row_[y * w + x] = next >= 0 && (above < 0 || next - y < y - above) ? next : above;
+        }
+    }
+
+    // Row pass: lower envelope of the parabolas (x - q)^2 + column distance(q)^2
+    // (Felzenszwalb & Huttenlocher), whose minimum at x is the nearest blocked tile
+    hull_.resize(w);
+    bounds_.resize(w + 1);
+    const double inf = std::numeric_limits<double>::infinity();
+    for (int y = MAX_TILES; y < h - MAX_TILES; y++) {
+        const int* row = &nearest_row_[y * w];
+        auto height_of = [&](int q) {
+            double dy = row[q] - y;
+            return dy * dy + static_cast<double>(q) * q;
+        };
+
+        int k = -1;
+        for (int q = 0; q < w; q++) {
+            if (row[q] < 0) continue;
+            double s = -inf;
+            while (k >= 0) {
+                s = (height_of(q) - height_of(hull_[k])) / (2.0 * (q - hull_[k]));
+                if (s > bounds_[k]) break;
+                k--;
+            }
+            k++;
+            hull_[k] = q;
+            bounds_[k] = k == 0 ? -inf : s;
+            bounds_[k + 1] = inf;
+        }
+
+        Cell* out = &page.cells[((min_y + y - MAX_TILES) & CHUNK_MASK) * CHUNK_SIZE];
+        int j = 0;
+        for (int x = MAX_TILES; x < w - MAX_TILES; x++) {
+            Cell& cell = out[(min_x + x - MAX_TILES) & CHUNK_MASK];
+            cell = Cell{};
+
+            // The window reaches MAX_TILES past the region, so both always fit
+            int above = above_[y * w + x];
+            int below = below_[y * w + x];
+            if (above >= 0 && y - above <= MAX_TILES) cell.up = static_cast<std::uint8_t>(y - above);
+            if (below >= 0 && below - y <= MAX_TILES) cell.down = static_cast<std::uint8_t>(below - y);
+
+            if (k < 0) continue;
+            while (bounds_[j + 1] < x) j++;
+            int q = hull_[j];
+            int dx = q - x;
+            int dy = row[q] - y;
+            if (dx * dx + dy * dy <= MAX_TILES * MAX_TILES) {
+                cell.dx = static_cast<std::int8_t>(dx);
+                cell.dy = static_cast<std::int8_t>(dy);
+            }
+        }
+    }
+}
+
+float DistanceField::scan_clearance(Vector2 point, float max_distance) const {
+    const float tile_size = static_cast<float>(tilemap_->get_tile_size());
+    int min_x = std::max(static_cast<int>(std::floor((point.x - max_distance) / tile_size)), 0);
+    int min_y = std::max(static_cast<int>(std::floor((point.y - max_distance) / tile_size)), 0);
+    int max_x = std::min(static_cast<int>(std::floor((point.x + max_distance) / tile_size)), tilemap_->get_width() - 1);
+    int max_y = std::min(static_cast<int>(std::floor((point.y + max_distance) / tile_size)), tilemap_->get_height() - 1);
+
+    float best = max_distance;
+    for (int y = min_y; y <= max_y; y++) {
+        for (int x = min_x; x <= max_x; x++) {
+            if (!tilemap_->is_walkable(x, y)) {
+                best = std::min(best, square_distance(point, x, y, tile_size));
+            }
+        }
+    }
+    return best;
+}
+
+} // namespace atoms
+} // namespace world
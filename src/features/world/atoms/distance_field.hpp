@@ -0,0 +1,99 @@
+/// distance_field.hpp — nearest-blocked-tile distance field atom for world slice
+#pragma once
+#include <raylib.h>
+#include "tile_chunk.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace world {
+namespace atoms {
+
+// Forward declarations
+class Tilemap;
+
+// Per-tile nearest blocked tile (a feature transform of the walkability
+// bitmap) plus the nearest blocked tile straight up and down, kept in per-chunk
+// pages. A page is built with a linear-time separable Euclidean distance
+// transform when its chunk is first queried and patched locally by update
+// after edits. Blocked tiles more than MAX_TILES away are not tracked. Tiles
+// outside the map count as open, as in Tilemap::is_walkable.
+class DistanceField {
+public:
+    static constexpr int MAX_TILES = 16;
+
+    void init(const Tilemap* tilemap);
+
+    // Exact distance from a point to the nearest blocked tile's square, capped
+    // at max_distance
+    // PERF: O(1) when the tile's own feature shows nothing is within max_distance,
+    // else one cell read per tile column out to the nearest square;
+    // O(r^2) scan outside the map or past MAX_TILES
+    float get_clearance(Vector2 point, float max_distance);
+
+    // Does a circle of this radius fit at center without touching a blocked tile
+    bool fits_circle(Vector2 center, float radius) { return get_clearance(center, radius) >= radius; }
+
+    // Distance in tiles between tile centres to the nearest blocked tile,
+    // or -1 if there is none within MAX_TILES (tile must be in the map)
+    float get_tile_distance(int x, int y);
+
+    // Walkability changed in the inclusive range; rebuild the entries it can reach
+    // PERF: one transform over (range + 2 * MAX_TILES)^2 tiles per cached page touched
+    void update(int min_x, int min_y, int max_x, int max_y);
+
+    void clear();
+
+    // Maximum number of chunk pages kept, least recently used dropped first (0 = no limit)
+    void set_page_budget(int max_pages) { max_pages_ = max_pages; }
+    int get_page_count() const { return static_cast<int>(pages_.size()); }
+
+private:
+    // Offset from a tile to its nearest blocked tile, and rows up and down to
+    // the nearest blocked tile in its column
+    struct Cell {
+        std::int8_t dx = NO_FEATURE;
+        std::int8_t dy = 0;
+        std::uint8_t up = NO_ROW;
+        std::uint8_t down = NO_ROW;
+    };
+    static constexpr std::int8_t NO_FEATURE = -128;
+    static constexpr std::uint8_t NO_ROW = 255;
+
+    struct Page {
+        std::vector<Cell> cells;   // CHUNK_AREA, row-major like the chunk
+        std::uint32_t last_used = 0;
+    };
+
+    const Tilemap* tilemap_ = nullptr;
+    std::unordered_map<int, std::unique_ptr<Page>> pages_;   // Keyed by chunk index
+    int max_pages_ = 64;
+    std::uint32_t use_counter_ = 0;
+
+    // Transform scratch, reused between builds
+    std::vector<std::uint64_t> blocked_;   // Window rows, 64 tiles per word (1 = blocked)
+    std::vector<int> above_;               // Per window cell: nearest blocked row at or above (-1 = none)
+    std::vector<int> below_;               // Per window cell: nearest blocked row at or below (-1 = none)
+    std::vector<int> nearest_row_;         // Per window cell: nearer of the two
+    std::vector<int> hull_;                // Lower envelope parabola columns
+    std::vector<double> bounds_;           // Lower envelope boundaries
+
+    // Page for a chunk, built (evicting over budget) if missing
+    Page& page_for(int chunk_x, int chunk_y);
+
+    // Cell of an in-map tile
+    const Cell& cell_at(int x, int y) {
+        return page_for(x >> CHUNK_SHIFT, y >> CHUNK_SHIFT).cells[(y & CHUNK_MASK) * CHUNK_SIZE + (x & CHUNK_MASK)];
+    }
+
+    // Recompute the cells of an inclusive tile range inside one page
+    void build_region(Page& page, int min_x, int min_y, int max_x, int max_y);
+
+    // Exact clearance by scanning every tile within max_distance
+    float scan_clearance(Vector2 point, float max_distance) const;
+};
+
+} // namespace atoms
+} // namespace world
@@ -0,0 +1,172 @@
+/// flow_field.cpp — implementation of the shared flow field atom
+#include "flow_field.hpp"
+#include "tilemap.hpp"
+#include <algorithm>
+
+namespace world {
+namespace atoms {
+
+namespace {
+    // Neighbour steps by direction code, clockwise from east (y points down)
+    constexpr int STEP_X[8] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+    constexpr int STEP_Y[8] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+
+    // Straight moves first so ties prefer them
+    constexpr int SEARCH_ORDER[8] = { 0, 2, 4, 6, 1, 3, 5, 7 };
+
+    // Costs pending at once span one edge
+    constexpr int BUCKET_COUNT = diagonal_step_cost(MAX_MOVE_COST, MAX_MOVE_COST) + 1;
+}
+
+void FlowField::init(const Tilemap* tilemap, int radius_tiles) {
+    tilemap_ = tilemap;
+    radius_ = std::max(radius_tiles, 1);
+    size_ = radius_ * 2 + 1;
+
+    std::size_t area = static_cast<std::size_t>(size_) * size_;
+    directions_.assign(area, DIR_NONE);
+    costs_.assign(area, UNREACHED);
+    move_costs_.assign(area, 0);
+    buckets_.assign(BUCKET_COUNT, {});
+    has_target_ = false;
+    dirty_ = true;
+}
+
+bool FlowField::set_target(int tile_x, int tile_y) {
+    if (!tilemap_) return false;
+    if (has_target_ && !dirty_ && tile_x == target_x_ && tile_y == target_y_) {
+        return false;
+    }
+
+    target_x_ = tile_x;
+    target_y_ = tile_y;
+    has_target_ = true;
+    rebuild();
+    dirty_ = false;
+    return true;
+}
+
+std::uint8_t FlowField::get_direction_code(int tile_x, int tile_y) const {
+    if (!has_target_) return DIR_NONE;
+    int local_x = tile_x - origin_x_;
+    int local_y = tile_y - origin_y_;
+    if (local_x < 0 || local_x >= size_ || local_y < 0 || local_y >= size_) {
+        return DIR_NONE;
+    }
+    return directions_[local_y * size_ + local_x];
+}
+
+Vector2 FlowField::step_of(std::uint8_t code) {
+    if (code >= 8) return { 0.0f, 0.0f };
+    return { static_cast<float>(STEP_X[code]), static_cast<float>(STEP_Y[code]) };
+}
+
+int FlowField::get_cost(int tile_x, int tile_y) const {
+    if (get_direction_code(tile_x, tile_y) == DIR_NONE) return -1;
+    return static_cast<int>(costs_[(tile_y - origin_y_) * size_ + (tile_x - origin_x_)]);
+}
+
+void FlowField::invalidate(int min_x, int min_y, int max_x, int max_y) {
+    if (!has_target_) return;
+    if (max_x < origin_x_ || min_x >= origin_x_ + size_ || max_y < origin_y_ || min_y >= origin_y_ + size_) {
+        return;
+    }
+    dirty_ = true;
+}
+
+void FlowField::rebuild() {
+    origin_x_ = target_x_ - radius_;
+    origin_y_ = target_y_ - radius_;
+
+    // Window move costs, a chunk row at a time; tiles outside the map are walls
+    int map_width = tilemap_->get_width();
+    int map_height = tilemap_->get_height();
+    int in_map_x0 = std::clamp(-origin_x_, 0, size_);
+    int in_map_x1 = std::clamp(map_width - origin_x_, 0, size_);
+    for (int y = 0; y < size_; y++) {
+        std::uint8_t* row = &move_costs_[y * size_];
+        int tile_y = origin_y_ + y;
+        std::fill(row, row + size_, 0);
+        if (tile_y < 0 || tile_y >= map_height || in_map_x0 >= in_map_x1) continue;
+        tilemap_->get_move_costs(origin_x_ + in_map_x0, tile_y, in_map_x1 - in_map_x0, row + in_map_x0);
+    }
+
+    std::fill(costs_.begin(), costs_.end(), UNREACHED);
+    std::fill(directions_.begin(), directions_.end(), DIR_NONE);
+
+    auto can_step = [this](int x, int y, int code) {
+        int nx = x + STEP_X[code];
+        int ny = y + STEP_Y[code];
+        if (nx < 0 || nx >= size_ || ny < 0 || ny >= size_ || !move_costs_[ny * size_ + nx]) {
+            return false;
+        }
+        // Diagonals must not cut a blocked corner
+        return (code & 1) == 0 || (move_costs_[y * size_ + nx] && move_costs_[ny * size_ + x]);
+    };
+    auto step_cost = [this](int from, int to, int code) {
+        return (code & 1) ? diagonal_step_cost(move_costs_[from], move_costs_[to])
+                          : straight_step_cost(move_costs_[from], move_costs_[to]);
+    };
+
+    // The target tile is always open, even if the target stands on a wall
+    int goal = radius_ * size_ + radius_;
+    if (move_costs_[goal] == 0) move_costs_[goal] = MOVE_COST_BASE;
+    costs_[goal] = 0;
+
+    // Dial's algorithm: edge costs are small integers, so a ring of buckets
+    // replaces the heap and the search is linear in the window
+    for (auto& bucket : buckets_) bucket.clear();
+    buckets_[0].push_back(goal);
+    int pending = 1;
+    for (std::uint32_t cost = 0; pending > 0; cost++) {
+        std::vector<int>& bucket = buckets_[cost % BUCKET_COUNT];
+        // Relaxing only pushes into later buckets, so this one does not grow
+        for (std::size_t b = 0; b < bucket.size(); b++) {
+            int index = bucket[b];
+            pending--;
+            if (costs_[index] != cost) continue;   // Superseded by a cheaper push
+
+            int x = index % size_;
+            int y = index / size_;
+            for (int code = 0; code < 8; code++) {
+                if (!can_step(x, y, code)) continue;
+                int next = index + STEP_Y[code] * size_ + STEP_X[code];
+                std::uint32_t next_cost = cost + step_cost(index, next, code);
+                if (next_cost < costs_[next]) {
+                    costs_[next] = next_cost;
+                    buckets_[next_cost % BUCKET_COUNT].push_back(next);
+                    pending++;
+                }
+            }
+        }
+        bucket.clear();
+    }
+
+    // Each reached tile points at the neighbour its shortest path continues through
+    for (int y = 0; y < size_; y++) {
+        for (int x = 0; x < size_; x++) {
+            int index = y * size_ + x;
+            if (costs_[index] == UNREACHED) continue;
+            if (index == goal) {
+                directions_[index] = DIR_GOAL;
+                continue;
+            }
+
+            std::uint32_t best = UNREACHED;
+            for (int code : SEARCH_ORDER) {
+                if (!can_step(x, y, code)) continue;
+                int next = index + STEP_Y[code] * size_ + STEP_X[code];
+                std::uint32_t next_cost = costs_[next];
+                if (next_cost == UNREACHED) continue;
+                std::uint32_t via = next_cost + step_cost(index, next, code);
+                if (via < best) {
+                    best = via;
+                    directions_[index] = static_cast<std::uint8_t>(code);
+                }
+            }
+        }
+    }
+}
+
+} // namespace atoms
+} // namespace world
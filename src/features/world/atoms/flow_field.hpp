@@ -0,0 +1,75 @@
+/// flow_field.hpp — shared flow field toward a target tile atom for world slice
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+#include <vector>
+
+namespace world {
+namespace atoms {
+
+// Forward declarations
+class Tilemap;
+
+// Cheapest walkable paths from every tile in a square window around a target
+// tile to the target, stored as one packed direction per tile so any number of
+// followers sample it in O(1). Moves are 8-way (diagonals only between two open
+// orthogonal tiles) and cost straight_step_cost / diagonal_step_cost of the
+// tiles' move costs, so slow terrain is skirted; tiles outside the map are blocked. The field is rebuilt
+// when the target enters a new tile or an edit lands inside the window.
+class FlowField {
+public:
+    // Direction codes; 0-7 step to a neighbour, clockwise from east
+    static constexpr std::uint8_t DIR_GOAL = 8;      // The target tile
+    static constexpr std::uint8_t DIR_NONE = 255;    // Blocked, unreachable or outside the window
+
+    // radius_tiles: the window is (2 * radius + 1) tiles square, centred on the target
+    void init(const Tilemap* tilemap, int radius_tiles = 32);
+
+    // Move the target; rebuilds only when its tile changed or the field is dirty.
+    // Returns true if the field was rebuilt.
+    // PERF: one bucketed Dijkstra over the window (~4k tiles at radius 32) per rebuild
+    bool set_target(int tile_x, int tile_y);
+
+    // Direction code of a tile
+    // PERF: O(1), one byte read
+    std::uint8_t get_direction_code(int tile_x, int tile_y) const;
+
+    // Unit step (in tiles) for a direction code, {0, 0} for DIR_GOAL / DIR_NONE
+    static Vector2 step_of(std::uint8_t code);
+
+    // Path cost from a tile to the target (10 per straight step, 14 per
+    // diagonal on open ground), or -1 if the tile has no direction
+    int get_cost(int tile_x, int tile_y) const;
+
+    // Walkability changed in the inclusive range; marks the field dirty if it
+    // overlaps the window
+    void invalidate(int min_x, int min_y, int max_x, int max_y);
+
+    bool has_target() const { return has_target_; }
+    int get_target_x() const { return target_x_; }
+    int get_target_y() const { return target_y_; }
+
+private:
+    static constexpr std::uint32_t UNREACHED = 0xFFFFFFFFu;
+
+    const Tilemap* tilemap_ = nullptr;
+    int radius_ = 32;
+    int size_ = 65;                          // Window side, 2 * radius + 1
+    int origin_x_ = 0;                       // Window top-left tile
+    int origin_y_ = 0;
+    int target_x_ = 0;
+    int target_y_ = 0;
+    bool has_target_ = false;
+    bool dirty_ = true;
+
+    std::vector<std::uint8_t> directions_;   // size_ * size_ packed direction codes
+    std::vector<std::uint32_t> costs_;       // size_ * size_ integration field
+    std::vector<std::uint8_t> move_costs_;   // size_ * size_ tile move costs for the rebuild, 0 = blocked
+    std::vector<std::vector<int>> buckets_;  // Dial's bucket queue, indexed by cost % buckets
+
+    // Recompute the integration field and directions around the target
+    void rebuild();
+};
+
+} // namespace atoms
+} // namespace world
@@ -0,0 +1,129 @@
+/// fov_field.cpp — implementation of the field of view atom
+#include "fov_field.hpp"
+#include "tilemap.hpp"
+#include <algorithm>
+
+namespace world {
+namespace atoms {
+
+namespace {
+    // Octant transforms: window offset = (col * XX + row * XY, col * YX + row * YY)
+    constexpr int OCTANT_XX[8] = { 1, 0, 0, -1, -1, 0, 0, 1 };
+    constexpr int OCTANT_XY[8] = { 0, 1, -1, 0, 0, -1, 1, 0 };
+    constexpr int OCTANT_YX[8] = { 0, 1, 1, 0, 0, -1, -1, 0 };
+    constexpr int OCTANT_YY[8] = { 1, 0, 0, 1, -1, 0, 0, -1 };
+}
+
+void FovField::init(const Tilemap* tilemap, int radius_tiles) {
+    tilemap_ = tilemap;
+    radius_ = std::max(radius_tiles, 1);
+    size_ = radius_ * 2 + 1;
+    words_per_row_ = (size_ + 63) / 64;
+
+    visible_.assign(static_cast<std::size_t>(size_) * words_per_row_, 0);
+    opaque_.assign(static_cast<std::size_t>(size_) * size_, 0);
+    has_origin_ = false;
+    dirty_ = true;
+    recomputes_ = 0;
+}
+
+bool FovField::set_origin(int tile_x, int tile_y) {
+    if (!tilemap_) return false;
+    if (has_origin_ && !dirty_ && tile_x == origin_x_ && tile_y == origin_y_) {
+        return false;
+    }
+
+    origin_x_ = tile_x;
+    origin_y_ = tile_y;
+    has_origin_ = true;
+    recompute();
+    dirty_ = false;
+    return true;
+}
+
+bool FovField::is_visible(int tile_x, int tile_y) const {
+    if (!has_origin_) return false;
+    int local_x = tile_x - origin_x_ + radius_;
+    int local_y = tile_y - origin_y_ + radius_;
+    if (local_x < 0 || local_x >= size_ || local_y < 0 || local_y >= size_) {
+        return false;
+    }
+    return (visible_[local_y * words_per_row_ + (local_x >> 6)] >> (local_x & 63)) & 1u;
+}
+
+void FovField::invalidate(int min_x, int min_y, int max_x, int max_y) {
+    if (!has_origin_) return;
+    if (max_x < origin_x_ - radius_ || min_x > origin_x_ + radius_ ||
+        max_y < origin_y_ - radius_ || min_y > origin_y_ + radius_) {
+        return;
+    }
+    dirty_ = true;
+}
+
+void FovField::recompute() {
+    recomputes_++;
+    std::fill(visible_.begin(), visible_.end(), 0);
+
+    // Capture opacity once; the octants revisit their shared edges
+    for (int local_y = 0; local_y < size_; local_y++) {
+        for (int local_x = 0; local_x < size_; local_x++) {
+            opaque_[local_y * size_ + local_x] = tilemap_->blocks_sight(origin_x_ - radius_ + local_x,
+                                                                        origin_y_ - radius_ + local_y);
+        }
+    }
+
+    mark_visible(radius_, radius_);
+    for (int octant = 0; octant < 8; octant++) {
+        cast_light(1, 1.0f, 0.0f, OCTANT_XX[octant], OCTANT_XY[octant], OCTANT_YX[octant], OCTANT_YY[octant]);
+    }
+}
+
+void FovField::cast_light(int row, float start_slope, float end_slope, int xx, int xy, int yx, int yy) {
+    if (start_slope < end_slope) return;
+
+    // Rounder edge than radius^2: includes tiles whose centre is within radius + 0.5
+    const int range_sq = radius_ * radius_ + radius_;
+    float next_start = 0.0f;
+    for (int j = row; j <= radius_; j++) {
+        const int dy = -j;
+        bool blocked = false;
+        for (int dx = -j; dx <= 0; dx++) {
+            // Slopes through the tile's far corners
+            float left_slope = (dx - 0.5f) / (dy + 0.5f);
+            float right_slope = (dx + 0.5f) / (dy - 0.5f);
+            if (start_slope < right_slope) continue;
+            if (end_slope > left_slope) break;
+
+            int local_x = radius_ + dx * xx + dy * xy;
+            int local_y = radius_ + dx * yx + dy * yy;
+            if (dx * dx + dy * dy <= range_sq) {
+                mark_visible(local_x, local_y);
+            }
+
+            bool opaque = opaque_[local_y * size_ + local_x] != 0;
+            if (blocked) {
+                // Still in a run of opaque tiles: the shadow widens
+                if (opaque) {
+                    next_start = right_slope;
+                    continue;
+                }
+                blocked = false;
+                start_slope = next_start;
+            } else if (opaque && j < radius_) {
+                // First opaque tile of a run: the rows beyond it are lit up
+                // to its left edge by a nested scan
+                blocked = true;
+                cast_light(j + 1, start_slope, left_slope, xx, xy, yx, yy);
+                next_start = right_slope;
+            }
+        }
+        if (blocked) break;
+    }
+}
+
+void FovField::mark_visible(int local_x, int local_y) {
+    visible_[local_y * words_per_row_ + (local_x >> 6)] |= 1ull << (local_x & 63);
+}
+
+} // namespace atoms
+} // namespace world
@@ -0,0 +1,64 @@
+/// fov_field.hpp — field of view around an origin tile atom for world slice
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace world {
+namespace atoms {
+
+// Forward declarations
+class Tilemap;
+
+// Tiles visible from an origin tile (the player's), computed once with
+// recursive shadowcasting and stored as one bit per tile of a square window,
+// so every "can this enemy see the player" check is a single bit test.
+// Opaque objects (trees, bushes) cast shadows and are themselves visible;
+// visibility is limited to a circle of the given radius. The field is
+// recomputed when the origin enters a new tile or an edit lands inside the
+// window.
+class FovField {
+public:
+    // radius_tiles: sight range; the window is (2 * radius + 1) tiles square
+    void init(const Tilemap* tilemap, int radius_tiles = 16);
+
+    // Move the origin; recomputes only when its tile changed or the field is
+    // dirty. Returns true if the field was recomputed.
+    // PERF: one shadowcast over the window (~1k tiles at radius 16) per recompute
+    bool set_origin(int tile_x, int tile_y);
+
+    // True if the tile can be seen from the origin; false outside the range
+    // PERF: O(1), one bit test
+    bool is_visible(int tile_x, int tile_y) const;
+
+    // Opacity may have changed in the inclusive range; marks the field dirty
+    // if it overlaps the window
+    void invalidate(int min_x, int min_y, int max_x, int max_y);
+
+    bool has_origin() const { return has_origin_; }
+    int get_recompute_count() const { return recomputes_; }
+
+private:
+    const Tilemap* tilemap_ = nullptr;
+    int radius_ = 16;
+    int size_ = 33;                          // Window side, 2 * radius + 1
+    int words_per_row_ = 1;
+    int origin_x_ = 0;                       // Origin tile
+    int origin_y_ = 0;
+    bool has_origin_ = false;
+    bool dirty_ = true;
+    int recomputes_ = 0;
+
+    std::vector<std::uint64_t> visible_;     // size_ rows of words_per_row_ bit words
+    std::vector<std::uint8_t> opaque_;       // size_ * size_ opacity captured for the recompute
+
+    void recompute();
+
+    // Light one octant's rows from row outward between two slopes; xx..yy map
+    // octant (column, row) offsets to window offsets
+    void cast_light(int row, float start_slope, float end_slope, int xx, int xy, int yx, int yy);
+
+    void mark_visible(int local_x, int local_y);
+};
+
+} // namespace atoms
+} // namespace world
@@ -0,0 +1,250 @@
+/// map_file.cpp — implementation of the memory-mapped map file atom
+#include "map_file.hpp"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace world {
+namespace atoms {
+
+MapFile::~MapFile() {
+    close();
+}
+
+bool MapFile::open(const std::string& path) {
+    close();
+
+    if (!map_file(path)) {
+        return false;
+    }
+    if (!validate()) {
+        std::string reason = error_;
+        close();
+        error_ = reason;
+        return false;
+    }
+    return true;
+}
+
+void MapFile::close() {
+    unmap_file();
+    header_ = {};
+    directory_ = nullptr;
+    objects_ = nullptr;
+    chunks_x_ = 0;
+    chunks_y_ = 0;
+    error_.clear();
+}
+
+#ifdef _WIN32
+
+bool MapFile::map_file(const std::string& path) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        error_ = "cannot open " + path;
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        error_ = "empty or unreadable file " + path;
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        error_ = "cannot map " + path;
+        return false;
+    }
+
+    file_handle_ = file;
+    mapping_handle_ = mapping;
+    data_ = static_cast<const std::uint8_t*>(view);
+    size_ = static_cast<std::size_t>(size.QuadPart);
+    return true;
+}
+
+void MapFile::unmap_file() {
+    if (data_) UnmapViewOfFile(data_);
+    if (mapping_handle_) CloseHandle(mapping_handle_);
+    if (file_handle_) CloseHandle(file_handle_);
+    data_ = nullptr;
+    size_ = 0;
+    mapping_handle_ = nullptr;
+    file_handle_ = nullptr;
+}
+
+#else
+
+bool MapFile::map_file(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error_ = "cannot open " + path;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        error_ = "empty or unreadable file " + path;
+        return false;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        error_ = "cannot map " + path;
+        return false;
+    }
+
+    data_ = static_cast<const std::uint8_t*>(view);
+    size_ = static_cast<std::size_t>(info.st_size);
+    return true;
+}
+
+void MapFile::unmap_file() {
+    if (data_) {
+        munmap(const_cast<std::uint8_t*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+
+#endif
+
+bool MapFile::validate() {
+    if (size_ < sizeof(MapFileHeader)) {
+        error_ = "file too small for a map header";
+        return false;
+    }
+    std::memcpy(&header_, data_, sizeof(MapFileHeader));
+
+    if (std::memcmp(header_.magic, MAP_FILE_MAGIC, sizeof(MAP_FILE_MAGIC)) != 0) {
+        error_ = "not a .plmap file";
+        return false;
+    }
+    if (header_.version != MAP_FILE_VERSION) {
+        error_ = "unsupported map version " + std::to_string(header_.version);
+        return false;
+    }
+    if (header_.chunk_size != static_cast<std::uint32_t>(CHUNK_SIZE)) {
+        error_ = "map chunk size " + std::to_string(header_.chunk_size) + " does not match the engine";
+        return false;
+    }
+    if (header_.width == 0 || header_.height == 0 || header_.tile_size == 0 ||
+        header_.width > (1u << 24) || header_.height > (1u << 24)) {
+        error_ = "bad map dimensions";
+        return false;
+    }
+
+    // Directory and object layer must lie inside the file (and be aligned for direct access)
+    chunks_x_ = static_cast<int>((header_.width + CHUNK_SIZE - 1) >> CHUNK_SHIFT);
+    chunks_y_ = static_cast<int>((header_.height + CHUNK_SIZE - 1) >> CHUNK_SHIFT);
+    std::uint64_t chunk_count = static_cast<std::uint64_t>(chunks_x_) * chunks_y_;
+    std::uint64_t directory_end = header_.directory_offset + chunk_count * sizeof(MapChunkEntry);
+    std::uint64_t objects_end = header_.objects_offset +
+                                static_cast<std::uint64_t>(header_.object_count) * sizeof(MapObject);
+    if (header_.directory_offset % 4 != 0 || header_.objects_offset % 4 != 0 ||
+        directory_end > size_ || objects_end > size_) {
+        error_ = "chunk directory or object layer out of range";
+        return false;
+    }
+    directory_ = reinterpret_cast<const MapChunkEntry*>(data_ + header_.directory_offset);
+    objects_ = reinterpret_cast<const MapObject*>(data_ + header_.objects_offset);
+
+    // Validate every entry once so read_chunk never has to
+    for (std::uint64_t i = 0; i < chunk_count; i++) {
+        const MapChunkEntry& entry = directory_[i];
+        if (entry.tiles_offset != 0 &&
+            static_cast<std::uint64_t>(entry.tiles_offset) + CHUNK_AREA > size_) {
+            error_ = "chunk " + std::to_string(i) + " tile block out of range";
+            return false;
+        }
+        if (static_cast<std::uint64_t>(entry.first_object) + entry.object_count > header_.object_count) {
+            error_ = "chunk " + std::to_string(i) + " object range out of range";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void MapFile::read_chunk(int chunk_x, int chunk_y, TileType* out_tiles) const {
+    if (!data_ || chunk_x < 0 || chunk_x >= chunks_x_ || chunk_y < 0 || chunk_y >= chunks_y_) {
+        std::fill(out_tiles, out_tiles + CHUNK_AREA, TileType::NONE);
+        return;
+    }
+
+    // Tile layer: one byte per tile, straight out of the mapping
+    const MapChunkEntry& entry = directory_[chunk_y * chunks_x_ + chunk_x];
+    auto to_tile = [](std::uint8_t id) {
+        return id < TILE_TYPE_COUNT ? static_cast<TileType>(id) : TileType::NONE;
+    };
+    if (entry.tiles_offset == 0) {
+        std::fill(out_tiles, out_tiles + CHUNK_AREA, to_tile(entry.fill_tile));
+    } else {
+        const std::uint8_t* ids = data_ + entry.tiles_offset;
+        for (int i = 0; i < CHUNK_AREA; i++) {
+            out_tiles[i] = to_tile(ids[i]);
+        }
+    }
+
+    // Object layer: footprints can reach in from chunks up and to the left
+    int reach_x = (MAX_TILE_WIDTH + CHUNK_SIZE - 2) >> CHUNK_SHIFT;
+    int reach_y = (MAX_TILE_HEIGHT + CHUNK_SIZE - 2) >> CHUNK_SHIFT;
+    for (int cy = std::max(0, chunk_y - reach_y); cy <= chunk_y; cy++) {
+        for (int cx = std::max(0, chunk_x - reach_x); cx <= chunk_x; cx++) {
+            apply_objects(cx, cy, chunk_x, chunk_y, out_tiles);
+        }
+    }
+}
+
+void MapFile::apply_objects(int anchor_chunk_x, int anchor_chunk_y, int chunk_x, int chunk_y,
+                            TileType* out_tiles) const {
+    const MapChunkEntry& entry = directory_[anchor_chunk_y * chunks_x_ + anchor_chunk_x];
+    int base_x = chunk_x << CHUNK_SHIFT;
+    int base_y = chunk_y << CHUNK_SHIFT;
+
+    for (std::uint32_t i = 0; i < entry.object_count; i++) {
+        const MapObject& obj = objects_[entry.first_object + i];
+        if (obj.type >= TILE_TYPE_COUNT) continue;
+
+        // Same convention as Tilemap::set_tile: type at the anchor, NONE over the rest
+        TileType type = static_cast<TileType>(obj.type);
+        const TileProperties& props = tile_properties(type);
+        for (int dy = 0; dy < props.height_in_tiles; dy++) {
+            int ly = static_cast<int>(obj.y) + dy - base_y;
+            if (ly < 0 || ly >= CHUNK_SIZE) continue;
+            for (int dx = 0; dx < props.width_in_tiles; dx++) {
+                int lx = static_cast<int>(obj.x) + dx - base_x;
+                if (lx < 0 || lx >= CHUNK_SIZE) continue;
+                out_tiles[ly * CHUNK_SIZE + lx] = (dx == 0 && dy == 0) ? type : TileType::NONE;
+            }
+        }
+    }
+}
+
+ChunkSource MapFile::make_chunk_source() const {
+    return [this](int chunk_x, int chunk_y, TileType* out_tiles) {
+        read_chunk(chunk_x, chunk_y, out_tiles);
+    };
+}
+
+} // namespace atoms
+} // namespace world
@@ -0,0 +1,113 @@
+/// map_file.hpp — memory-mapped binary map format atom for world slice
+#pragma once
+#include "tile_types.hpp"
+#include "tile_chunk.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace world {
+namespace atoms {
+
+// Binary map file (.plmap), little-endian. Layout:
+//   MapFileHeader
+//   MapChunkEntry[chunks_x * chunks_y]   row-major chunk directory
+//   MapObject[object_count]              grouped by anchor chunk, in directory order
+//   tile blocks                          CHUNK_AREA uint8 tile IDs each, row-major;
+//                                        identical blocks may be shared between chunks
+// Objects (TREE, BUSH) live only in the object layer, never in tile blocks.
+// Written by tools/tiled_to_plmap.py; keep both in sync when bumping the version.
+
+constexpr char MAP_FILE_MAGIC[4] = { 'P', 'L', 'M', 'P' };
+constexpr std::uint16_t MAP_FILE_VERSION = 1;
+
+struct MapFileHeader {
+    char magic[4];                   // MAP_FILE_MAGIC
+    std::uint16_t version;           // MAP_FILE_VERSION
+    std::uint16_t tile_size;         // Pixels per tile
+    std::uint32_t width;             // Map size in tiles
+    std::uint32_t height;
+    std::uint32_t chunk_size;        // Must equal CHUNK_SIZE
+    std::uint32_t object_count;
+    std::uint32_t directory_offset;  // Byte offset of the chunk directory
+    std::uint32_t objects_offset;    // Byte offset of the object layer
+};
+
+struct MapChunkEntry {
+    std::uint32_t tiles_offset;      // Byte offset of the tile block, 0 = every tile is fill_tile
+    std::uint32_t first_object;      // Index of the first object anchored in this chunk
+    std::uint16_t object_count;      // Objects anchored in this chunk
+    std::uint8_t fill_tile;          // Tile ID used when tiles_offset is 0
+    std::uint8_t reserved;
+};
+
+struct MapObject {
+    std::uint32_t x;                 // Anchor (top-left) tile
+    std::uint32_t y;
+    std::uint8_t type;               // TileType ID
+    std::uint8_t reserved[3];
+};
+
+static_assert(sizeof(MapFileHeader) == 32, "MapFileHeader layout is part of the file format");
+static_assert(sizeof(MapChunkEntry) == 12, "MapChunkEntry layout is part of the file format");
+static_assert(sizeof(MapObject) == 12, "MapObject layout is part of the file format");
+
+// Read-only view of a .plmap file. The file is memory-mapped, so opening is
+// O(directory validation) and only the tile blocks of chunks that are read get
+// paged in by the OS.
+class MapFile {
+public:
+    MapFile() = default;
+    ~MapFile();
+    MapFile(const MapFile&) = delete;
+    MapFile& operator=(const MapFile&) = delete;
+
+    // Map and validate a file; on failure returns false and get_error() says why
+    bool open(const std::string& path);
+    void close();
+    bool is_open() const { return data_ != nullptr; }
+    const std::string& get_error() const { return error_; }
+
+    int get_width() const { return static_cast<int>(header_.width); }
+    int get_height() const { return static_cast<int>(header_.height); }
+    int get_tile_size() const { return header_.tile_size; }
+    int get_chunks_x() const { return chunks_x_; }
+    int get_chunks_y() const { return chunks_y_; }
+    int get_object_count() const { return static_cast<int>(header_.object_count); }
+
+    // Fill one chunk's tiles (CHUNK_AREA entries), objects included.
+    // Unknown tile IDs read as NONE. Safe to call from several threads.
+    void read_chunk(int chunk_x, int chunk_y, TileType* out_tiles) const;
+
+    // Chunk source for Tilemap::set_chunk_source; the MapFile must outlive it
+    ChunkSource make_chunk_source() const;
+
+private:
+    const std::uint8_t* data_ = nullptr;
+    std::size_t size_ = 0;
+    MapFileHeader header_ = {};
+    const MapChunkEntry* directory_ = nullptr;
+    const MapObject* objects_ = nullptr;
+    int chunks_x_ = 0;
+    int chunks_y_ = 0;
+    std::string error_;
+
+#ifdef _WIN32
+    void* file_handle_ = nullptr;
+    void* mapping_handle_ = nullptr;
+#endif
+
+    // Platform mapping, sets data_/size_
+    bool map_file(const std::string& path);
+    void unmap_file();
+
+    // Check header, directory and object ranges against the file size
+    bool validate();
+
+    // Stamp objects anchored in a (possibly neighbouring) chunk onto this chunk's tiles
+    void apply_objects(int anchor_chunk_x, int anchor_chunk_y, int chunk_x, int chunk_y,
+                       TileType* out_tiles) const;
+};
+
+} // namespace atoms
+} // namespace world
@@ -1,15 +1,23 @@
 /// obstacle_detector.cpp — Implementation of obstacle detection utility
 #include "obstacle_detector.hpp"
 #include "tilemap.hpp"
-#include "../../shared/math_utils.hpp"
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OBSTACLE_DETECTOR_SSE2 1
+#endif
 
 namespace world {
 namespace atoms {
 
 void ObstacleDetector::init(Tilemap* tilemap) {
     tilemap_ = tilemap;
+    distance_field_.init(tilemap);
 }
 
 RaycastHit ObstacleDetector::raycast(Vector2 origin, Vector2 direction, float max_distance) const {
@@ -17,12 +25,7 @@ RaycastHit ObstacleDetector::raycast(Vector2 origin, Vector2 direction, float ma
     
     if (!tilemap_) return result;
     
-    // Convert origin to tile coordinates
-    Vector2 tile_pos = tilemap_->world_to_tile(origin.x, origin.y);
-    int startTileX = static_cast<int>(tile_pos.x);
-    int startTileY = static_cast<int>(tile_pos.y);
-    
-    // Normalize direction for DDA algorithm
+    // Normalize direction so ray parameters are distances
     float len = std::sqrt(direction.x * direction.x + direction.y * direction.y);
     if (len > 0) {
         direction.x /= len;
@@ -31,69 +34,58 @@ RaycastHit ObstacleDetector::raycast(Vector2 origin, Vector2 direction, float ma
         return result; // Invalid direction
     }
     
-    // DDA algorithm for raycasting on a grid
-    float posX = origin.x;
-    float posY = origin.y;
+    // Amanatides-Woo traversal: visit every cell the ray crosses exactly once,
+    // in order, tracking the distance at which it crosses the next x and y grid line
+    const float tile_size = static_cast<float>(tilemap_->get_tile_size());
+    int tile_x = static_cast<int>(std::floor(origin.x / tile_size));
+    int tile_y = static_cast<int>(std::floor(origin.y / tile_size));
     
-    // Calculate step size for DDA
-    float stepSize = tilemap_->get_tile_size() * 0.5f; // Half tile size for better accuracy
+    int step_x = direction.x > 0 ? 1 : (direction.x < 0 ? -1 : 0);
+    int step_y = direction.y > 0 ? 1 : (direction.y < 0 ? -1 : 0);
     
-    for (float dist = 0; dist < max_distance; dist += stepSize) {
-        // Move along ray
-        posX += direction.x * stepSize;
-        posY += direction.y * stepSize;
-        
-        // Convert to tile coordinates
-        Vector2 current_tile = tilemap_->world_to_tile(posX, posY);
-        int tileX = static_cast<int>(current_tile.x);
-        int tileY = static_cast<int>(current_tile.y);
-        
-        // Check tile bounds
-        if (tileX < 0 || tileX >= tilemap_->get_width() || 
-            tileY < 0 || tileY >= tilemap_->get_height()) {
-            // Ray went out of bounds
-            result.hit = true;
-            result.distance = dist;
-            result.point = {posX, posY};
-            
-            // Calculate normal (always away from world bounds)
-            result.normal = {0, 0};
-            if (tileX < 0) result.normal.x = 1;
-            else if (tileX >= tilemap_->get_width()) result.normal.x = -1;
-            if (tileY < 0) result.normal.y = 1;
-            else if (tileY >= tilemap_->get_height()) result.normal.y = -1;
-            
-            break;
+    // Distance between successive grid lines along the ray, and to the first one
+    const float inf = std::numeric_limits<float>::infinity();
+    float delta_x = step_x != 0 ? tile_size / std::fabs(direction.x) : inf;
+    float delta_y = step_y != 0 ? tile_size / std::fabs(direction.y) : inf;
+    float next_x = step_x > 0 ? ((tile_x + 1) * tile_size - origin.x) / direction.x
+                 : step_x < 0 ? (tile_x * tile_size - origin.x) / direction.x : inf;
+    float next_y = step_y > 0 ? ((tile_y + 1) * tile_size - origin.y) / direction.y
+                 : step_y < 0 ? (tile_y * tile_size - origin.y) / direction.y : inf;
+    
+    // Starting inside an obstacle (or outside the map) hits immediately
+    if (is_obstacle(tile_x, tile_y)) {
+        result.hit = true;
+        result.distance = 0.0f;
+        result.point = origin;
+        result.normal = {-direction.x, -direction.y};
+        return result;
+    }
+    
+    while (true) {
+        // Cross the nearer grid line; on exact corner hits x goes first, so the
+        // ray cannot slip between two diagonally touching obstacles
+        float distance;
+        Vector2 normal;
+        if (next_x <= next_y) {
+            distance = next_x;
+            next_x += delta_x;
+            tile_x += step_x;
+            normal = {static_cast<float>(-step_x), 0.0f};
+        } else {
+            distance = next_y;
+            next_y += delta_y;
+            tile_y += step_y;
+            normal = {0.0f, static_cast<float>(-step_y)};
         }
         
-        // Check if current tile is an obstacle
-        if (!tilemap_->is_walkable(tileX, tileY)) {
+        if (distance > max_distance) break;
+        
+        // Map bounds count as walls, facing back into the map
+        if (is_obstacle(tile_x, tile_y)) {
             result.hit = true;
-            result.distance = dist;
-            result.point = {posX, posY};
-            
-            // Calculate normal based on which edge we hit
-            // Simple approximation - better normal calculation would require more complex logic
-            Vector2 tileCenterWorld = tilemap_->tile_to_world(tileX, tileY);
-            tileCenterWorld.x += tilemap_->get_tile_size() / 2.0f;
-            tileCenterWorld.y += tilemap_->get_tile_size() / 2.0f;
-            
-            // Calculate direction from tile center to hit point
-            Vector2 fromCenter = {
-                result.point.x - tileCenterWorld.x,
-                result.point.y - tileCenterWorld.y
-            };
-            
-            // Normalize to get normal
-            float normalLen = std::sqrt(fromCenter.x * fromCenter.x + fromCenter.y * fromCenter.y);
-            if (normalLen > 0) {
-                result.normal.x = fromCenter.x / normalLen;
-                result.normal.y = fromCenter.y / normalLen;
-            } else {
-                // Fallback if at exact center (unlikely)
-                result.normal = {-direction.x, -direction.y};
-            }
-            
+            result.distance = distance;
+            result.point = {origin.x + direction.x * distance, origin.y + direction.y * distance};
+            result.normal = normal;
             break;
         }
     }
@@ -101,43 +93,144 @@ RaycastHit ObstacleDetector::raycast(Vector2 origin, Vector2 direction, float ma
     return result;
 }
 
-bool ObstacleDetector::check_circle_overlap(Vector2 center, float radius) const {
-    if (!tilemap_) return false;
+void ObstacleDetector::raycast_batch(Vector2 origin, const Vector2* directions, int count,
+                                     float max_distance, float* out_distances) const {
+    if (!tilemap_ || !directions || !out_distances || count <= 0) return;
     
-    // Convert center to tile coordinates
-    Vector2 tile_pos = tilemap_->world_to_tile(center.x, center.y);
-    int centerTileX = static_cast<int>(tile_pos.x);
-    int centerTileY = static_cast<int>(tile_pos.y);
+    const float tile_size = static_cast<float>(tilemap_->get_tile_size());
+    const int origin_x = static_cast<int>(std::floor(origin.x / tile_size));
+    const int origin_y = static_cast<int>(std::floor(origin.y / tile_size));
     
-    // Calculate tile radius in grid cells (ceiling to ensure we check all overlapped tiles)
-    int tileRadius = static_cast<int>(std::ceil(radius / tilemap_->get_tile_size()));
+    // Every ray starts in the same tile
+    if (is_obstacle(origin_x, origin_y)) {
+        std::fill(out_distances, out_distances + count, 0.0f);
+        return;
+    }
     
-    // Check all tiles that might overlap with the circle
-    for (int y = centerTileY - tileRadius; y <= centerTileY + tileRadius; y++) {
-        for (int x = centerTileX - tileRadius; x <= centerTileX + tileRadius; x++) {
-            // Skip if out of bounds
-            if (x < 0 || x >= tilemap_->get_width() || y < 0 || y >= tilemap_->get_height())
-                continue;
+    // Walkability window covering every tile the fan can enter (plus a tile of
+    // slack each side), one word per row: at most 64 tiles across
+    bool fits = 2.0f * max_distance / tile_size + 3.0f < 64.0f;
+#ifndef OBSTACLE_DETECTOR_SSE2
+    fits = false;
+#endif
+    if (!fits) {
+        // Long rays (or no SSE2): trace one at a time
+        for (int i = 0; i < count; i++) {
+            RaycastHit hit = raycast(origin, directions[i], max_distance);
+            out_distances[i] = hit.hit ? hit.distance : max_distance;
+        }
+        return;
+    }
+    
+    const int min_x = static_cast<int>(std::floor((origin.x - max_distance) / tile_size)) - 1;
+    const int min_y = static_cast<int>(std::floor((origin.y - max_distance) / tile_size)) - 1;
+    const int max_x = static_cast<int>(std::floor((origin.x + max_distance) / tile_size)) + 1;
+    const int max_y = static_cast<int>(std::floor((origin.y + max_distance) / tile_size)) + 1;
+    
+    // Bit i of a row = tile min_x + i walkable; tiles outside the map are cleared
+    std::array<std::uint64_t, 64> rows;
+    std::uint64_t in_map = 0;
+    for (int x = std::max(min_x, 0); x <= std::min(max_x, tilemap_->get_width() - 1); x++) {
+        in_map |= 1ull << (x - min_x);
+    }
+    for (int y = min_y; y <= max_y; y++) {
+        bool row_in_map = y >= 0 && y < tilemap_->get_height();
+        rows[y - min_y] = row_in_map ? tilemap_->get_walkable_bits(min_x, y) & in_map : 0;
+    }
+    
+#ifdef OBSTACLE_DETECTOR_SSE2
+    const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 v_tile_size = _mm_set1_ps(tile_size);
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 v_max = _mm_set1_ps(max_distance);
+    
+    // Distance to the first grid line on either side of the origin, per axis
+    const __m128 to_right = _mm_set1_ps((origin_x + 1) * tile_size - origin.x);
+    const __m128 to_left = _mm_set1_ps(origin_x * tile_size - origin.x);
+    const __m128 to_down = _mm_set1_ps((origin_y + 1) * tile_size - origin.y);
+    const __m128 to_up = _mm_set1_ps(origin_y * tile_size - origin.y);
+    auto select = [](__m128 mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    };
+    
+    for (int first = 0; first < count; first += 4) {
+        // Load up to four directions; missing lanes are zero-length
+        alignas(16) float dir_x[4] = {}, dir_y[4] = {};
+        for (int lane = 0; lane < 4 && first + lane < count; lane++) {
+            dir_x[lane] = directions[first + lane].x;
+            dir_y[lane] = directions[first + lane].y;
+        }
+        __m128 dx = _mm_load_ps(dir_x);
+        __m128 dy = _mm_load_ps(dir_y);
+        
+        // Per-lane DDA setup, the same IEEE operations as raycast so results match
+        __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        __m128 valid = _mm_cmpgt_ps(len, zero);
+        dx = _mm_and_ps(valid, _mm_div_ps(dx, len));
+        dy = _mm_and_ps(valid, _mm_div_ps(dy, len));
+        
+        __m128 pos_x = _mm_cmpgt_ps(dx, zero), neg_x = _mm_cmplt_ps(dx, zero);
+        __m128 pos_y = _mm_cmpgt_ps(dy, zero), neg_y = _mm_cmplt_ps(dy, zero);
+        __m128 move_x = _mm_or_ps(pos_x, neg_x);
+        __m128 move_y = _mm_or_ps(pos_y, neg_y);
+        
+        // Masks are all ones (-1) when set, so step = neg - pos
+        const __m128i v_step_x = _mm_sub_epi32(_mm_castps_si128(neg_x), _mm_castps_si128(pos_x));
+        const __m128i v_step_y = _mm_sub_epi32(_mm_castps_si128(neg_y), _mm_castps_si128(pos_y));
+        const __m128 v_delta_x = select(move_x, _mm_div_ps(v_tile_size, _mm_and_ps(dx, abs_mask)), inf);
+        const __m128 v_delta_y = select(move_y, _mm_div_ps(v_tile_size, _mm_and_ps(dy, abs_mask)), inf);
+        __m128 v_next_x = select(move_x, _mm_div_ps(select(pos_x, to_right, to_left), dx), inf);
+        __m128 v_next_y = select(move_y, _mm_div_ps(select(pos_y, to_down, to_up), dy), inf);
+        
+        // Zero-length (and padding) lanes start done
+        int live = _mm_movemask_ps(valid);
+        for (int lane = 0; lane < 4 && first + lane < count; lane++) {
+            if (!((live >> lane) & 1)) out_distances[first + lane] = max_distance;
+        }
+        
+        __m128i v_tile_x = _mm_set1_epi32(origin_x - min_x);   // Window-relative tiles
+        __m128i v_tile_y = _mm_set1_epi32(origin_y - min_y);
+        
+        alignas(16) float distance[4];
+        alignas(16) std::int32_t tile_x[4], tile_y[4];
+        while (live) {
+            // All lanes cross their nearer grid line at once (x first on ties)
+            __m128 take_x = _mm_cmple_ps(v_next_x, v_next_y);
+            __m128 v_distance = select(take_x, v_next_x, v_next_y);
+            v_next_x = _mm_add_ps(v_next_x, _mm_and_ps(take_x, v_delta_x));
+            v_next_y = _mm_add_ps(v_next_y, _mm_andnot_ps(take_x, v_delta_y));
+            __m128i take_x_bits = _mm_castps_si128(take_x);
+            v_tile_x = _mm_add_epi32(v_tile_x, _mm_and_si128(take_x_bits, v_step_x));
+            v_tile_y = _mm_add_epi32(v_tile_y, _mm_andnot_si128(take_x_bits, v_step_y));
+            int past_max = _mm_movemask_ps(_mm_cmpgt_ps(v_distance, v_max));
             
-            if (!tilemap_->is_walkable(x, y)) {
-                // Calculate tile center in world space
-                Vector2 tileCenter = tilemap_->tile_to_world(x, y);
-                tileCenter.x += tilemap_->get_tile_size() / 2.0f;
-                tileCenter.y += tilemap_->get_tile_size() / 2.0f;
-                
-                // Calculate distance from circle center to tile center
-                float dist = shared::math::distance(center, tileCenter);
-                
-                // Check if circle overlaps with tile
-                // This is an approximation - assumes square tiles are circles for simplicity
-                if (dist < radius + tilemap_->get_tile_size() / 2.0f) {
-                    return true;
+            _mm_store_ps(distance, v_distance);
+            _mm_store_si128(reinterpret_cast<__m128i*>(tile_x), v_tile_x);
+            _mm_store_si128(reinterpret_cast<__m128i*>(tile_y), v_tile_y);
+            
+            // Lanes past max_distance miss; the rest test their tile against the window
+            for (int lane = 0; lane < 4; lane++) {
+                int bit = 1 << lane;
+                if (!(live & bit)) continue;
+                if (past_max & bit) {
+                    out_distances[first + lane] = max_distance;
+                    live &= ~bit;
+                } else if (!((rows[tile_y[lane]] >> tile_x[lane]) & 1u)) {
+                    out_distances[first + lane] = distance[lane];
+                    live &= ~bit;
                 }
             }
         }
     }
+#endif
+}
+
+bool ObstacleDetector::check_circle_overlap(Vector2 center, float radius) const {
+    if (!tilemap_) return false;
     
-    return false;
+    // Overlapping means some blocked tile is closer than the radius
+    return distance_field_.get_clearance(center, radius) < radius;
 }
 
 bool ObstacleDetector::check_rect_overlap(Rectangle rect) const {
@@ -152,79 +245,34 @@ bool ObstacleDetector::check_rect_overlap(Rectangle rect) const {
     int maxTileX = static_cast<int>(bottomRight.x);
     int maxTileY = static_cast<int>(bottomRight.y);
     
-    // Check all tiles that might overlap with the rectangle
-    for (int y = minTileY; y <= maxTileY; y++) {
-        for (int x = minTileX; x <= maxTileX; x++) {
-            // Skip if out of bounds
-            if (x < 0 || x >= tilemap_->get_width() || y < 0 || y >= tilemap_->get_height())
-                continue;
-            
-            if (!tilemap_->is_walkable(x, y)) {
-                return true;
-            }
-        }
-    }
-    
-    return false;
+    // Check all tiles that might overlap with the rectangle, a bitmap word at a time
+    // (out-of-bounds tiles read as walkable, so they are skipped as before)
+    return !tilemap_->is_rect_walkable(minTileX, minTileY, maxTileX, maxTileY);
 }
 
 float ObstacleDetector::get_nearest_obstacle(Vector2 point, float max_radius) const {
     if (!tilemap_) return max_radius;
-    
-    // Convert point to tile coordinates
-    Vector2 tile_pos = tilemap_->world_to_tile(point.x, point.y);
-    int centerTileX = static_cast<int>(tile_pos.x);
-    int centerTileY = static_cast<int>(tile_pos.y);
-    
-    // Calculate search radius in tiles
-    int tileRadius = static_cast<int>(std::ceil(max_radius / tilemap_->get_tile_size()));
-    
-    float min_distance = max_radius;
-    
-    // Check all tiles in search radius
-    for (int y = centerTileY - tileRadius; y <= centerTileY + tileRadius; y++) {
-        for (int x = centerTileX - tileRadius; x <= centerTileX + tileRadius; x++) {
-            // Skip if out of bounds
-            if (x < 0 || x >= tilemap_->get_width() || y < 0 || y >= tilemap_->get_height())
-                continue;
-            
-            if (!tilemap_->is_walkable(x, y)) {
-                // Calculate tile center
-                Vector2 tile_center = tilemap_->tile_to_world(x, y);
-                tile_center.x += tilemap_->get_tile_size() / 2.0f;
-                tile_center.y += tilemap_->get_tile_size() / 2.0f;
-                
-                // Calculate distance to tile (simplified to distance to center)
-                float dist = shared::math::distance(point, tile_center);
-                
-                // Account for tile size (approximate edge distance)
-                dist -= tilemap_->get_tile_size() / 2.0f;
-                
-                // Update minimum distance
-                min_distance = std::min(min_distance, dist);
-            }
-        }
-    }
-    
-    return min_distance;
+    return distance_field_.get_clearance(point, max_radius);
+}
+
+void ObstacleDetector::on_tiles_changed(int min_x, int min_y, int max_x, int max_y) {
+    distance_field_.update(min_x, min_y, max_x, max_y);
 }
 
 void ObstacleDetector::create_steering_grid(Vector2 center, float* out_distances, int num_rays, float max_distance) const {
     if (!tilemap_ || !out_distances) return;
     
-    // Calculate rays in all directions
+    // Calculate rays in all directions, traced together a fan of up to 64 at a time
     const float angle_step = 2.0f * PI / num_rays;
+    std::array<Vector2, 64> directions;
     
-    for (int i = 0; i < num_rays; i++) {
-        float angle = i * angle_step;
-        Vector2 direction = {
-            std::cos(angle),
-            std::sin(angle)
-        };
-        
-        // Cast ray and store distance
-        RaycastHit hit = raycast(center, direction, max_distance);
-        out_distances[i] = hit.hit ? hit.distance : max_distance;
+    for (int first = 0; first < num_rays; first += static_cast<int>(directions.size())) {
+        int count = std::min(num_rays - first, static_cast<int>(directions.size()));
+        for (int i = 0; i < count; i++) {
+            float angle = (first + i) * angle_step;
+            directions[i] = { std::cos(angle), std::sin(angle) };
+        }
+        raycast_batch(center, directions.data(), count, max_distance, out_distances + first);
     }
 }
 
@@ -3,6 +3,7 @@
 #include <raylib.h>
 #include <vector>
 #include <memory>
+#include "distance_field.hpp"
 
 namespace world {
 namespace atoms {
@@ -24,12 +25,23 @@ public:
     /// Initialize the detector with a reference to the world's tilemap
     void init(Tilemap* tilemap);
     
-    /// Cast a ray from origin in the specified direction, returns hit information
-    /// PERF: ~0.02-0.05ms per call
+    /// Cast a ray from origin in the specified direction, returns hit information.
+    /// Distance is exact to the entry face of the first blocked tile (map bounds
+    /// count as blocked) and the normal is that face's axis normal.
+    /// PERF: O(tiles crossed), one walkability bit test per tile
     RaycastHit raycast(Vector2 origin, Vector2 direction, float max_distance = 1000.0f) const;
     
-    /// Check if a circle overlaps with any obstacles
-    /// PERF: ~0.05-0.1ms per call
+    /// Cast count rays from one origin (steering fans of 4/8/16 rays) and write
+    /// each ray's hit distance, or max_distance on a miss, to out_distances.
+    /// Same results as raycast; rays advance four at a time in SIMD lanes over
+    /// a walkability window fetched once for the whole fan.
+    /// PERF: one bitmap word per window row, then a bit test per tile crossed
+    void raycast_batch(Vector2 origin, const Vector2* directions, int count,
+                       float max_distance, float* out_distances) const;
+    
+    /// Check if a circle overlaps with any obstacles (tiles as exact squares;
+    /// tiles outside the map are open)
+    /// PERF: O(1) distance field lookup
     bool check_circle_overlap(Vector2 center, float radius) const;
     
     /// Check if a rectangle overlaps with any obstacles
@@ -37,10 +49,13 @@ public:
     bool check_rect_overlap(Rectangle rect) const;
     
     /// Get nearest obstacle from a point within a certain radius
-    /// Returns the distance to the nearest obstacle, or max_radius if none found
-    /// PERF: ~0.1-0.2ms per call
+    /// Returns the distance to the nearest obstacle tile's edge, or max_radius if none found
+    /// PERF: O(1) distance field lookup
     float get_nearest_obstacle(Vector2 point, float max_radius = 100.0f) const;
     
+    /// Walkability changed in the inclusive tile range (Tilemap tiles-changed callback)
+    void on_tiles_changed(int min_x, int min_y, int max_x, int max_y);
+    
     /// Create a navigation steering grid around a point
     /// Fills out_distances with distances to obstacles in each direction
     /// Uses specified number of rays spreading evenly in a circle
@@ -53,6 +68,7 @@ public:
 private:
     Tilemap* tilemap_ = nullptr;
     mutable bool show_debug_ = false;
+    mutable DistanceField distance_field_;   // Pages are built lazily by const queries
     
     /// Internal helper to check if a tile is an obstacle
     bool is_obstacle(int tile_x, int tile_y) const;
@@ -0,0 +1,271 @@
+/// path_search.cpp — implementation of the grid path search atom
+#include "path_search.hpp"
+#include "tilemap.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+
+namespace world {
+namespace atoms {
+
+namespace {
+    constexpr std::uint32_t STRAIGHT_COST = 10;
+    constexpr std::uint32_t DIAGONAL_COST = 14;
+    constexpr std::uint32_t NO_COST = std::numeric_limits<std::uint32_t>::max();
+
+    int sign(int v) { return (v > 0) - (v < 0); }
+}
+
+void PathGrid::capture(const Tilemap& tilemap, int min_x, int min_y, int max_x, int max_y) {
+    min_x = std::max(min_x, 0);
+    min_y = std::max(min_y, 0);
+    max_x = std::min(max_x, tilemap.get_width() - 1);
+    max_y = std::min(max_y, tilemap.get_height() - 1);
+
+    origin_x = min_x;
+    origin_y = min_y;
+    width = std::max(max_x - min_x + 1, 0);
+    height = std::max(max_y - min_y + 1, 0);
+    words_per_row = (width + 63) / 64;
+    bits.assign(static_cast<std::size_t>(words_per_row) * height, 0);
+    costs.resize(static_cast<std::size_t>(width) * height);
+
+    // Bits past the right edge stay clear, so the window's border is a wall
+    int tail = width & 63;
+    std::uint64_t tail_mask = tail ? (std::uint64_t(1) << tail) - 1 : ~std::uint64_t(0);
+    for (int y = 0; y < height; y++) {
+        for (int word = 0; word < words_per_row; word++) {
+            std::uint64_t row_bits = tilemap.get_walkable_bits(origin_x + word * 64, origin_y + y);
+            if (word == words_per_row - 1) row_bits &= tail_mask;
+            bits[y * words_per_row + word] = row_bits;
+        }
+        tilemap.get_move_costs(origin_x, origin_y + y, width, costs.data() + static_cast<std::size_t>(y) * width);
+    }
+    uniform = std::all_of(costs.begin(), costs.end(), [](std::uint8_t cost) {
+        return cost == 0 || cost == MOVE_COST_BASE;
+    });
+}
+
+int PathSearch::octile_cost(TilePoint a, TilePoint b) {
+    int dx = std::abs(a.x - b.x);
+    int dy = std::abs(a.y - b.y);
+    return static_cast<int>(STRAIGHT_COST) * std::abs(dx - dy) + static_cast<int>(DIAGONAL_COST) * std::min(dx, dy);
+}
+
+int PathSearch::path_cost(const PathGrid& grid, const std::vector<TilePoint>& waypoints) {
+    int total = 0;
+    for (std::size_t i = 1; i < waypoints.size(); i++) {
+        // Walk the run one tile at a time
+        int dx = sign(waypoints[i].x - waypoints[i - 1].x);
+        int dy = sign(waypoints[i].y - waypoints[i - 1].y);
+        for (TilePoint at = waypoints[i - 1]; at != waypoints[i];) {
+            TilePoint next = { at.x + dx, at.y + dy };
+            std::uint8_t from = grid.cost_at((at.y - grid.origin_y) * grid.width + (at.x - grid.origin_x));
+            std::uint8_t to = grid.cost_at((next.y - grid.origin_y) * grid.width + (next.x - grid.origin_x));
+            total += static_cast<int>(dx != 0 && dy != 0 ? diagonal_step_cost(from, to) : straight_step_cost(from, to));
+            at = next;
+        }
+    }
+    return total;
+}
+
+bool PathSearch::find_path(const PathGrid& grid, TilePoint start, TilePoint goal, std::vector<TilePoint>& out_waypoints) {
+    out_waypoints.clear();
+    expanded_ = 0;
+
+    const int width = grid.width;
+    const int sx = start.x - grid.origin_x;
+    const int sy = start.y - grid.origin_y;
+    const int gx = goal.x - grid.origin_x;
+    const int gy = goal.y - grid.origin_y;
+    if (sx < 0 || sx >= width || sy < 0 || sy >= grid.height) return false;
+    if (!grid.is_open(gx, gy)) return false;
+    if (start == goal) {
+        out_waypoints.push_back(start);
+        return true;
+    }
+
+    // Lazily reset scratch: a tile's entries are stale unless stamped this search
+    std::size_t area = static_cast<std::size_t>(width) * grid.height;
+    if (stamp_.size() < area) {
+        stamp_.resize(area, 0);
+        cost_.resize(area);
+        parent_.resize(area);
+        closed_.resize(area);
+    }
+    if (++search_ == 0) {
+        std::fill(stamp_.begin(), stamp_.end(), 0);
+        search_ = 1;
+    }
+    open_.clear();
+
+    const int goal_index = gy * width + gx;
+    push(sy * width + sx, NO_NODE, 0, width, gx, gy);
+
+    while (!open_.empty()) {
+        std::pop_heap(open_.begin(), open_.end(), std::greater<>());
+        int index = open_.back().second;
+        open_.pop_back();
+        if (closed_[index]) continue;
+        closed_[index] = 1;
+        expanded_++;
+
+        if (index == goal_index) {
+            for (int node = index; node != NO_NODE; node = parent_[node]) {
+                TilePoint tile = { grid.origin_x + node % width, grid.origin_y + node / width };
+                // Plain A* links every tile: keep only the turns
+                std::size_t n = out_waypoints.size();
+                if (!grid.uniform && n >= 2 && tile.x - out_waypoints[n - 1].x == out_waypoints[n - 1].x - out_waypoints[n - 2].x &&
+                    tile.y - out_waypoints[n - 1].y == out_waypoints[n - 1].y - out_waypoints[n - 2].y) {
+                    out_waypoints.back() = tile;
+                } else {
+                    out_waypoints.push_back(tile);
+                }
+            }
+            std::reverse(out_waypoints.begin(), out_waypoints.end());
+            return true;
+        }
+
+        const int x = index % width;
+        const int y = index / width;
+        auto open = [&grid](int ox, int oy) { return grid.is_open(ox, oy); };
+
+        // Slow terrain breaks the jump rules, which assume every step costs
+        // the same: relax all eight neighbours with their step costs instead
+        if (!grid.uniform) {
+            const std::uint8_t here = grid.cost_at(index);
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    if ((dx == 0 && dy == 0) || !open(x + dx, y + dy)) continue;
+                    bool diagonal = dx != 0 && dy != 0;
+                    if (diagonal && !(open(x + dx, y) && open(x, y + dy))) continue;
+                    int next = index + dy * width + dx;
+                    std::uint8_t there = grid.costs[next];
+                    std::uint32_t step = diagonal ? diagonal_step_cost(here, there) : straight_step_cost(here, there);
+                    push(next, index, cost_[index] + step, width, gx, gy);
+                }
+            }
+            continue;
+        }
+
+        // Directions worth scanning: all of them from the start, otherwise
+        // only those the move into this tile does not already cover
+        int dirs[8][2];
+        int count = 0;
+        auto add = [&dirs, &count](int dx, int dy) {
+            dirs[count][0] = dx;
+            dirs[count][1] = dy;
+            count++;
+        };
+        const int parent = parent_[index];
+        if (parent == NO_NODE) {
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    if (dx == 0 && dy == 0) continue;
+                    if (dx != 0 && dy != 0 && !(open(x + dx, y) && open(x, y + dy))) continue;
+                    add(dx, dy);
+                }
+            }
+        } else {
+            const int dx = sign(x - parent % width);
+            const int dy = sign(y - parent / width);
+            if (dx != 0 && dy != 0) {
+                bool side_x = open(x + dx, y);
+                bool side_y = open(x, y + dy);
+                if (side_x) add(dx, 0);
+                if (side_y) add(0, dy);
+                if (side_x && side_y) add(dx, dy);
+            } else if (dx != 0) {
+                bool ahead = open(x + dx, y);
+                bool up = open(x, y - 1);
+                bool down = open(x, y + 1);
+                if (ahead) {
+                    add(dx, 0);
+                    if (up) add(dx, -1);
+                    if (down) add(dx, 1);
+                }
+                if (up) add(0, -1);
+                if (down) add(0, 1);
+            } else {
+                bool ahead = open(x, y + dy);
+                bool left = open(x - 1, y);
+                bool right = open(x + 1, y);
+                if (ahead) {
+                    add(0, dy);
+                    if (left) add(-1, dy);
+                    if (right) add(1, dy);
+                }
+                if (left) add(-1, 0);
+                if (right) add(1, 0);
+            }
+        }
+
+        for (int i = 0; i < count; i++) {
+            int next = jump(grid, x, y, dirs[i][0], dirs[i][1], gx, gy);
+            if (next == NO_NODE) continue;
+            TilePoint from = { x, y };
+            TilePoint to = { next % width, next / width };
+            push(next, index, cost_[index] + static_cast<std::uint32_t>(octile_cost(from, to)), width, gx, gy);
+        }
+    }
+    return false;
+}
+
+int PathSearch::jump(const PathGrid& grid, int x, int y, int dx, int dy, int goal_x, int goal_y) const {
+    if (dx == 0 || dy == 0) return jump_straight(grid, x, y, dx, dy, goal_x, goal_y);
+
+    // Diagonal run: stop wherever a straight scan off it finds a jump point.
+    // The caller checked the corner of the first step, later steps check their own.
+    while (true) {
+        x += dx;
+        y += dy;
+        if (!grid.is_open(x, y)) return NO_NODE;
+        if (x == goal_x && y == goal_y) return y * grid.width + x;
+        if (jump_straight(grid, x, y, dx, 0, goal_x, goal_y) != NO_NODE ||
+            jump_straight(grid, x, y, 0, dy, goal_x, goal_y) != NO_NODE) {
+            return y * grid.width + x;
+        }
+        if (!(grid.is_open(x + dx, y) && grid.is_open(x, y + dy))) return NO_NODE;
+    }
+}
+
+int PathSearch::jump_straight(const PathGrid& grid, int x, int y, int dx, int dy, int goal_x, int goal_y) const {
+    // A tile is a jump point when a side neighbour opens up that could not be
+    // reached by a diagonal from the tile behind it (that corner is blocked)
+    while (true) {
+        x += dx;
+        y += dy;
+        if (!grid.is_open(x, y)) return NO_NODE;
+        if (x == goal_x && y == goal_y) return y * grid.width + x;
+        if (dx != 0) {
+            if ((grid.is_open(x, y - 1) && !grid.is_open(x - dx, y - 1)) ||
+                (grid.is_open(x, y + 1) && !grid.is_open(x - dx, y + 1))) {
+                return y * grid.width + x;
+            }
+        } else {
+            if ((grid.is_open(x - 1, y) && !grid.is_open(x - 1, y - dy)) ||
+                (grid.is_open(x + 1, y) && !grid.is_open(x + 1, y - dy))) {
+                return y * grid.width + x;
+            }
+        }
+    }
+}
+
+void PathSearch::push(int index, int parent, std::uint32_t cost, int width, int goal_x, int goal_y) {
+    if (stamp_[index] != search_) {
+        stamp_[index] = search_;
+        cost_[index] = NO_COST;
+        closed_[index] = 0;
+    }
+    if (closed_[index] || cost >= cost_[index]) return;
+
+    cost_[index] = cost;
+    parent_[index] = parent;
+    std::uint32_t estimate = static_cast<std::uint32_t>(octile_cost({ index % width, index / width }, { goal_x, goal_y }));
+    open_.emplace_back(cost + estimate, index);
+    std::push_heap(open_.begin(), open_.end(), std::greater<>());
+}
+
+} // namespace atoms
+} // namespace world
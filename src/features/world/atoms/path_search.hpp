@@ -0,0 +1,103 @@
+/// path_search.hpp — grid path search (A* with jump point search) atom for world slice
+#pragma once
+#include "tile_types.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace world {
+namespace atoms {
+
+// Forward declarations
+class Tilemap;
+
+struct TilePoint {
+    int x = 0;
+    int y = 0;
+
+    bool operator==(const TilePoint& other) const { return x == other.x && y == other.y; }
+    bool operator!=(const TilePoint& other) const { return !(*this == other); }
+};
+
+// Walkability (one bit per tile) and move costs of a rectangle of tiles
+// copied out of the tilemap. Tilemap queries page chunks in, so searches off
+// the main thread run on a snapshot instead. Tiles outside the rectangle are
+// blocked.
+struct PathGrid {
+    int origin_x = 0;                  // Top-left tile of the window
+    int origin_y = 0;
+    int width = 0;
+    int height = 0;
+    int words_per_row = 0;
+    std::vector<std::uint64_t> bits;   // Row-major, bit i of a word = tile word * 64 + i
+    std::vector<std::uint8_t> costs;   // Row-major move costs, 0 = blocked
+    bool uniform = true;               // Every open tile costs MOVE_COST_BASE
+
+    // Copy the inclusive tile range, clamped to the map
+    // PERF: one get_walkable_bits call per 64 tiles and one cost row copy per row
+    void capture(const Tilemap& tilemap, int min_x, int min_y, int max_x, int max_y);
+
+    // Window-local coordinates
+    bool is_open(int local_x, int local_y) const {
+        if (local_x < 0 || local_x >= width || local_y < 0 || local_y >= height) return false;
+        return (bits[local_y * words_per_row + (local_x >> 6)] >> (local_x & 63)) & 1;
+    }
+
+    // Move cost of an in-window tile, MOVE_COST_BASE for a blocked one
+    // (searches only read it for open tiles and for the start)
+    std::uint8_t cost_at(int local_index) const {
+        std::uint8_t cost = costs[local_index];
+        return cost != 0 ? cost : MOVE_COST_BASE;
+    }
+};
+
+// A* over a PathGrid with jump point search: on uniform-cost ground only the
+// tiles where a shortest path can turn are pushed on the open list, straight
+// and diagonal runs between them are scanned. Windows holding slow terrain
+// fall back to plain A* over the move costs (step costs as
+// straight_step_cost / diagonal_step_cost). Moves are 8-way and diagonals
+// never cut a blocked corner (as in FlowField). Holds scratch buffers reused
+// between searches, so keep one per thread.
+class PathSearch {
+public:
+    // Find a cheapest path in tile coordinates. out_waypoints receives the
+    // start, every turn and the goal; consecutive waypoints are joined by a
+    // straight or 45-degree run of open tiles. The start tile counts as open.
+    // PERF: visits only jump points; ~0.05-0.5ms on a 128x128 window of open
+    // ground, several times that with slow terrain in the window
+    bool find_path(const PathGrid& grid, TilePoint start, TilePoint goal, std::vector<TilePoint>& out_waypoints);
+
+    // Nodes expanded by the last search
+    int get_expanded_count() const { return expanded_; }
+
+    // Path cost between two tiles on open ground: 10 per straight step, 14 per diagonal
+    static int octile_cost(TilePoint a, TilePoint b);
+
+    // Cost of a waypoint list along the grid's move costs
+    static int path_cost(const PathGrid& grid, const std::vector<TilePoint>& waypoints);
+
+private:
+    static constexpr int NO_NODE = -1;
+
+    // Per-tile scratch, valid only where stamp_ == search_
+    std::vector<std::uint32_t> stamp_;
+    std::vector<std::uint32_t> cost_;
+    std::vector<int> parent_;
+    std::vector<std::uint8_t> closed_;
+    std::uint32_t search_ = 0;
+
+    // Open list as a binary min-heap of (estimated total cost, tile index)
+    std::vector<std::pair<std::uint32_t, int>> open_;
+    int expanded_ = 0;
+
+    // Scan from (x, y) one step at a time along (dx, dy); returns the first
+    // jump point's tile index, or NO_NODE if the run ends at a wall
+    int jump(const PathGrid& grid, int x, int y, int dx, int dy, int goal_x, int goal_y) const;
+    int jump_straight(const PathGrid& grid, int x, int y, int dx, int dy, int goal_x, int goal_y) const;
+
+    // Relax one successor
+    void push(int index, int parent, std::uint32_t cost, int width, int goal_x, int goal_y);
+};
+
+} // namespace atoms
+} // namespace world
@@ -0,0 +1,227 @@
+/// path_service.cpp — implementation of the asynchronous pathfinding service atom
+#include "path_service.hpp"
+#include "tilemap.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace world {
+namespace atoms {
+
+PathService::~PathService() {
+    stop();
+}
+
+void PathService::start(const Tilemap* tilemap, int worker_count, std::size_t cache_size) {
+    stop();
+    tilemap_ = tilemap;
+    cache_size_ = cache_size;
+    started_ = tilemap != nullptr;
+
+    if (worker_count < 0) {
+        worker_count = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    }
+    stopping_ = false;
+    for (int i = 0; started_ && i < worker_count; i++) {
+        workers_.emplace_back(&PathService::worker_loop, this);
+    }
+}
+
+void PathService::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+    queue_.clear();
+    requests_.clear();
+    finished_order_.clear();
+    cache_.clear();
+    cache_index_.clear();
+    cache_hits_ = 0;
+    started_ = false;
+}
+
+std::size_t PathService::KeyHash::operator()(const Key& key) const {
+    std::uint64_t h = static_cast<std::uint32_t>(key.start.x);
+    h = h * 0x9E3779B97F4A7C15ull ^ static_cast<std::uint32_t>(key.start.y);
+    h = h * 0x9E3779B97F4A7C15ull ^ static_cast<std::uint32_t>(key.goal.x);
+    h = h * 0x9E3779B97F4A7C15ull ^ static_cast<std::uint32_t>(key.goal.y);
+    return static_cast<std::size_t>(h ^ (h >> 29));
+}
+
+PathHandle PathService::request(TilePoint start, TilePoint goal) {
+    if (!started_) return 0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    PathHandle handle = next_handle_++;
+    if (next_handle_ == 0) next_handle_ = 1;
+
+    Request& request = requests_[handle];
+    request.key = { start, goal };
+
+    // Recent pairs are answered from the cache
+    auto cached = cache_index_.find(request.key);
+    if (cached != cache_index_.end()) {
+        cache_.splice(cache_.begin(), cache_, cached->second);
+        const CacheEntry& entry = *cached->second;
+        request.window = entry.window;
+        request.status = entry.found ? PathStatus::FOUND : PathStatus::NOT_FOUND;
+        request.waypoints = entry.waypoints;
+        finished_order_.push_back(handle);
+        cache_hits_++;
+        return handle;
+    }
+
+    if (!window_for(request.key, request.window)) {
+        request.status = PathStatus::NOT_FOUND;
+        finished_order_.push_back(handle);
+        return handle;
+    }
+    enqueue(handle, request);
+    return handle;
+}
+
+PathStatus PathService::poll(PathHandle handle, std::vector<TilePoint>* out_waypoints) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = requests_.find(handle);
+    if (found == requests_.end()) return PathStatus::NONE;
+
+    PathStatus status = found->second.status;
+    if (status == PathStatus::PENDING) return status;
+    if (status == PathStatus::FOUND && out_waypoints) {
+        *out_waypoints = std::move(found->second.waypoints);
+    }
+    requests_.erase(found);
+    return status;
+}
+
+void PathService::cancel(PathHandle handle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    requests_.erase(handle);
+}
+
+void PathService::invalidate(int min_x, int min_y, int max_x, int max_y) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto it = cache_.begin(); it != cache_.end();) {
+        if (it->window.overlaps(min_x, min_y, max_x, max_y)) {
+            cache_index_.erase(it->key);
+            it = cache_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Searches in flight (and results not yet collected) ran on the old tiles;
+    // queue them again on a fresh snapshot. Workers skip the outdated jobs.
+    for (auto& entry : requests_) {
+        Request& request = entry.second;
+        if (request.window.overlaps(min_x, min_y, max_x, max_y) && window_for(request.key, request.window)) {
+            request.waypoints.clear();
+            enqueue(entry.first, request);
+        }
+    }
+}
+
+std::size_t PathService::get_cached_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cache_.size();
+}
+
+std::size_t PathService::get_cache_hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cache_hits_;
+}
+
+bool PathService::window_for(const Key& key, Window& out_window) const {
+    int span = std::max(std::abs(key.goal.x - key.start.x), std::abs(key.goal.y - key.start.y));
+    int margin = std::max(MIN_MARGIN, span / 2);
+    out_window.min_x = std::min(key.start.x, key.goal.x) - margin;
+    out_window.min_y = std::min(key.start.y, key.goal.y) - margin;
+    out_window.max_x = std::max(key.start.x, key.goal.x) + margin;
+    out_window.max_y = std::max(key.start.y, key.goal.y) + margin;
+    return out_window.max_x - out_window.min_x < MAX_WINDOW && out_window.max_y - out_window.min_y < MAX_WINDOW;
+}
+
+void PathService::enqueue(PathHandle handle, Request& request) {
+    request.status = PathStatus::PENDING;
+    request.version++;
+
+    Job job;
+    job.handle = handle;
+    job.version = request.version;
+    job.key = request.key;
+    job.grid.capture(*tilemap_, request.window.min_x, request.window.min_y,
+                     request.window.max_x, request.window.max_y);
+
+    if (workers_.empty()) {
+        std::vector<TilePoint> waypoints;
+        bool found = inline_search_.find_path(job.grid, job.key.start, job.key.goal, waypoints);
+        finish(handle, request, found, waypoints);
+        return;
+    }
+    queue_.push_back(std::move(job));
+    wake_.notify_one();
+}
+
+void PathService::finish(PathHandle handle, Request& request, bool found, std::vector<TilePoint>& waypoints) {
+    request.status = found ? PathStatus::FOUND : PathStatus::NOT_FOUND;
+    request.waypoints = waypoints;
+
+    // Results nobody collects are dropped oldest first
+    finished_order_.push_back(handle);
+    while (finished_order_.size() > MAX_FINISHED) {
+        auto stale = requests_.find(finished_order_.front());
+        if (stale != requests_.end() && stale->second.status != PathStatus::PENDING) {
+            requests_.erase(stale);
+        }
+        finished_order_.pop_front();
+    }
+
+    if (cache_size_ == 0) return;
+    auto cached = cache_index_.find(request.key);
+    if (cached != cache_index_.end()) {
+        cache_.erase(cached->second);
+        cache_index_.erase(cached);
+    }
+    cache_.push_front({ request.key, request.window, found, waypoints });
+    cache_index_[request.key] = cache_.begin();
+    while (cache_.size() > cache_size_) {
+        cache_index_.erase(cache_.back().key);
+        cache_.pop_back();
+    }
+}
+
+void PathService::worker_loop() {
+    PathSearch search;
+    std::vector<TilePoint> waypoints;
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        wake_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+        if (stopping_) return;
+
+        Job job = std::move(queue_.front());
+        queue_.pop_front();
+
+        // Skip jobs cancelled or superseded by an edit while queued
+        auto request = requests_.find(job.handle);
+        if (request == requests_.end() || request->second.version != job.version) continue;
+
+        // Search outside the lock; the job owns its snapshot
+        lock.unlock();
+        bool found = search.find_path(job.grid, job.key.start, job.key.goal, waypoints);
+        lock.lock();
+
+        request = requests_.find(job.handle);
+        if (request == requests_.end() || request->second.version != job.version) continue;
+        finish(job.handle, request->second, found, waypoints);
+    }
+}
+
+} // namespace atoms
+} // namespace world
@@ -0,0 +1,144 @@
+/// path_service.hpp — asynchronous pathfinding service atom for world slice
+#pragma once
+#include "path_search.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace world {
+namespace atoms {
+
+enum class PathStatus : std::uint8_t {
+    NONE,        // Unknown handle (never issued, already collected, cancelled or expired)
+    PENDING,     // Queued or being searched
+    FOUND,
+    NOT_FOUND    // No path inside the search window
+};
+
+// Handle to a path request, 0 = none
+using PathHandle = std::uint32_t;
+
+// Point-to-point paths searched on worker threads. request() snapshots the
+// walkability of a window around start and goal on the calling thread and
+// queues the search; poll() hands the result over once it is ready. Recent
+// results are kept in an LRU cache keyed by (start, goal) tiles, so repeated
+// requests are answered without a search. Tile edits drop cached paths whose
+// window they touch and re-queue searches still in flight.
+class PathService {
+public:
+    PathService() = default;
+    ~PathService();
+    PathService(const PathService&) = delete;
+    PathService& operator=(const PathService&) = delete;
+
+    // Start worker threads (worker_count < 0: hardware threads - 1; 0: search
+    // inline in request()). cache_size is the number of recent results kept.
+    void start(const Tilemap* tilemap, int worker_count = -1, std::size_t cache_size = 128);
+    void stop();
+
+    // Queue a search between two tiles. Cached pairs are ready at once.
+    // Returns 0 if the service is not started.
+    // PERF: O(window area / 64) to snapshot walkability; the search runs off-thread
+    PathHandle request(TilePoint start, TilePoint goal);
+
+    // Status of a request. FOUND copies the waypoints (see PathSearch::find_path)
+    // into out_waypoints; FOUND and NOT_FOUND retire the handle.
+    PathStatus poll(PathHandle handle, std::vector<TilePoint>* out_waypoints);
+
+    // Forget a request (its result is discarded if a worker is on it)
+    void cancel(PathHandle handle);
+
+    // Walkability changed in the inclusive tile range
+    void invalidate(int min_x, int min_y, int max_x, int max_y);
+
+    int get_worker_count() const { return static_cast<int>(workers_.size()); }
+    std::size_t get_cached_count() const;
+    std::size_t get_cache_hits() const;
+
+    // Searches are confined to the start-goal bounding box grown by this
+    // margin on each side (at least MIN_MARGIN, half the span by default)
+    static constexpr int MIN_MARGIN = 8;
+
+    // Requests whose window would be wider or taller are NOT_FOUND at once
+    static constexpr int MAX_WINDOW = 384;
+
+private:
+    struct Key {
+        TilePoint start;
+        TilePoint goal;
+        bool operator==(const Key& other) const { return start == other.start && goal == other.goal; }
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    struct Window {
+        int min_x, min_y, max_x, max_y;
+        bool overlaps(int x0, int y0, int x1, int y1) const {
+            return x1 >= min_x && x0 <= max_x && y1 >= min_y && y0 <= max_y;
+        }
+    };
+
+    // One request; version bumps each time an edit re-queues it
+    struct Request {
+        Key key;
+        Window window;
+        std::uint32_t version = 0;
+        PathStatus status = PathStatus::PENDING;
+        std::vector<TilePoint> waypoints;
+    };
+
+    struct Job {
+        PathHandle handle;
+        std::uint32_t version;
+        Key key;
+        PathGrid grid;
+    };
+
+    struct CacheEntry {
+        Key key;
+        Window window;
+        bool found;
+        std::vector<TilePoint> waypoints;
+    };
+
+    const Tilemap* tilemap_ = nullptr;
+    std::size_t cache_size_ = 128;
+    PathHandle next_handle_ = 1;
+    bool started_ = false;
+    PathSearch inline_search_;                       // Used when there are no workers
+
+    // Shared with workers
+    std::vector<std::thread> workers_;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<Job> queue_;
+    std::unordered_map<PathHandle, Request> requests_;
+    std::deque<PathHandle> finished_order_;          // Oldest first, bounds uncollected results
+    std::list<CacheEntry> cache_;                    // Most recently used first
+    std::unordered_map<Key, std::list<CacheEntry>::iterator, KeyHash> cache_index_;
+    std::size_t cache_hits_ = 0;
+    bool stopping_ = false;
+
+    // Results nobody polled are dropped oldest first past this count
+    static constexpr std::size_t MAX_FINISHED = 256;
+
+    void worker_loop();
+
+    // Search window for a pair of tiles (false if it is too large)
+    bool window_for(const Key& key, Window& out_window) const;
+
+    // Snapshot and queue (or run inline) the search for a request; lock held
+    void enqueue(PathHandle handle, Request& request);
+
+    // Store a finished search in its request and the cache; lock held
+    void finish(PathHandle handle, Request& request, bool found, std::vector<TilePoint>& waypoints);
+};
+
+} // namespace atoms
+} // namespace world
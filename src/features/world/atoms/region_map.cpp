@@ -0,0 +1,373 @@
+/// region_map.cpp — implementation of the connected region labels atom
+#include "region_map.hpp"
+#include "tilemap.hpp"
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace world {
+namespace atoms {
+
+void RegionMap::init(const Tilemap* tilemap) {
+    tilemap_ = tilemap;
+    chunks_x_ = tilemap ? tilemap->get_chunks_x() : 0;
+    chunks_y_ = tilemap ? tilemap->get_chunks_y() : 0;
+    clear();
+}
+
+void RegionMap::clear() {
+    chunks_.assign(static_cast<std::size_t>(chunks_x_) * chunks_y_, ChunkLabels{});
+    parent_.clear();
+    closed_.clear();
+    labelled_count_ = 0;
+    relabels_ = 0;
+    for (int side = 0; side < 2; side++) {
+        seen_[side].assign(chunks_.size(), 0);
+    }
+    search_stamp_ = 0;
+}
+
+std::uint32_t RegionMap::get_region(int x, int y) {
+    if (!tilemap_) return 0;
+    label_all();
+    std::int64_t id = id_at(x, y);
+    return id < 0 ? 0 : find(static_cast<std::uint32_t>(id)) + 1;
+}
+
+bool RegionMap::is_reachable(int from_x, int from_y, int to_x, int to_y) {
+    if (!tilemap_) return false;
+    std::int64_t goal = component_at(to_x, to_y);
+    if (goal < 0) return false;
+    auto chunk_of = [this](int x, int y) { return (y >> CHUNK_SHIFT) * chunks_x_ + (x >> CHUNK_SHIFT); };
+    const int goal_chunk = chunk_of(to_x, to_y);
+
+    std::int64_t start = component_at(from_x, from_y);
+    if (start >= 0) {
+        return connected(static_cast<std::uint32_t>(start), chunk_of(from_x, from_y),
+                         static_cast<std::uint32_t>(goal), goal_chunk);
+    }
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            std::int64_t id = component_at(from_x + dx, from_y + dy);
+            if (id >= 0 && connected(static_cast<std::uint32_t>(id), chunk_of(from_x + dx, from_y + dy),
+                                     static_cast<std::uint32_t>(goal), goal_chunk)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void RegionMap::on_tiles_changed(int min_x, int min_y, int max_x, int max_y) {
+    if (!tilemap_ || labelled_count_ == 0) return;
+
+    const int width = tilemap_->get_width();
+    const int height = tilemap_->get_height();
+    if (min_x <= 0 && min_y <= 0 && max_x >= width - 1 && max_y >= height - 1) {
+        clear();
+        return;
+    }
+    min_x = std::max(min_x, 0);
+    min_y = std::max(min_y, 0);
+    max_x = std::min(max_x, width - 1);
+    max_y = std::min(max_y, height - 1);
+
+    bool any_relabel = false;
+    std::vector<std::pair<int, int>> opened;   // Joined a local region, still to union across borders
+    for (int cy = min_y >> CHUNK_SHIFT; cy <= max_y >> CHUNK_SHIFT; cy++) {
+        for (int cx = min_x >> CHUNK_SHIFT; cx <= max_x >> CHUNK_SHIFT; cx++) {
+            int index = cy * chunks_x_ + cx;
+            ChunkLabels& chunk = chunks_[index];
+            if (chunk.labels.empty()) continue;   // Labelled from the new tiles when first needed
+            int x0 = std::max(min_x, cx << CHUNK_SHIFT);
+            int y0 = std::max(min_y, cy << CHUNK_SHIFT);
+            int x1 = std::min(max_x, (cx << CHUNK_SHIFT) + CHUNK_MASK);
+            int y1 = std::min(max_y, (cy << CHUNK_SHIFT) + CHUNK_MASK);
+
+            // Blocking can split a region: only a re-label finds out
+            bool relabel = false;
+            for (int y = y0; y <= y1 && !relabel; y++) {
+                for (int x = x0; x <= x1; x++) {
+                    int local = (y & CHUNK_MASK) * CHUNK_SIZE + (x & CHUNK_MASK);
+                    if (chunk.labels[local] != 0 && !tilemap_->is_walkable(x, y)) {
+                        relabel = true;
+                        break;
+                    }
+                }
+            }
+
+            // An opened tile beside exactly one local region joins it
+            for (int y = y0; y <= y1 && !relabel; y++) {
+                for (int x = x0; x <= x1 && !relabel; x++) {
+                    int lx = x & CHUNK_MASK;
+                    int ly = y & CHUNK_MASK;
+                    int local = ly * CHUNK_SIZE + lx;
+                    if (chunk.labels[local] != 0 || !tilemap_->is_walkable(x, y)) continue;
+
+                    std::uint16_t joined = 0;
+                    bool merges = false;
+                    auto look = [&](int nx, int ny) {
+                        if (nx < 0 || nx >= CHUNK_SIZE || ny < 0 || ny >= CHUNK_SIZE) return;
+                        std::uint16_t label = chunk.labels[ny * CHUNK_SIZE + nx];
+                        if (label == 0) return;
+                        if (joined != 0 && label != joined) merges = true;
+                        joined = label;
+                    };
+                    look(lx - 1, ly);
+                    look(lx + 1, ly);
+                    look(lx, ly - 1);
+                    look(lx, ly + 1);
+                    if (joined == 0 || merges) {
+                        relabel = true;
+                    } else {
+                        chunk.labels[local] = joined;
+                        opened.emplace_back(x, y);
+                    }
+                }
+            }
+
+            if (relabel) {
+                label_chunk(index);
+                relabels_++;
+                any_relabel = true;
+            }
+        }
+    }
+
+    // Re-labelled chunks renumber their components: redo every union from
+    // the border labels. Otherwise only the opened tiles' borders can join.
+    if (any_relabel) {
+        rebuild_unions();
+        return;
+    }
+    // An opened border tile may face an unlabelled chunk: nothing is known closed
+    std::fill(closed_.begin(), closed_.end(), 0);
+    for (const auto& tile : opened) {
+        std::int64_t id = id_at(tile.first, tile.second);
+        const int offsets[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+        for (const auto& offset : offsets) {
+            std::int64_t other = id_at(tile.first + offset[0], tile.second + offset[1]);
+            if (other >= 0) unite(static_cast<std::uint32_t>(id), static_cast<std::uint32_t>(other));
+        }
+    }
+}
+
+int RegionMap::get_region_count() {
+    if (!tilemap_) return 0;
+    label_all();
+    int count = 0;
+    for (std::uint32_t id = 0; id < parent_.size(); id++) {
+        if (find(id) == id) count++;
+    }
+    return count;
+}
+
+void RegionMap::label_all() {
+    if (labelled_count_ == static_cast<int>(chunks_.size())) return;
+    for (int index = 0; index < static_cast<int>(chunks_.size()); index++) {
+        ensure_labelled(index);
+    }
+}
+
+void RegionMap::ensure_labelled(int index) {
+    ChunkLabels& chunk = chunks_[index];
+    if (!chunk.labels.empty()) return;
+
+    label_chunk(index);
+    chunk.first_id = static_cast<std::uint32_t>(parent_.size());
+    parent_.resize(parent_.size() + chunk.count);
+    std::iota(parent_.begin() + chunk.first_id, parent_.end(), chunk.first_id);
+    closed_.resize(parent_.size(), 0);
+    labelled_count_++;
+
+    const int cx = index % chunks_x_;
+    const int cy = index / chunks_x_;
+    unite_east(index);
+    unite_south(index);
+    if (cx > 0) unite_east(index - 1);
+    if (cy > 0) unite_south(index - chunks_x_);
+}
+
+void RegionMap::label_chunk(int index) {
+    ChunkLabels& chunk = chunks_[index];
+    const int origin_x = (index % chunks_x_) << CHUNK_SHIFT;
+    const int origin_y = (index / chunks_x_) << CHUNK_SHIFT;
+
+    // Walkable rows; tiles past the map edge are blocked
+    std::uint64_t rows[CHUNK_SIZE];
+    const int columns = std::min(CHUNK_SIZE, tilemap_->get_width() - origin_x);
+    const std::uint64_t column_mask = columns >= 64 ? ~0ull : (1ull << columns) - 1;
+    for (int y = 0; y < CHUNK_SIZE; y++) {
+        rows[y] = origin_y + y < tilemap_->get_height() ? tilemap_->get_walkable_bits(origin_x, origin_y + y) & column_mask : 0;
+    }
+    auto open = [&rows](int x, int y) { return (rows[y] >> x) & 1; };
+
+    chunk.labels.assign(CHUNK_AREA, 0);
+    chunk.count = 0;
+    for (int start = 0; start < CHUNK_AREA; start++) {
+        if (chunk.labels[start] != 0 || !open(start & CHUNK_MASK, start >> CHUNK_SHIFT)) continue;
+
+        std::uint16_t label = static_cast<std::uint16_t>(++chunk.count);
+        chunk.labels[start] = label;
+        stack_.assign(1, start);
+        while (!stack_.empty()) {
+            int local = stack_.back();
+            stack_.pop_back();
+            int x = local & CHUNK_MASK;
+            int y = local >> CHUNK_SHIFT;
+            auto visit = [&](int nx, int ny) {
+                if (nx < 0 || nx >= CHUNK_SIZE || ny < 0 || ny >= CHUNK_SIZE || !open(nx, ny)) return;
+                int next = ny * CHUNK_SIZE + nx;
+                if (chunk.labels[next] != 0) return;
+                chunk.labels[next] = label;
+                stack_.push_back(next);
+            };
+            visit(x - 1, y);
+            visit(x + 1, y);
+            visit(x, y - 1);
+            visit(x, y + 1);
+        }
+    }
+}
+
+void RegionMap::rebuild_unions() {
+    std::uint32_t next_id = 0;
+    for (ChunkLabels& chunk : chunks_) {
+        chunk.first_id = next_id;
+        next_id += chunk.count;
+    }
+    parent_.resize(next_id);
+    std::iota(parent_.begin(), parent_.end(), 0u);
+    closed_.assign(next_id, 0);
+
+    // Join components whose tiles face each other across a chunk border
+    for (int index = 0; index < static_cast<int>(chunks_.size()); index++) {
+        unite_east(index);
+        unite_south(index);
+    }
+}
+
+void RegionMap::unite_east(int index) {
+    if ((index % chunks_x_) + 1 >= chunks_x_) return;
+    const ChunkLabels& chunk = chunks_[index];
+    const ChunkLabels& east = chunks_[index + 1];
+    if (chunk.labels.empty() || east.labels.empty()) return;
+    for (int y = 0; y < CHUNK_SIZE; y++) {
+        std::uint16_t a = chunk.labels[y * CHUNK_SIZE + CHUNK_MASK];
+        std::uint16_t b = east.labels[y * CHUNK_SIZE];
+        if (a != 0 && b != 0) unite(chunk.first_id + a - 1, east.first_id + b - 1);
+    }
+}
+
+void RegionMap::unite_south(int index) {
+    if ((index / chunks_x_) + 1 >= chunks_y_) return;
+    const ChunkLabels& chunk = chunks_[index];
+    const ChunkLabels& south = chunks_[index + chunks_x_];
+    if (chunk.labels.empty() || south.labels.empty()) return;
+    for (int x = 0; x < CHUNK_SIZE; x++) {
+        std::uint16_t a = chunk.labels[CHUNK_MASK * CHUNK_SIZE + x];
+        std::uint16_t b = south.labels[x];
+        if (a != 0 && b != 0) unite(chunk.first_id + a - 1, south.first_id + b - 1);
+    }
+}
+
+std::int64_t RegionMap::component_at(int x, int y) {
+    if (x < 0 || y < 0 || x >= tilemap_->get_width() || y >= tilemap_->get_height()) return -1;
+    ensure_labelled((y >> CHUNK_SHIFT) * chunks_x_ + (x >> CHUNK_SHIFT));
+    return id_at(x, y);
+}
+
+bool RegionMap::connected(std::uint32_t a, int a_chunk, std::uint32_t b, int b_chunk) {
+    if (find(a) == find(b)) return true;
+    if (labelled_count_ == static_cast<int>(chunks_.size()) || closed_[find(a)] || closed_[find(b)]) {
+        return false;
+    }
+
+    // Walk each region's chunks breadth first, crossing a border wherever the
+    // region has an open tile on it whose facing tile is open (labelling the
+    // chunk beyond joins the two). Alternating sides stops at the smaller region.
+    const std::uint32_t seeds[2] = { a, b };
+    const int seed_chunks[2] = { a_chunk, b_chunk };
+    std::size_t heads[2] = { 0, 0 };
+    search_stamp_++;
+    for (int side = 0; side < 2; side++) {
+        frontier_[side].assign(1, seed_chunks[side]);
+        seen_[side][seed_chunks[side]] = search_stamp_;
+    }
+
+    for (int side = 0;; side ^= 1) {
+        if (heads[side] == frontier_[side].size()) {
+            // Nothing left to grow into: this region is fully labelled
+            closed_[find(seeds[side])] = 1;
+            return false;
+        }
+        const int index = frontier_[side][heads[side]++];
+        const int cx = index % chunks_x_;
+        const int cy = index / chunks_x_;
+        std::uint32_t root = find(seeds[side]);
+
+        // Neighbour offset, and the border tiles on each side of it (local x, y, step)
+        const struct { int dx, dy, x, y, step_x, step_y, face_x, face_y; } borders[4] = {
+            { 1, 0, CHUNK_MASK, 0, 0, 1, 0, 0 },
+            { -1, 0, 0, 0, 0, 1, CHUNK_MASK, 0 },
+            { 0, 1, 0, CHUNK_MASK, 1, 0, 0, 0 },
+            { 0, -1, 0, 0, 1, 0, 0, CHUNK_MASK },
+        };
+        for (const auto& border : borders) {
+            int nx = cx + border.dx;
+            int ny = cy + border.dy;
+            if (nx < 0 || nx >= chunks_x_ || ny < 0 || ny >= chunks_y_) continue;
+            int neighbour = ny * chunks_x_ + nx;
+            if (seen_[side][neighbour] == search_stamp_) continue;
+
+            for (int i = 0; i < CHUNK_SIZE; i++) {
+                int x = border.x + border.step_x * i;
+                int y = border.y + border.step_y * i;
+                std::uint16_t label = chunks_[index].labels[y * CHUNK_SIZE + x];
+                if (label == 0 || find(chunks_[index].first_id + label - 1) != root) continue;
+
+                // Labelling can join the region to an older one with a lower root
+                ensure_labelled(neighbour);
+                root = find(seeds[side]);
+                int face = (border.face_y + border.step_y * i) * CHUNK_SIZE + border.face_x + border.step_x * i;
+                if (chunks_[neighbour].labels[face] == 0) continue;
+                seen_[side][neighbour] = search_stamp_;
+                frontier_[side].push_back(neighbour);
+                break;
+            }
+            if (find(a) == find(b)) return true;
+        }
+    }
+}
+
+std::uint32_t RegionMap::find(std::uint32_t id) {
+    // Path halving
+    while (parent_[id] != id) {
+        parent_[id] = parent_[parent_[id]];
+        id = parent_[id];
+    }
+    return id;
+}
+
+void RegionMap::unite(std::uint32_t a, std::uint32_t b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) return;
+    // Lower id becomes the root
+    if (a < b) {
+        parent_[b] = a;
+    } else {
+        parent_[a] = b;
+    }
+}
+
+std::int64_t RegionMap::id_at(int x, int y) const {
+    if (x < 0 || y < 0 || x >= tilemap_->get_width() || y >= tilemap_->get_height()) return -1;
+    const ChunkLabels& chunk = chunks_[(y >> CHUNK_SHIFT) * chunks_x_ + (x >> CHUNK_SHIFT)];
+    if (chunk.labels.empty()) return -1;
+    std::uint16_t label = chunk.labels[(y & CHUNK_MASK) * CHUNK_SIZE + (x & CHUNK_MASK)];
+    return label == 0 ? -1 : static_cast<std::int64_t>(chunk.first_id) + label - 1;
+}
+
+} // namespace atoms
+} // namespace world
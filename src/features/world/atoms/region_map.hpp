@@ -0,0 +1,115 @@
+/// region_map.hpp — connected walkable region labels atom for world slice
+#pragma once
+#include "tile_chunk.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace world {
+namespace atoms {
+
+// Forward declarations
+class Tilemap;
+
+// Labels walkable tiles with their connected region, so "can A reach B"
+// is a label comparison. Tiles are 4-connected, which matches 8-way movement
+// that never cuts a corner. Each chunk keeps local labels for its own
+// components, and a union-find over the labelled chunks' components joins
+// the ones that touch across chunk borders. Chunks are labelled on demand:
+// a chunk is joined to its labelled neighbours as soon as it is labelled.
+//
+// Edits are applied in place where they can be: a tile that opens next to
+// exactly one local region joins it and is unioned across borders. Any
+// blocking edit (or an opening that merges or starts local regions) re-labels
+// that chunk and rebuilds the union-find from the stored border labels,
+// without reading the tilemap outside the edited chunk.
+class RegionMap {
+public:
+    void init(const Tilemap* tilemap);
+
+    // Region of a tile, 0 for blocked tiles and tiles outside the map.
+    // Numbers are only comparable between edits.
+    // Labels every chunk on the first call (pages each chunk in once);
+    // is_reachable only labels what it needs.
+    // PERF: O(alpha) union-find lookup after that
+    std::uint32_t get_region(int x, int y);
+
+    // True if a walkable path joins the two tiles. A blocked start (an entity
+    // brushing an obstacle) takes the region of an open neighbour.
+    // Labels the two tiles' chunks, then, unless they already share a region,
+    // grows both regions a chunk at a time into unlabelled chunks until they
+    // meet or one runs out (it is then known closed until the next edit).
+    // PERF: O(alpha) once the answer is known; the first query between two
+    // regions labels the chunks the smaller one spans, up to every chunk when
+    // two large regions never meet
+    bool is_reachable(int from_x, int from_y, int to_x, int to_y);
+
+    // Walkability changed in the inclusive range
+    void on_tiles_changed(int min_x, int min_y, int max_x, int max_y);
+
+    void clear();
+
+    // Number of distinct regions (labels every chunk first)
+    int get_region_count();
+
+    // Chunk re-labels done by edits since init or clear (for tests and profiling)
+    int get_relabel_count() const { return relabels_; }
+
+    // Chunks labelled so far (for tests and profiling)
+    int get_labelled_chunk_count() const { return labelled_count_; }
+
+private:
+    // Per chunk: local component label of each tile (0 = blocked) and the
+    // component's first id in the union-find
+    struct ChunkLabels {
+        std::vector<std::uint16_t> labels;   // CHUNK_AREA, row-major; empty until labelled
+        std::uint32_t first_id = 0;
+        std::uint32_t count = 0;             // Local labels 1..count
+    };
+
+    const Tilemap* tilemap_ = nullptr;
+    int chunks_x_ = 0;
+    int chunks_y_ = 0;
+    int labelled_count_ = 0;
+    int relabels_ = 0;
+    std::vector<ChunkLabels> chunks_;
+    std::vector<std::uint32_t> parent_;      // Union-find over component ids
+    std::vector<std::uint8_t> closed_;       // By root id: region fully labelled
+    std::vector<int> stack_;                 // Flood scratch
+
+    // Region growing scratch, one per side of a search; seen by stamp
+    std::vector<int> frontier_[2];
+    std::vector<std::uint32_t> seen_[2];
+    std::uint32_t search_stamp_ = 0;
+
+    void label_all();
+
+    // Label a chunk if it isn't yet: new union-find ids, joined to the
+    // labelled neighbours across its borders
+    void ensure_labelled(int index);
+
+    // Flood-label one chunk's walkable tiles from the tilemap
+    void label_chunk(int index);
+
+    // Reassign ids contiguously and union every pair of touching border tiles
+    void rebuild_unions();
+
+    // Union the components facing each other across a chunk's east / south
+    // border, if both chunks are labelled
+    void unite_east(int index);
+    void unite_south(int index);
+
+    // Union-find id of a tile, labelling its chunk first; -1 if blocked / outside
+    std::int64_t component_at(int x, int y);
+
+    // Grow both components' regions until they meet or one is closed
+    bool connected(std::uint32_t a, int a_chunk, std::uint32_t b, int b_chunk);
+
+    std::uint32_t find(std::uint32_t id);
+    void unite(std::uint32_t a, std::uint32_t b);
+
+    // Union-find id of a tile, or -1 if blocked / outside / not labelled
+    std::int64_t id_at(int x, int y) const;
+};
+
+} // namespace atoms
+} // namespace world
@@ -0,0 +1,319 @@
+/// spawn_loader.cpp — implementation of the streaming spawn loader atom
+#include "spawn_loader.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace world {
+namespace atoms {
+
+namespace {
+    // Just enough JSON for the spawn schema: objects, arrays, strings,
+    // numbers and literals, with unknown members skipped
+    class JsonReader {
+    public:
+        explicit JsonReader(const std::string& text) : p_(text.data()), end_(text.data() + text.size()) {}
+
+        std::string error;
+
+        bool fail(const std::string& message) {
+            if (error.empty()) error = message;
+            return false;
+        }
+
+        void skip_ws() {
+            while (p_ < end_ && (*p_ == ' ' || *p_ == '\t' || *p_ == '\n' || *p_ == '\r')) p_++;
+        }
+
+        bool peek(char c) {
+            skip_ws();
+            return p_ < end_ && *p_ == c;
+        }
+
+        bool consume(char c) {
+            if (!peek(c)) return false;
+            p_++;
+            return true;
+        }
+
+        bool expect(char c) {
+            return consume(c) || fail(std::string("expected '") + c + "'");
+        }
+
+        bool at_end() {
+            skip_ws();
+            return p_ == end_;
+        }
+
+        bool read_string(std::string& out) {
+            if (!expect('"')) return false;
+            out.clear();
+            while (p_ < end_ && *p_ != '"') {
+                if (*p_ == '\\') {
+                    if (++p_ == end_) break;
+                    switch (*p_) {
+                        case 'n': out += '\n'; break;
+                        case 't': out += '\t'; break;
+                        case 'u': p_ += std::min<std::ptrdiff_t>(4, end_ - p_ - 1); out += '?'; break;
+                        default: out += *p_; break;
+                    }
+                    p_++;
+                } else {
+                    out += *p_++;
+                }
+            }
+            if (p_ == end_) return fail("unterminated string");
+            p_++;
+            return true;
+        }
+
+        bool read_number(double& out) {
+            skip_ws();
+            char* number_end = nullptr;
+            std::string digits(p_, std::min<std::ptrdiff_t>(end_ - p_, 64));
+            out = std::strtod(digits.c_str(), &number_end);
+            if (number_end == digits.c_str()) return fail("expected a number");
+            p_ += number_end - digits.c_str();
+            return true;
+        }
+
+        bool read_bool(bool& out) {
+            skip_ws();
+            if (match_literal("true")) { out = true; return true; }
+            if (match_literal("false")) { out = false; return true; }
+            return fail("expected true or false");
+        }
+
+        bool skip_value() {
+            skip_ws();
+            if (p_ == end_) return fail("unexpected end of input");
+            if (*p_ == '"') {
+                std::string ignored;
+                return read_string(ignored);
+            }
+            if (*p_ == '{' || *p_ == '[') {
+                char close = *p_ == '{' ? '}' : ']';
+                bool object = *p_ == '{';
+                p_++;
+                if (consume(close)) return true;
+                do {
+                    if (object) {
+                        std::string key;
+                        if (!read_string(key) || !expect(':')) return false;
+                    }
+                    if (!skip_value()) return false;
+                } while (consume(','));
+                return expect(close);
+            }
+            if (match_literal("true") || match_literal("false") || match_literal("null")) return true;
+            double ignored;
+            return read_number(ignored);
+        }
+
+    private:
+        const char* p_;
+        const char* end_;
+
+        bool match_literal(const char* literal) {
+            const char* q = p_;
+            for (const char* l = literal; *l; l++, q++) {
+                if (q == end_ || *q != *l) return false;
+            }
+            p_ = q;
+            return true;
+        }
+    };
+
+    // { "id": "FOR_SLIME", "x": 12, "y": 7, "respawnable": true }
+    bool read_spawn(JsonReader& json, int tile_size, enemies::EnemySpawnRequest& out) {
+        bool has_id = false, has_x = false, has_y = false;
+        double x = 0.0, y = 0.0;
+        out.respawnable = false;
+
+        if (!json.expect('{')) return false;
+        if (!json.consume('}')) {
+            do {
+                std::string key;
+                if (!json.read_string(key) || !json.expect(':')) return false;
+                if (key == "id") {
+                    std::string name;
+                    if (!json.read_string(name)) return false;
+                    if (!enemies::parse_enemy_id(name, out.id)) return json.fail("unknown enemy id " + name);
+                    has_id = true;
+                } else if (key == "x") {
+                    if (!json.read_number(x)) return false;
+                    has_x = true;
+                } else if (key == "y") {
+                    if (!json.read_number(y)) return false;
+                    has_y = true;
+                } else if (key == "respawnable") {
+                    if (!json.read_bool(out.respawnable)) return false;
+                } else if (!json.skip_value()) {
+                    return false;
+                }
+            } while (json.consume(','));
+            if (!json.expect('}')) return false;
+        }
+        if (!has_id || !has_x || !has_y) return json.fail("spawn needs id, x and y");
+
+        // Schema positions are tiles; spawn at the tile centre
+        out.position = {
+            static_cast<float>((std::floor(x) + 0.5) * tile_size),
+            static_cast<float>((std::floor(y) + 0.5) * tile_size)
+        };
+        return true;
+    }
+}
+
+void SpawnLoader::init(int tile_size) {
+    clear();
+    tile_size_ = tile_size;
+}
+
+bool SpawnLoader::load_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error_ = "cannot open " + path;
+        return false;
+    }
+    std::stringstream text;
+    text << file.rdbuf();
+    return load_json(text.str());
+}
+
+bool SpawnLoader::load_json(const std::string& text) {
+    JsonReader json(text);
+    std::vector<enemies::EnemySpawnRequest> parsed;
+
+    bool ok = json.expect('{');
+    if (ok && !json.consume('}')) {
+        do {
+            std::string key;
+            ok = json.read_string(key) && json.expect(':');
+            if (!ok) break;
+            if (key != "spawns") {
+                ok = json.skip_value();
+                continue;
+            }
+            ok = json.expect('[');
+            if (ok && !json.consume(']')) {
+                do {
+                    enemies::EnemySpawnRequest request;
+                    ok = read_spawn(json, tile_size_, request);
+                    if (!ok) {
+                        json.error = "spawn " + std::to_string(parsed.size()) + ": " + json.error;
+                        break;
+                    }
+                    parsed.push_back(request);
+                } while (json.consume(','));
+                ok = ok && json.expect(']');
+            }
+        } while (ok && json.consume(','));
+        ok = ok && json.expect('}');
+    }
+    if (ok && !json.at_end()) {
+        ok = json.fail("trailing characters after the spawn object");
+    }
+    if (!ok) {
+        error_ = json.error;
+        return false;
+    }
+
+    for (const enemies::EnemySpawnRequest& request : parsed) {
+        add_spawn(request);
+    }
+    error_.clear();
+    return true;
+}
+
+std::uint64_t SpawnLoader::chunk_key(int chunk_x, int chunk_y) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunk_y)) << 32) |
+           static_cast<std::uint32_t>(chunk_x);
+}
+
+void SpawnLoader::add_spawn(const enemies::EnemySpawnRequest& request) {
+    int tile_x = static_cast<int>(std::floor(request.position.x / tile_size_));
+    int tile_y = static_cast<int>(std::floor(request.position.y / tile_size_));
+    int chunk_x = tile_x >> CHUNK_SHIFT;
+    int chunk_y = tile_y >> CHUNK_SHIFT;
+    std::uint64_t key = chunk_key(chunk_x, chunk_y);
+
+    std::vector<SpawnPoint>& bucket = buckets_[key];
+    bucket.push_back({ request });
+    spawn_count_++;
+
+    // Added into a chunk that is already live
+    if (active_chunks_.count(key)) {
+        materialise(bucket);
+    }
+}
+
+void SpawnLoader::clear() {
+    for (auto& entry : buckets_) {
+        retire_bucket(entry.second);
+    }
+    buckets_.clear();
+    active_chunks_.clear();
+    spawn_count_ = 0;
+    live_count_ = 0;
+}
+
+void SpawnLoader::set_handlers(SpawnHandler spawn, RetireHandler retire) {
+    spawn_ = std::move(spawn);
+    retire_ = std::move(retire);
+
+    for (const std::uint64_t key : active_chunks_) {
+        auto bucket = buckets_.find(key);
+        if (bucket != buckets_.end()) {
+            materialise(bucket->second);
+        }
+    }
+}
+
+void SpawnLoader::materialise(std::vector<SpawnPoint>& bucket) {
+    if (!spawn_) return;
+    for (SpawnPoint& point : bucket) {
+        if (point.handle >= 0 || point.defeated) continue;
+        point.handle = spawn_(point.request);
+        if (point.handle >= 0) {
+            live_count_++;
+        }
+    }
+}
+
+void SpawnLoader::activate_chunk(int chunk_x, int chunk_y) {
+    std::uint64_t key = chunk_key(chunk_x, chunk_y);
+    if (!active_chunks_.insert(key).second) return;
+
+    auto bucket = buckets_.find(key);
+    if (bucket != buckets_.end()) {
+        materialise(bucket->second);
+    }
+}
+
+void SpawnLoader::retire_chunk(int chunk_x, int chunk_y) {
+    std::uint64_t key = chunk_key(chunk_x, chunk_y);
+    active_chunks_.erase(key);
+
+    auto bucket = buckets_.find(key);
+    if (bucket != buckets_.end()) {
+        retire_bucket(bucket->second);
+    }
+}
+
+void SpawnLoader::retire_bucket(std::vector<SpawnPoint>& bucket) {
+    for (SpawnPoint& point : bucket) {
+        if (point.handle < 0) continue;
+        bool alive = retire_ ? retire_(point.request, point.handle) : true;
+        if (!alive && !point.request.respawnable) {
+            point.defeated = true;
+        }
+        point.handle = -1;
+        live_count_--;
+    }
+}
+
+} // namespace atoms
+} // namespace world
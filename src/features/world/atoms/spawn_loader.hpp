@@ -0,0 +1,74 @@
+/// spawn_loader.hpp — streaming spawn loader atom for world slice
+#pragma once
+#include "tile_types.hpp"
+#include "features/enemies/types.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace world {
+namespace atoms {
+
+// Creates a live enemy for a spawn point, returns a handle (>= 0) or -1
+using SpawnHandler = std::function<int(const enemies::EnemySpawnRequest& request)>;
+
+// Removes a live enemy, returns true if it was still alive
+using RetireHandler = std::function<bool(const enemies::EnemySpawnRequest& request, int handle)>;
+
+// Holds authored spawn points (WORLDBUILDING.MD §6) bucketed per map chunk.
+// Spawns exist only as requests until their chunk activates; eviction retires
+// them again. Non-respawnable enemies killed while live never come back.
+class SpawnLoader {
+public:
+    // Tile size used to turn schema tile coordinates into world positions
+    void init(int tile_size);
+
+    // Parse a spawn file / JSON text and add its spawns; on failure nothing is
+    // added and get_error() says why
+    bool load_file(const std::string& path);
+    bool load_json(const std::string& text);
+    const std::string& get_error() const { return error_; }
+
+    // Add one spawn point (position in world pixels)
+    void add_spawn(const enemies::EnemySpawnRequest& request);
+
+    // Retire every live spawn and forget all spawn points
+    void clear();
+
+    // Set the enemy factories; spawns of chunks that are already active materialise now
+    void set_handlers(SpawnHandler spawn, RetireHandler retire);
+
+    // Chunk lifecycle, hooked to the tilemap's chunk callbacks
+    // PERF: O(spawns in the chunk); chunks without spawns cost one hash lookup
+    void activate_chunk(int chunk_x, int chunk_y);
+    void retire_chunk(int chunk_x, int chunk_y);
+
+    int get_spawn_count() const { return spawn_count_; }
+    int get_live_count() const { return live_count_; }
+
+private:
+    struct SpawnPoint {
+        enemies::EnemySpawnRequest request;
+        int handle = -1;          // Live enemy, -1 if not materialised
+        bool defeated = false;    // Killed and not respawnable
+    };
+
+    std::unordered_map<std::uint64_t, std::vector<SpawnPoint>> buckets_;
+    std::unordered_set<std::uint64_t> active_chunks_;
+    SpawnHandler spawn_;
+    RetireHandler retire_;
+    int tile_size_ = 32;
+    int spawn_count_ = 0;
+    int live_count_ = 0;
+    std::string error_;
+
+    static std::uint64_t chunk_key(int chunk_x, int chunk_y);
+    void materialise(std::vector<SpawnPoint>& bucket);
+    void retire_bucket(std::vector<SpawnPoint>& bucket);
+};
+
+} // namespace atoms
+} // namespace world
@@ -0,0 +1,216 @@
+/// steering_table.cpp — implementation of the cached steering ray distances atom
+#include "steering_table.hpp"
+#include "tilemap.hpp"
+#include "obstacle_detector.hpp"
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <utility>
+
+namespace world {
+namespace atoms {
+
+void SteeringTable::init(const Tilemap* tilemap, const ObstacleDetector* detector, float max_distance) {
+    tilemap_ = tilemap;
+    detector_ = detector;
+    max_distance_ = std::min(std::max(max_distance, 0.0f), MAX_DISTANCE);
+
+    // Entries are traced past max_distance so the sub-tile correction can shorten
+    // a clear ray by up to half a tile diagonal and still read as clear
+    float tile_size = tilemap_ ? static_cast<float>(tilemap_->get_tile_size()) : 0.0f;
+    reach_ = max_distance_ + tile_size * 0.7072f + 1.0f;
+
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        float angle = i * (2.0f * PI / NUM_DIRECTIONS);
+        directions_[i] = { cosf(angle), sinf(angle) };
+    }
+    clear();
+}
+
+void SteeringTable::get_distances(Vector2 position, float* out_distances) {
+    if (!out_distances) return;
+    if (!tilemap_ || !detector_) {
+        std::fill(out_distances, out_distances + NUM_DIRECTIONS, max_distance_);
+        return;
+    }
+
+    const float tile_size = static_cast<float>(tilemap_->get_tile_size());
+    int tile_x = static_cast<int>(std::floor(position.x / tile_size));
+    int tile_y = static_cast<int>(std::floor(position.y / tile_size));
+
+    // Outside the map every ray starts blocked; nothing worth caching
+    if (tile_x < 0 || tile_x >= tilemap_->get_width() || tile_y < 0 || tile_y >= tilemap_->get_height()) {
+        detector_->raycast_batch(position, directions_.data(), NUM_DIRECTIONS, max_distance_, out_distances);
+        return;
+    }
+
+    Page& page = page_for(tile_x >> CHUNK_SHIFT, tile_y >> CHUNK_SHIFT);
+    int local_x = tile_x & CHUNK_MASK;
+    int local_y = tile_y & CHUNK_MASK;
+    std::uint16_t* entry = &page.distances[(local_y * CHUNK_SIZE + local_x) * NUM_DIRECTIONS * 2];
+    Vector2 centre = { (tile_x + 0.5f) * tile_size, (tile_y + 0.5f) * tile_size };
+
+    if (((page.valid[local_y] >> local_x) & 1) == 0) {
+        float traced[NUM_DIRECTIONS];
+        float swept[NUM_DIRECTIONS];
+        detector_->raycast_batch(centre, directions_.data(), NUM_DIRECTIONS, reach_, traced);
+        sweep_tile(tile_x, tile_y, swept);
+        for (int i = 0; i < NUM_DIRECTIONS; i++) {
+            entry[i] = static_cast<std::uint16_t>(traced[i] * DISTANCE_SCALE);
+            entry[NUM_DIRECTIONS + i] = static_cast<std::uint16_t>(swept[i] * DISTANCE_SCALE);
+        }
+        page.valid[local_y] |= 1ull << local_x;
+    }
+
+    // Moving along a ray brings its hit closer by the same amount, as long as
+    // the ray still hits what the centre's ray hit. A parallel ray can meet an
+    // obstacle the centre's ray passes beside, but not before the swept tile
+    // does, plus the ray's own way out of the tile. Under that bound the bound
+    // itself is the tighter safe read; past it the ray is traced instead
+    Vector2 offset = { position.x - centre.x, position.y - centre.y };
+    const float tile_min_x = tile_x * tile_size;
+    const float tile_min_y = tile_y * tile_size;
+    Vector2 retrace_directions[NUM_DIRECTIONS];
+    int retrace_indices[NUM_DIRECTIONS];
+    int retrace_count = 0;
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        float distance = entry[i] * (1.0f / DISTANCE_SCALE);
+        if (distance <= 0.0f) {
+            out_distances[i] = 0.0f;   // Blocked tile
+            continue;
+        }
+        const Vector2 dir = directions_[i];
+        distance -= offset.x * dir.x + offset.y * dir.y;
+        distance = std::min(std::max(distance, 0.0f), max_distance_);
+
+        float exit_x = dir.x > 0.0f ? (tile_min_x + tile_size - position.x) / dir.x
+                     : dir.x < 0.0f ? (tile_min_x - position.x) / dir.x : max_distance_;
+        float exit_y = dir.y > 0.0f ? (tile_min_y + tile_size - position.y) / dir.y
+                     : dir.y < 0.0f ? (tile_min_y - position.y) / dir.y : max_distance_;
+        float bound = entry[NUM_DIRECTIONS + i] * (1.0f / DISTANCE_SCALE) + std::min(exit_x, exit_y);
+
+        if (distance <= bound + 1.0f / DISTANCE_SCALE) {
+            out_distances[i] = std::min(std::max(distance, bound), max_distance_);
+        } else {
+            retrace_directions[retrace_count] = dir;
+            retrace_indices[retrace_count++] = i;
+        }
+    }
+
+    if (retrace_count > 0) {
+        float traced[NUM_DIRECTIONS];
+        detector_->raycast_batch(position, retrace_directions, retrace_count, max_distance_, traced);
+        for (int j = 0; j < retrace_count; j++) {
+            out_distances[retrace_indices[j]] = traced[j];
+        }
+    }
+}
+
+void SteeringTable::sweep_tile(int tile_x, int tile_y, float* out_distances) const {
+    std::fill(out_distances, out_distances + NUM_DIRECTIONS, reach_);
+
+    // The tile square hits a blocked tile when its centre enters the blocked
+    // tile grown by half a tile; touching without overlap doesn't count, as a
+    // ray sliding along a tile edge isn't blocked by it either
+    const float tile_size = static_cast<float>(tilemap_->get_tile_size());
+    const float half = tile_size * 0.5f;
+    const Vector2 centre = { (tile_x + 0.5f) * tile_size, (tile_y + 0.5f) * tile_size };
+    const int radius = static_cast<int>(std::ceil((reach_ + half) / tile_size));
+    const int width = tilemap_->get_width();
+    const int height = tilemap_->get_height();
+
+    for (int y = tile_y - radius; y <= tile_y + radius; y++) {
+        for (int x = tile_x - radius; x <= tile_x + radius; x++) {
+            // Tiles outside the map are blocked, as for raycasts
+            bool in_map = x >= 0 && x < width && y >= 0 && y < height;
+            if (in_map && tilemap_->is_walkable(x, y)) continue;
+
+            const float low[2] = { x * tile_size - half - centre.x, y * tile_size - half - centre.y };
+            const float high[2] = { low[0] + 2.0f * tile_size, low[1] + 2.0f * tile_size };
+            for (int i = 0; i < NUM_DIRECTIONS; i++) {
+                const float direction[2] = { directions_[i].x, directions_[i].y };
+                float t_enter = 0.0f;
+                float t_exit = out_distances[i];
+                for (int axis = 0; axis < 2 && t_enter < t_exit; axis++) {
+                    if (direction[axis] == 0.0f) {
+                        if (low[axis] >= 0.0f || high[axis] <= 0.0f) t_exit = 0.0f;
+                        continue;
+                    }
+                    float t1 = low[axis] / direction[axis];
+                    float t2 = high[axis] / direction[axis];
+                    if (t1 > t2) std::swap(t1, t2);
+                    t_enter = std::max(t_enter, t1);
+                    t_exit = std::min(t_exit, t2);
+                }
+                if (t_enter < t_exit) out_distances[i] = t_enter;
+            }
+        }
+    }
+}
+
+void SteeringTable::invalidate(int min_x, int min_y, int max_x, int max_y) {
+    if (!tilemap_ || pages_.empty()) return;
+
+    // A tile's sweep reaches tiles up to ceil((reach + half a tile) / tile size) away
+    const float tile_size = static_cast<float>(tilemap_->get_tile_size());
+    int radius = static_cast<int>(std::ceil((reach_ + tile_size * 0.5f) / tile_size));
+    min_x -= radius;
+    min_y -= radius;
+    max_x += radius;
+    max_y += radius;
+
+    int chunks_x = tilemap_->get_chunks_x();
+    for (auto& entry : pages_) {
+        int origin_x = (entry.first % chunks_x) * CHUNK_SIZE;
+        int origin_y = (entry.first / chunks_x) * CHUNK_SIZE;
+        int x0 = std::max(min_x - origin_x, 0);
+        int x1 = std::min(max_x - origin_x, CHUNK_SIZE - 1);
+        int y0 = std::max(min_y - origin_y, 0);
+        int y1 = std::min(max_y - origin_y, CHUNK_SIZE - 1);
+        if (x0 > x1 || y0 > y1) continue;
+
+        int span = x1 - x0 + 1;
+        std::uint64_t mask = (span >= 64 ? ~0ull : ((1ull << span) - 1)) << x0;
+        for (int y = y0; y <= y1; y++) {
+            entry.second->valid[y] &= ~mask;
+        }
+    }
+}
+
+void SteeringTable::clear() {
+    pages_.clear();
+    use_counter_ = 0;
+}
+
+int SteeringTable::get_cached_tile_count() const {
+    int count = 0;
+    for (const auto& entry : pages_) {
+        for (std::uint64_t row : entry.second->valid) {
+            count += static_cast<int>(std::bitset<64>(row).count());
+        }
+    }
+    return count;
+}
+
+SteeringTable::Page& SteeringTable::page_for(int chunk_x, int chunk_y) {
+    int key = chunk_y * tilemap_->get_chunks_x() + chunk_x;
+    auto it = pages_.find(key);
+    if (it == pages_.end()) {
+        // Over budget: drop the page queried least recently
+        while (max_pages_ > 0 && static_cast<int>(pages_.size()) >= max_pages_) {
+            auto oldest = std::min_element(pages_.begin(), pages_.end(), [](const auto& a, const auto& b) {
+                return a.second->last_used < b.second->last_used;
+            });
+            pages_.erase(oldest);
+        }
+
+        auto page = std::make_unique<Page>();
+        page->distances.resize(static_cast<std::size_t>(CHUNK_AREA) * NUM_DIRECTIONS * 2);
+        it = pages_.emplace(key, std::move(page)).first;
+    }
+    it->second->last_used = ++use_counter_;
+    return *it->second;
+}
+
+} // namespace atoms
+} // namespace world
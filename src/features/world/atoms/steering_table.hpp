@@ -0,0 +1,88 @@
+/// steering_table.hpp — cached steering ray distances atom for world slice
+#pragma once
+#include <raylib.h>
+#include "tile_chunk.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace world {
+namespace atoms {
+
+// Forward declarations
+class Tilemap;
+class ObstacleDetector;
+
+// Obstacle distances along the 16 steering directions (ray i at i * 22.5
+// degrees, as EnemyRuntime::get_ray_dir) from walkable tile centres. Tiles are
+// traced the first time they are queried and kept in per-chunk pages; the
+// geometry only changes through set_tile, so an entry stays valid until an
+// edit within reach of it calls invalidate.
+class SteeringTable {
+public:
+    static constexpr int NUM_DIRECTIONS = 16;
+
+    // Distances are cached up to max_distance (at most MAX_DISTANCE)
+    void init(const Tilemap* tilemap, const ObstacleDetector* detector, float max_distance);
+    float get_max_distance() const { return max_distance_; }
+
+    // Fill out_distances[NUM_DIRECTIONS] with the obstacle distance along each
+    // direction, max_distance when clear. Read at the tile centre and corrected
+    // by the position's offset along each ray where the tile's swept distance
+    // shows no other obstacle can be nearer; the remaining rays (grazing an
+    // obstacle, mostly next to one) are traced from the position. Never longer
+    // than raycast_batch from the position, give or take the 1/8 px resolution.
+    // PERF: one raycast_batch and a sweep on a tile's first query, then 16 table
+    // reads (~0.07us) plus a raycast_batch of the rays that fail the bound
+    void get_distances(Vector2 position, float* out_distances);
+
+    // Forget every entry whose rays could reach a tile in the inclusive range
+    // PERF: a few mask writes per cached page row in range
+    void invalidate(int min_x, int min_y, int max_x, int max_y);
+
+    void clear();
+
+    // Maximum number of chunk pages kept, least recently used dropped first (0 = no limit)
+    void set_page_budget(int max_pages) { max_pages_ = max_pages; }
+    int get_page_count() const { return static_cast<int>(pages_.size()); }
+    int get_cached_tile_count() const;
+
+    static constexpr float MAX_DISTANCE = 4096.0f;
+
+private:
+    // Distances in 1/DISTANCE_SCALE pixel units, floored so obstacles are never
+    // reported further away than they are
+    static constexpr float DISTANCE_SCALE = 8.0f;
+
+    struct Page {
+        std::array<std::uint64_t, CHUNK_SIZE> valid = {};   // Bit per cached tile, rows like walk_bits
+        // Per tile: NUM_DIRECTIONS centre ray distances, then NUM_DIRECTIONS
+        // swept distances (how far the whole tile square moves before overlapping
+        // a blocked tile)
+        std::vector<std::uint16_t> distances;
+        std::uint32_t last_used = 0;
+    };
+
+    const Tilemap* tilemap_ = nullptr;
+    const ObstacleDetector* detector_ = nullptr;
+    float max_distance_ = 0.0f;
+    float reach_ = 0.0f;                 // Traced length: max_distance plus half a tile diagonal
+    std::array<Vector2, NUM_DIRECTIONS> directions_ = {};
+
+    std::unordered_map<int, std::unique_ptr<Page>> pages_;   // Keyed by chunk index
+    int max_pages_ = 64;
+    std::uint32_t use_counter_ = 0;
+
+    // Distance the tile's square can move along each direction before it
+    // overlaps a blocked tile, up to reach
+    // PERF: a walkability test per tile within reach, 16 slab tests per blocked one
+    void sweep_tile(int tile_x, int tile_y, float* out_distances) const;
+
+    // Page for a chunk, created (evicting over budget) if missing
+    Page& page_for(int chunk_x, int chunk_y);
+};
+
+} // namespace atoms
+} // namespace world
@@ -0,0 +1,81 @@
+/// tile_chunk.hpp — fixed-size block of tiles, the unit of tilemap streaming
+#pragma once
+#include "tile_types.hpp"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace world {
+namespace atoms {
+
+// A y-sorted object (TREE, BUSH) anchored at its top-left tile, with its footprint
+struct ChunkObject {
+    int sort_y;       // Bottom edge in tiles (anchor y + height), the draw order key
+    int x;            // Anchor tile
+    int y;
+    TileType type;
+    std::uint8_t width;    // Footprint in tiles
+    std::uint8_t height;
+
+    bool operator<(const ChunkObject& other) const {
+        return sort_y != other.sort_y ? sort_y < other.sort_y : x < other.x;
+    }
+};
+
+// Reference from a cell to the object covering it, which may be anchored in
+// another chunk up or to the left
+struct CellRef {
+    TileType type = TileType::NONE;   // Covering object's type, NONE = uncovered
+    std::uint8_t offset = 0;          // dy << 4 | dx back to the object's anchor
+
+    int dx() const { return offset & 0x0F; }
+    int dy() const { return offset >> 4; }
+};
+
+// Anchor offsets are packed into a nibble each
+static_assert(MAX_TILE_WIDTH <= 16 && MAX_TILE_HEIGHT <= 16, "object footprints must fit CellRef offsets");
+
+// One resident CHUNK_SIZE x CHUNK_SIZE block of the map (row-major cells).
+// Ground tiles and objects are separate layers: objects live in a sparse
+// sorted list with explicit footprints, and every cell they cover points back
+// at them, so footprint queries never scan neighbouring cells.
+struct TileChunk {
+    int chunk_x = 0;                 // Chunk coordinates (tile >> CHUNK_SHIFT)
+    int chunk_y = 0;
+    bool modified = false;           // Edited since load; persisted on eviction
+    bool active = false;             // Entered the streaming window since it was paged in
+    std::uint32_t last_used = 0;     // Streaming frame this chunk was last wanted
+    std::array<TileType, CHUNK_AREA> tiles;          // Ground layer (terrain, NONE under objects)
+    std::array<CellRef, CHUNK_AREA> cover;           // Object covering each cell
+    std::array<std::uint64_t, CHUNK_SIZE> walk_bits; // Bit x of row y set = tile walkable
+    std::array<std::uint8_t, CHUNK_AREA> move_costs; // Move cost of each cell, 0 = blocked
+    std::vector<ChunkObject> objects;  // Objects anchored in this chunk, sorted by (sort_y, x)
+
+    TileType& at(int local_x, int local_y) { return tiles[local_y * CHUNK_SIZE + local_x]; }
+    TileType at(int local_x, int local_y) const { return tiles[local_y * CHUNK_SIZE + local_x]; }
+    bool walkable(int local_x, int local_y) const { return (walk_bits[local_y] >> local_x) & 1u; }
+
+    // Single-layer view of a cell: the object type at an anchor, NONE over
+    // the rest of a footprint, otherwise the ground tile
+    TileType tile(int local) const {
+        const CellRef& ref = cover[local];
+        if (ref.type == TileType::NONE) return tiles[local];
+        return ref.offset == 0 ? ref.type : TileType::NONE;
+    }
+};
+
+// Fills a freshly allocated chunk's tiles (pre-filled with NONE) in the
+// single-layer view: objects at their anchor, NONE over the rest of their
+// footprint. Called whenever a chunk that has never been edited is paged in.
+using ChunkSource = std::function<void(int chunk_x, int chunk_y, TileType* out_tiles)>;
+
+// Notified when a resident chunk first enters the streaming window (activated)
+// and when an activated chunk is dropped (evicted)
+using ChunkEventCallback = std::function<void(int chunk_x, int chunk_y)>;
+
+// Notified with the inclusive tile range whose walkability or move cost an edit may have changed
+using TileRangeCallback = std::function<void(int min_x, int min_y, int max_x, int max_y)>;
+
+} // namespace atoms
+} // namespace world
@@ -0,0 +1,138 @@
+/// tile_types.hpp — tile identifiers, property tables and chunk geometry for world slice
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace world {
+namespace atoms {
+
+// Tile types (stored as one byte per tile)
+enum class TileType : std::uint8_t {
+    NONE,     // Empty/no tile
+    GRASS,    // Walkable grass
+    DIRT,     // Walkable dirt path
+    WATER,    // Non-walkable water
+    TREE,     // Non-walkable tree (2x2 tile)
+    BUSH,     // Non-walkable bush
+    SHALLOWS, // Walkable shallow water (slow)
+    COUNT     // Number of tile types (not a tile)
+};
+
+constexpr std::size_t TILE_TYPE_COUNT = static_cast<std::size_t>(TileType::COUNT);
+
+constexpr std::size_t tile_index(TileType type) {
+    return static_cast<std::size_t>(type);
+}
+
+// Tile flag bits, one byte per tile type
+enum TileFlags : std::uint8_t {
+    TILE_FLAG_WALKABLE = 1 << 0,   // Can be walked on
+    TILE_FLAG_LARGE    = 1 << 1,   // Covers more than one tile
+    TILE_FLAG_TERRAIN  = 1 << 2,   // Drawn flat in the terrain pass over grass
+    TILE_FLAG_OBJECT   = 1 << 3,   // Drawn y-sorted in the object pass
+    TILE_FLAG_OPAQUE   = 1 << 4,   // Blocks line of sight
+    TILE_FLAG_SLOW     = 1 << 5,   // Costs more than open ground to cross
+    TILE_FLAG_DAMAGE   = 1 << 6,   // Hurts whatever stands on it
+    TILE_FLAG_SWIM     = 1 << 7    // Crossable only by swimmers
+};
+
+// Move cost of open ground. Crossing a tile costs move_cost / MOVE_COST_BASE
+// times as much time as open ground, and path costs are built from the same
+// numbers (10 per straight step, 14 per diagonal on open ground).
+constexpr std::uint8_t MOVE_COST_BASE = 10;
+
+// Tile properties
+struct TileProperties {
+    bool walkable;          // Can player walk on this tile?
+    bool is_large;          // Is this a larger than 1x1 tile (like tree)?
+    int width_in_tiles;     // Width in tile units
+    int height_in_tiles;    // Height in tile units
+    std::uint8_t flags;     // TileFlags bits (walkable/large mirrored for bit tests)
+    std::uint8_t move_cost; // MOVE_COST_BASE on open ground, more on slow ground, 0 if not walkable
+    const char* texture;    // Asset path, nullptr if the type is never drawn
+};
+
+// Property table indexed by TileType
+constexpr std::array<TileProperties, TILE_TYPE_COUNT> TILE_PROPERTIES = {{
+    // walkable, is_large, w, h, flags,                                            cost, texture
+    { true,  false, 1, 1, TILE_FLAG_WALKABLE,                                      10,  nullptr },                     // NONE
+    { true,  false, 1, 1, TILE_FLAG_WALKABLE,                                      10,  "assets/tiles/grass.png" },    // GRASS
+    { true,  false, 1, 1, TILE_FLAG_WALKABLE | TILE_FLAG_TERRAIN,                  10,  "assets/tiles/dirt.png" },     // DIRT
+    { false, false, 1, 1, TILE_FLAG_TERRAIN | TILE_FLAG_SWIM,                      0,   "assets/tiles/water.png" },    // WATER
+    { false, true,  2, 2, TILE_FLAG_LARGE | TILE_FLAG_OBJECT | TILE_FLAG_OPAQUE,   0,   "assets/tiles/tree.png" },     // TREE
+    { false, false, 1, 1, TILE_FLAG_OBJECT | TILE_FLAG_OPAQUE,                     0,   "assets/tiles/bush.png" },     // BUSH
+    { true,  false, 1, 1, TILE_FLAG_WALKABLE | TILE_FLAG_TERRAIN | TILE_FLAG_SLOW, 20,  "assets/tiles/shallows.png" }, // SHALLOWS
+}};
+
+// Flag bytes alone, packed so hot loops touch a single cache line
+constexpr std::array<std::uint8_t, TILE_TYPE_COUNT> make_tile_flags() {
+    std::array<std::uint8_t, TILE_TYPE_COUNT> flags = {};
+    for (std::size_t i = 0; i < TILE_TYPE_COUNT; i++) {
+        flags[i] = TILE_PROPERTIES[i].flags;
+    }
+    return flags;
+}
+constexpr std::array<std::uint8_t, TILE_TYPE_COUNT> TILE_FLAGS = make_tile_flags();
+
+// Largest footprint of any tile type, bounds how far an object reaches from its anchor
+constexpr int max_tile_extent(bool height) {
+    int extent = 1;
+    for (const TileProperties& props : TILE_PROPERTIES) {
+        int size = height ? props.height_in_tiles : props.width_in_tiles;
+        extent = size > extent ? size : extent;
+    }
+    return extent;
+}
+constexpr int MAX_TILE_WIDTH = max_tile_extent(false);
+constexpr int MAX_TILE_HEIGHT = max_tile_extent(true);
+
+// Highest move cost of any tile type, bounds the cost of a single step
+constexpr std::uint8_t max_move_cost() {
+    std::uint8_t cost = MOVE_COST_BASE;
+    for (const TileProperties& props : TILE_PROPERTIES) {
+        cost = props.move_cost > cost ? props.move_cost : cost;
+    }
+    return cost;
+}
+constexpr std::uint8_t MAX_MOVE_COST = max_move_cost();
+
+// Cost of a step between two neighbouring tiles: the mean of their move costs,
+// times 1.4 on a diagonal. Symmetric, so searches toward or away from a goal
+// agree; never below 10 / 14, so the octile distance stays a lower bound.
+constexpr std::uint32_t straight_step_cost(std::uint8_t from_cost, std::uint8_t to_cost) {
+    return (static_cast<std::uint32_t>(from_cost) + to_cost) / 2;
+}
+constexpr std::uint32_t diagonal_step_cost(std::uint8_t from_cost, std::uint8_t to_cost) {
+    return (static_cast<std::uint32_t>(from_cost) + to_cost) * 7 / 10;
+}
+
+constexpr const TileProperties& tile_properties(TileType type) {
+    return TILE_PROPERTIES[tile_index(type)];
+}
+
+constexpr bool has_tile_flag(TileType type, std::uint8_t flag) {
+    return (TILE_FLAGS[tile_index(type)] & flag) != 0;
+}
+
+// The bool fields, flag bits and move costs must agree
+constexpr bool tile_tables_consistent() {
+    for (const TileProperties& props : TILE_PROPERTIES) {
+        if (props.walkable != ((props.flags & TILE_FLAG_WALKABLE) != 0)) return false;
+        if (props.is_large != ((props.flags & TILE_FLAG_LARGE) != 0)) return false;
+        if (props.walkable ? props.move_cost < MOVE_COST_BASE : props.move_cost != 0) return false;
+        if (((props.flags & TILE_FLAG_SLOW) != 0) != (props.move_cost > MOVE_COST_BASE)) return false;
+    }
+    return true;
+}
+static_assert(tile_tables_consistent(), "TILE_PROPERTIES flags disagree with walkable/is_large/move_cost");
+
+// Chunk geometry: the map is stored as square chunks of CHUNK_SIZE x CHUNK_SIZE tiles
+// (one chunk row is exactly one 64-bit walkability word)
+constexpr int CHUNK_SHIFT = 6;
+constexpr int CHUNK_SIZE = 1 << CHUNK_SHIFT;   // 64 tiles per side
+constexpr int CHUNK_MASK = CHUNK_SIZE - 1;
+constexpr int CHUNK_AREA = CHUNK_SIZE * CHUNK_SIZE;
+
+} // namespace atoms
+} // namespace world
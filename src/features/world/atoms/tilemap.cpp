@@ -1,5 +1,6 @@
 /// tilemap.cpp — implementation of tilemap atom
 #include "tilemap.hpp"
+#include "core/public/render_queue.hpp"
 #include <algorithm>
 #include <cmath>
 
@@ -11,46 +12,32 @@ void Tilemap::init(int map_width, int map_height, int tile_size) {
     height_ = map_height;
     tile_size_ = tile_size;
     
-    // Initialize with empty tiles
-    tiles_.resize(width_ * height_, TileType::NONE);
+    // Size the chunk table; tiles themselves are paged in on demand
+    drop_all_chunks();
+    chunks_x_ = (width_ + CHUNK_SIZE - 1) >> CHUNK_SHIFT;
+    chunks_y_ = (height_ + CHUNK_SIZE - 1) >> CHUNK_SHIFT;
+    chunks_.clear();
+    chunks_.resize(static_cast<size_t>(chunks_x_) * chunks_y_);
+    saved_chunks_.clear();
+    release_ground_bakes();
     
-    // Set up tile properties
-    init_properties();
+    // Initialize with empty tiles
+    source_ = nullptr;
 }
 
 bool Tilemap::load_textures() {
     // Load textures for each tile type with proper transparency
-    Image img;
-    
-    // Load grass (base tile)
-    img = LoadImage("assets/tiles/grass.png");
-    textures_[TileType::GRASS] = LoadTextureFromImage(img);
-    UnloadImage(img);
-    
-    // Load dirt with transparency
-    img = LoadImage("assets/tiles/dirt.png");
-    textures_[TileType::DIRT] = LoadTextureFromImage(img);
-    UnloadImage(img);
-    
-    // Load water with transparency
-    img = LoadImage("assets/tiles/water.png");
-    textures_[TileType::WATER] = LoadTextureFromImage(img);
-    UnloadImage(img);
-    
-    // Load tree with transparency
-    img = LoadImage("assets/tiles/tree.png");
-    textures_[TileType::TREE] = LoadTextureFromImage(img);
-    UnloadImage(img);
-    
-    // Load bush with transparency
-    img = LoadImage("assets/tiles/bush.png");
-    textures_[TileType::BUSH] = LoadTextureFromImage(img);
-    UnloadImage(img);
-    
-    // Check if textures loaded correctly
-    for (const auto& pair : textures_) {
-        if (pair.second.id == 0) {
-            TraceLog(LOG_WARNING, "Failed to load texture for tile type %d", static_cast<int>(pair.first));
+    for (size_t i = 0; i < TILE_TYPE_COUNT; i++) {
+        const char* path = TILE_PROPERTIES[i].texture;
+        if (!path) continue;
+        
+        Image img = LoadImage(path);
+        textures_[i] = LoadTextureFromImage(img);
+        UnloadImage(img);
+        
+        // Check if the texture loaded correctly
+        if (textures_[i].id == 0) {
+            TraceLog(LOG_WARNING, "Failed to load texture for tile type %d", static_cast<int>(i));
             return false;
         }
     }
@@ -60,7 +47,9 @@ bool Tilemap::load_textures() {
 
 void Tilemap::generate_demo_map() {
     // Fill the map with grass by default
-    std::fill(tiles_.begin(), tiles_.end(), TileType::GRASS);
+    set_chunk_source([](int, int, TileType* out_tiles) {
+        std::fill(out_tiles, out_tiles + CHUNK_AREA, TileType::GRASS);
+    });
     
     // Create a simple dirt path
     for (int x = 10; x < width_ - 10; x++) {
@@ -92,38 +81,380 @@ void Tilemap::generate_demo_map() {
     set_tile(35, 25, TileType::BUSH);
 }
 
+void Tilemap::set_chunk_source(ChunkSource source, ChunkSource peek_source) {
+    // Anything already paged in came from the old source
+    drop_all_chunks();
+    peek_source_ = peek_source ? std::move(peek_source) : source;
+    source_ = std::move(source);
+    saved_chunks_.clear();
+    peek_cache_index_ = -1;
+    
+    // Baked ground came from the old tiles too
+    for (GroundBake& bake : ground_bakes_) {
+        bake.dirty = true;
+    }
+    if (on_tiles_changed_) {
+        on_tiles_changed_(0, 0, width_ - 1, height_ - 1);
+    }
+}
+
+bool Tilemap::is_chunk_resident(int chunk_x, int chunk_y) const {
+    if (chunk_x < 0 || chunk_x >= chunks_x_ || chunk_y < 0 || chunk_y >= chunks_y_) {
+        return false;
+    }
+    return chunks_[chunk_y * chunks_x_ + chunk_x] != nullptr;
+}
+
+TileChunk& Tilemap::chunk_for_tile(int x, int y) const {
+    int chunk_x = x >> CHUNK_SHIFT;
+    int chunk_y = y >> CHUNK_SHIFT;
+    TileChunk* chunk = chunks_[chunk_y * chunks_x_ + chunk_x].get();
+    return chunk ? *chunk : load_chunk(chunk_x, chunk_y);
+}
+
+TileChunk& Tilemap::load_chunk(int chunk_x, int chunk_y) const {
+    int index = chunk_y * chunks_x_ + chunk_x;
+    
+    auto chunk = std::make_unique<TileChunk>();
+    chunk->chunk_x = chunk_x;
+    chunk->chunk_y = chunk_y;
+    chunk->last_used = stream_frame_;
+    chunk->tiles.fill(TileType::NONE);
+    
+    // Edited chunks come back exactly as they were left
+    auto saved = saved_chunks_.find(index);
+    if (saved != saved_chunks_.end()) {
+        std::copy(saved->second.begin(), saved->second.end(), chunk->tiles.begin());
+        chunk->modified = true;
+        saved_chunks_.erase(saved);
+    } else if (source_) {
+        source_(chunk_x, chunk_y, chunk->tiles.data());
+    }
+    
+    chunks_[index] = std::move(chunk);
+    resident_.push_back(index);
+    build_layers(*chunks_[index]);
+    build_walk_bits(*chunks_[index]);
+    return *chunks_[index];
+}
+
+void Tilemap::build_layers(TileChunk& chunk) const {
+    int base_x = chunk.chunk_x << CHUNK_SHIFT;
+    int base_y = chunk.chunk_y << CHUNK_SHIFT;
+    
+    chunk.cover.fill(CellRef{});
+    chunk.objects.clear();
+    
+    // Objects anchored here move from the tile layer to the object layer
+    for (int ly = 0; ly < CHUNK_SIZE; ly++) {
+        for (int lx = 0; lx < CHUNK_SIZE; lx++) {
+            TileType& tile = chunk.at(lx, ly);
+            if (!has_tile_flag(tile, TILE_FLAG_OBJECT)) continue;
+            
+            const TileProperties& props = tile_properties(tile);
+            int x = base_x + lx;
+            int y = base_y + ly;
+            chunk.objects.push_back({ y + props.height_in_tiles, x, y, tile,
+                                      static_cast<std::uint8_t>(props.width_in_tiles),
+                                      static_cast<std::uint8_t>(props.height_in_tiles) });
+            
+            // Refs for the part of the footprint inside this chunk
+            int max_dx = std::min(props.width_in_tiles, CHUNK_SIZE - lx);
+            int max_dy = std::min(props.height_in_tiles, CHUNK_SIZE - ly);
+            for (int dy = 0; dy < max_dy; dy++) {
+                for (int dx = 0; dx < max_dx; dx++) {
+                    chunk.cover[(ly + dy) * CHUNK_SIZE + lx + dx] = { tile, static_cast<std::uint8_t>(dy << 4 | dx) };
+                }
+            }
+            tile = TileType::NONE;
+        }
+    }
+    std::sort(chunk.objects.begin(), chunk.objects.end());
+    
+    // Footprints reaching in from the chunks up and to the left can only cover
+    // NONE cells in the first MAX_TILE_WIDTH-1 columns / MAX_TILE_HEIGHT-1 rows
+    for (int ly = 0; ly < CHUNK_SIZE; ly++) {
+        int end_lx = ly < MAX_TILE_HEIGHT - 1 ? CHUNK_SIZE : MAX_TILE_WIDTH - 1;
+        for (int lx = 0; lx < end_lx; lx++) {
+            int local = ly * CHUNK_SIZE + lx;
+            if (chunk.tiles[local] != TileType::NONE || chunk.cover[local].type != TileType::NONE) continue;
+            
+            // Candidate anchors outside this chunk, read without paging their chunks in
+            for (int dy = 0; dy < MAX_TILE_HEIGHT && chunk.cover[local].type == TileType::NONE; dy++) {
+                for (int dx = 0; dx < MAX_TILE_WIDTH; dx++) {
+                    if (dx <= lx && dy <= ly) continue;
+                    TileType anchor = peek_tile(base_x + lx - dx, base_y + ly - dy);
+                    const TileProperties& props = tile_properties(anchor);
+                    if (has_tile_flag(anchor, TILE_FLAG_OBJECT) &&
+                        dx < props.width_in_tiles && dy < props.height_in_tiles) {
+                        chunk.cover[local] = { anchor, static_cast<std::uint8_t>(dy << 4 | dx) };
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+const std::vector<ChunkObject>& Tilemap::get_chunk_objects(int chunk_x, int chunk_y) const {
+    static const std::vector<ChunkObject> no_objects;
+    if (chunk_x < 0 || chunk_x >= chunks_x_ || chunk_y < 0 || chunk_y >= chunks_y_) {
+        return no_objects;
+    }
+    return chunk_for_tile(chunk_x << CHUNK_SHIFT, chunk_y << CHUNK_SHIFT).objects;
+}
+
+void Tilemap::evict_chunk(int index) {
+    TileChunk& chunk = *chunks_[index];
+    if (chunk.modified) {
+        // Saved in the same single-layer form chunk sources produce
+        std::vector<TileType>& saved = saved_chunks_[index];
+        saved.resize(CHUNK_AREA);
+        for (int i = 0; i < CHUNK_AREA; i++) {
+            saved[i] = chunk.tile(i);
+        }
+    }
+    if (chunk.active && on_chunk_evicted_) {
+        on_chunk_evicted_(chunk.chunk_x, chunk.chunk_y);
+    }
+    chunks_[index].reset();
+}
+
+void Tilemap::drop_all_chunks() {
+    // Unlike eviction, edits are not saved
+    for (int index : resident_) {
+        const TileChunk& chunk = *chunks_[index];
+        if (chunk.active && on_chunk_evicted_) {
+            on_chunk_evicted_(chunk.chunk_x, chunk.chunk_y);
+        }
+        chunks_[index].reset();
+    }
+    resident_.clear();
+}
+
+void Tilemap::update_streaming(const Rectangle& camera_view) {
+    if (chunks_.empty()) return;
+    stream_frame_++;
+    
+    // Chunk window covering the view plus a margin
+    int chunk_px = CHUNK_SIZE * tile_size_;
+    int min_cx = std::max(0, static_cast<int>(std::floor(camera_view.x / chunk_px)) - stream_margin_);
+    int min_cy = std::max(0, static_cast<int>(std::floor(camera_view.y / chunk_px)) - stream_margin_);
+    int max_cx = std::min(chunks_x_ - 1, static_cast<int>(std::floor((camera_view.x + camera_view.width) / chunk_px)) + stream_margin_);
+    int max_cy = std::min(chunks_y_ - 1, static_cast<int>(std::floor((camera_view.y + camera_view.height) / chunk_px)) + stream_margin_);
+    
+    // Page in everything in the window and mark it as wanted this frame
+    for (int cy = min_cy; cy <= max_cy; cy++) {
+        for (int cx = min_cx; cx <= max_cx; cx++) {
+            TileChunk* chunk = chunks_[cy * chunks_x_ + cx].get();
+            if (!chunk) {
+                chunk = &load_chunk(cx, cy);
+            }
+            chunk->last_used = stream_frame_;
+            if (!chunk->active) {
+                chunk->active = true;
+                if (on_chunk_activated_) {
+                    on_chunk_activated_(cx, cy);
+                }
+            }
+        }
+    }
+    
+    // Ring one chunk beyond the window: what the next camera move pages in
+    if (on_chunk_prefetch_) {
+        for (int cy = std::max(0, min_cy - 1); cy <= std::min(chunks_y_ - 1, max_cy + 1); cy++) {
+            for (int cx = std::max(0, min_cx - 1); cx <= std::min(chunks_x_ - 1, max_cx + 1); cx++) {
+                int index = cy * chunks_x_ + cx;
+                if (!chunks_[index] && !saved_chunks_.count(index)) {
+                    on_chunk_prefetch_(cx, cy);
+                }
+            }
+        }
+    }
+    
+    if (static_cast<int>(resident_.size()) <= max_resident_chunks_) return;
+    
+    // Over budget: evict least recently wanted chunks outside the window
+    std::sort(resident_.begin(), resident_.end(), [this](int a, int b) {
+        return chunks_[a]->last_used < chunks_[b]->last_used;
+    });
+    size_t excess = resident_.size() - max_resident_chunks_;
+    size_t evicted = 0;
+    while (evicted < excess && chunks_[resident_[evicted]]->last_used != stream_frame_) {
+        evict_chunk(resident_[evicted]);
+        evicted++;
+    }
+    resident_.erase(resident_.begin(), resident_.begin() + evicted);
+}
+
+TileType Tilemap::peek_tile(int x, int y) const {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_) {
+        return TileType::NONE;
+    }
+    
+    int index = (y >> CHUNK_SHIFT) * chunks_x_ + (x >> CHUNK_SHIFT);
+    int local = (y & CHUNK_MASK) * CHUNK_SIZE + (x & CHUNK_MASK);
+    if (const TileChunk* chunk = chunks_[index].get()) {
+        return chunk->tile(local);
+    }
+    
+    auto saved = saved_chunks_.find(index);
+    if (saved != saved_chunks_.end()) {
+        return saved->second[local];
+    }
+    
+    // Run the source into a scratch buffer instead of paging the chunk in,
+    // so resolving one chunk's edges never cascades into its neighbours
+    if (peek_cache_index_ != index) {
+        peek_cache_.assign(CHUNK_AREA, TileType::NONE);
+        if (peek_source_) {
+            peek_source_(x >> CHUNK_SHIFT, y >> CHUNK_SHIFT, peek_cache_.data());
+        }
+        peek_cache_index_ = index;
+    }
+    return peek_cache_[local];
+}
+
+TileType Tilemap::resolve_type(const TileChunk& chunk, int local) {
+    const CellRef& ref = chunk.cover[local];
+    return ref.type != TileType::NONE ? ref.type : chunk.tiles[local];
+}
+
+void Tilemap::build_walk_bits(TileChunk& chunk) const {
+    int base_x = chunk.chunk_x << CHUNK_SHIFT;
+    int base_y = chunk.chunk_y << CHUNK_SHIFT;
+    
+    for (int ly = 0; ly < CHUNK_SIZE; ly++) {
+        // Tiles past the map edge count as open ground, like out-of-bounds queries
+        std::uint64_t row = ~0ull;
+        std::uint8_t* costs = &chunk.move_costs[ly * CHUNK_SIZE];
+        std::fill(costs, costs + CHUNK_SIZE, MOVE_COST_BASE);
+        int y = base_y + ly;
+        if (y < height_) {
+            int count = std::min(CHUNK_SIZE, width_ - base_x);
+            for (int lx = 0; lx < count; lx++) {
+                const TileProperties& props = tile_properties(resolve_type(chunk, ly * CHUNK_SIZE + lx));
+                costs[lx] = props.move_cost;
+                if (!(props.flags & TILE_FLAG_WALKABLE)) {
+                    row &= ~(1ull << lx);
+                }
+            }
+        }
+        chunk.walk_bits[ly] = row;
+    }
+}
+
+void Tilemap::refresh_walk_bits(int min_x, int min_y, int max_x, int max_y) {
+    min_x = std::max(min_x, 0);
+    min_y = std::max(min_y, 0);
+    max_x = std::min(max_x, width_ - 1);
+    max_y = std::min(max_y, height_ - 1);
+    
+    for (int y = min_y; y <= max_y; y++) {
+        for (int x = min_x; x <= max_x; x++) {
+            TileChunk& chunk = chunk_for_tile(x, y);
+            std::uint64_t bit = 1ull << (x & CHUNK_MASK);
+            std::uint64_t& row = chunk.walk_bits[y & CHUNK_MASK];
+            int local = (y & CHUNK_MASK) * CHUNK_SIZE + (x & CHUNK_MASK);
+            const TileProperties& props = tile_properties(resolve_type(chunk, local));
+            chunk.move_costs[local] = props.move_cost;
+            row = (props.flags & TILE_FLAG_WALKABLE) ? (row | bit) : (row & ~bit);
+        }
+    }
+}
+
+void Tilemap::write_ground(int x, int y, TileType type) {
+    TileChunk& chunk = chunk_for_tile(x, y);
+    TileType& tile = chunk.at(x & CHUNK_MASK, y & CHUNK_MASK);
+    
+    // Only flat terrain is baked; grass going to NONE under an object leaves the bake valid
+    if (has_tile_flag(tile, TILE_FLAG_TERRAIN) || has_tile_flag(type, TILE_FLAG_TERRAIN)) {
+        mark_ground_dirty(chunk.chunk_y * chunks_x_ + chunk.chunk_x);
+    }
+    
+    tile = type;
+    chunk.modified = true;
+}
+
+void Tilemap::add_object(int x, int y, TileType type) {
+    const TileProperties& props = tile_properties(type);
+    for (int dy = 0; dy < props.height_in_tiles; dy++) {
+        for (int dx = 0; dx < props.width_in_tiles; dx++) {
+            write_ground(x + dx, y + dy, TileType::NONE);
+            TileChunk& chunk = chunk_for_tile(x + dx, y + dy);
+            chunk.cover[((y + dy) & CHUNK_MASK) * CHUNK_SIZE + ((x + dx) & CHUNK_MASK)] =
+                { type, static_cast<std::uint8_t>(dy << 4 | dx) };
+        }
+    }
+    
+    // Keep the anchor chunk's sorted object list in step
+    TileChunk& anchor = chunk_for_tile(x, y);
+    ChunkObject object = { y + props.height_in_tiles, x, y, type,
+                           static_cast<std::uint8_t>(props.width_in_tiles),
+                           static_cast<std::uint8_t>(props.height_in_tiles) };
+    anchor.objects.insert(std::lower_bound(anchor.objects.begin(), anchor.objects.end(), object), object);
+}
+
+void Tilemap::remove_object(const ChunkObject& object) {
+    for (int dy = 0; dy < object.height; dy++) {
+        for (int dx = 0; dx < object.width; dx++) {
+            TileChunk& chunk = chunk_for_tile(object.x + dx, object.y + dy);
+            CellRef& ref = chunk.cover[((object.y + dy) & CHUNK_MASK) * CHUNK_SIZE + ((object.x + dx) & CHUNK_MASK)];
+            if (ref.type == object.type && ref.dx() == dx && ref.dy() == dy) {
+                ref = CellRef{};
+            }
+            chunk.modified = true;
+        }
+    }
+    
+    TileChunk& anchor = chunk_for_tile(object.x, object.y);
+    auto it = std::lower_bound(anchor.objects.begin(), anchor.objects.end(), object);
+    if (it != anchor.objects.end() && it->x == object.x && it->y == object.y) {
+        anchor.objects.erase(it);
+    }
+}
+
 void Tilemap::set_tile(int x, int y, TileType type) {
     // Check bounds
     if (x < 0 || x >= width_ || y < 0 || y >= height_) {
         return;
     }
     
-    // For large tiles (like trees), make sure we have space
+    // Objects need their whole footprint inside the map; everything else is 1x1
+    bool is_object = has_tile_flag(type, TILE_FLAG_OBJECT);
     const TileProperties& props = get_tile_properties(type);
-    if (props.is_large) {
-        // Check if we have enough space
-        for (int dy = 0; dy < props.height_in_tiles; dy++) {
-            for (int dx = 0; dx < props.width_in_tiles; dx++) {
-                int check_x = x + dx;
-                int check_y = y + dy;
-                
-                // Skip if out of bounds
-                if (check_x >= width_ || check_y >= height_) {
-                    return;
-                }
-                
-                // For large tiles, only set the top-left tile to the actual type
-                // The other tiles in the area will be set to NONE to mark them as "occupied"
-                if (dx == 0 && dy == 0) {
-                    tiles_[check_y * width_ + check_x] = type;
-                } else {
-                    tiles_[check_y * width_ + check_x] = TileType::NONE;
-                }
+    int w = is_object ? props.width_in_tiles : 1;
+    int h = is_object ? props.height_in_tiles : 1;
+    if (x + w > width_ || y + h > height_) {
+        return;
+    }
+    
+    // Whatever covers the footprint is replaced; walkability changes over
+    // the new footprint and every footprint it displaces
+    int min_x = x, min_y = y, max_x = x + w - 1, max_y = y + h - 1;
+    for (int dy = 0; dy < h; dy++) {
+        for (int dx = 0; dx < w; dx++) {
+            ChunkObject displaced;
+            if (get_object_at(x + dx, y + dy, displaced)) {
+                remove_object(displaced);
+                min_x = std::min(min_x, displaced.x);
+                min_y = std::min(min_y, displaced.y);
+                max_x = std::max(max_x, displaced.x + displaced.width - 1);
+                max_y = std::max(max_y, displaced.y + displaced.height - 1);
             }
         }
+    }
+    
+    if (is_object) {
+        add_object(x, y, type);
     } else {
-        // Regular 1x1 tile
-        tiles_[y * width_ + x] = type;
+        write_ground(x, y, type);
+    }
+    
+    // Keep the walkability bitmap and cost grid in sync
+    refresh_walk_bits(min_x, min_y, max_x, max_y);
+    if (on_tiles_changed_) {
+        on_tiles_changed_(min_x, min_y, max_x, max_y);
     }
 }
 
@@ -133,47 +464,127 @@ TileType Tilemap::get_tile(int x, int y) const {
         return TileType::NONE;
     }
     
-    return tiles_[y * width_ + x];
+    return chunk_for_tile(x, y).tile((y & CHUNK_MASK) * CHUNK_SIZE + (x & CHUNK_MASK));
+}
+
+TileType Tilemap::get_ground(int x, int y) const {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_) {
+        return TileType::NONE;
+    }
+    
+    return chunk_for_tile(x, y).at(x & CHUNK_MASK, y & CHUNK_MASK);
+}
+
+bool Tilemap::get_object_at(int x, int y, ChunkObject& out_object) const {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_) {
+        return false;
+    }
+    
+    const CellRef& ref = chunk_for_tile(x, y).cover[(y & CHUNK_MASK) * CHUNK_SIZE + (x & CHUNK_MASK)];
+    if (ref.type == TileType::NONE) {
+        return false;
+    }
+    
+    const TileProperties& props = tile_properties(ref.type);
+    int anchor_y = y - ref.dy();
+    out_object = { anchor_y + props.height_in_tiles, x - ref.dx(), anchor_y, ref.type,
+                   static_cast<std::uint8_t>(props.width_in_tiles),
+                   static_cast<std::uint8_t>(props.height_in_tiles) };
+    return true;
 }
 
 bool Tilemap::is_walkable(int x, int y) const {
-    TileType tile = get_tile(x, y);
-    
-    // Special case for NONE - need to check if it's part of a large tile
-    if (tile == TileType::NONE) {
-        // Check surrounding tiles to see if we're part of a large tile
-        for (int dy = -1; dy <= 0; dy++) {
-            for (int dx = -1; dx <= 0; dx++) {
-                int check_x = x + dx;
-                int check_y = y + dy;
-                
-                // Skip if out of bounds
-                if (check_x < 0 || check_x >= width_ || check_y < 0 || check_y >= height_) {
-                    continue;
-                }
-                
-                TileType nearby = tiles_[check_y * width_ + check_x];
-                const TileProperties& props = get_tile_properties(nearby);
-                
-                // If it's a large tile and we're within its bounds, use its walkability
-                if (props.is_large) {
-                    int rel_x = x - check_x;
-                    int rel_y = y - check_y;
-                    
-                    if (rel_x >= 0 && rel_x < props.width_in_tiles && 
-                        rel_y >= 0 && rel_y < props.height_in_tiles) {
-                        return props.walkable;
-                    }
-                }
-            }
-        }
-        
-        // No large tile found, default to true for NONE
+    // Out-of-bounds tiles count as walkable
+    if (static_cast<unsigned>(x) >= static_cast<unsigned>(width_) ||
+        static_cast<unsigned>(y) >= static_cast<unsigned>(height_)) {
+        return true;
+    }
+    
+    return chunk_for_tile(x, y).walkable(x & CHUNK_MASK, y & CHUNK_MASK);
+}
+
+bool Tilemap::blocks_sight(int x, int y) const {
+    if (static_cast<unsigned>(x) >= static_cast<unsigned>(width_) ||
+        static_cast<unsigned>(y) >= static_cast<unsigned>(height_)) {
         return true;
     }
     
-    // Regular tile, use its properties
-    return get_tile_properties(tile).walkable;
+    // Only objects are opaque, and every cell of a footprint refers to its object
+    const CellRef& ref = chunk_for_tile(x, y).cover[(y & CHUNK_MASK) * CHUNK_SIZE + (x & CHUNK_MASK)];
+    return has_tile_flag(ref.type, TILE_FLAG_OPAQUE);
+}
+
+std::uint8_t Tilemap::get_move_cost(int x, int y) const {
+    if (static_cast<unsigned>(x) >= static_cast<unsigned>(width_) ||
+        static_cast<unsigned>(y) >= static_cast<unsigned>(height_)) {
+        return MOVE_COST_BASE;
+    }
+    
+    return chunk_for_tile(x, y).move_costs[(y & CHUNK_MASK) * CHUNK_SIZE + (x & CHUNK_MASK)];
+}
+
+void Tilemap::get_move_costs(int x, int y, int count, std::uint8_t* out_costs) const {
+    if (y < 0 || y >= height_) {
+        std::fill(out_costs, out_costs + count, MOVE_COST_BASE);
+        return;
+    }
+    
+    while (count > 0) {
+        // Left of the map, or the run up to the next chunk edge (or the map's right edge)
+        int run;
+        if (x < 0) {
+            run = std::min(count, -x);
+            std::fill(out_costs, out_costs + run, MOVE_COST_BASE);
+        } else if (x >= width_) {
+            run = count;
+            std::fill(out_costs, out_costs + run, MOVE_COST_BASE);
+        } else {
+            run = std::min({ count, CHUNK_SIZE - (x & CHUNK_MASK), width_ - x });
+            const std::uint8_t* row = &chunk_for_tile(x, y).move_costs[(y & CHUNK_MASK) * CHUNK_SIZE + (x & CHUNK_MASK)];
+            std::copy(row, row + run, out_costs);
+        }
+        x += run;
+        out_costs += run;
+        count -= run;
+    }
+}
+
+std::uint64_t Tilemap::get_walkable_bits(int x, int y) const {
+    // Whole word of one chunk row; ~0 (walkable) outside the map
+    auto row_word = [this](int chunk_x, int y) -> std::uint64_t {
+        if (chunk_x < 0 || chunk_x >= chunks_x_ || y < 0 || y >= height_) {
+            return ~0ull;
+        }
+        return chunk_for_tile(chunk_x << CHUNK_SHIFT, y).walk_bits[y & CHUNK_MASK];
+    };
+    
+    int chunk_x = x >> CHUNK_SHIFT;   // Arithmetic shift floors negative x
+    int offset = x & CHUNK_MASK;
+    std::uint64_t bits = row_word(chunk_x, y) >> offset;
+    if (offset != 0) {
+        bits |= row_word(chunk_x + 1, y) << (CHUNK_SIZE - offset);
+    }
+    return bits;
+}
+
+bool Tilemap::is_row_walkable(int min_x, int max_x, int y) const {
+    for (int x = min_x; x <= max_x; x += 64) {
+        int count = std::min(64, max_x - x + 1);
+        std::uint64_t mask = count == 64 ? ~0ull : ((1ull << count) - 1);
+        if ((get_walkable_bits(x, y) & mask) != mask) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Tilemap::is_rect_walkable(int min_x, int min_y, int max_x, int max_y) const {
+    for (int y = min_y; y <= max_y; y++) {
+        if (!is_row_walkable(min_x, max_x, y)) {
+            return false;
+        }
+    }
+    return true;
 }
 
 bool Tilemap::is_walkable(float world_x, float world_y) const {
@@ -189,118 +600,189 @@ void Tilemap::render(const Rectangle& camera_view) {
     int end_x = std::min(width_, static_cast<int>((camera_view.x + camera_view.width) / tile_size_) + 1);
     int end_y = std::min(height_, static_cast<int>((camera_view.y + camera_view.height) / tile_size_) + 1);
     
-    // STEP 1: Draw the base ground tiles first (GRASS only)
-    for (int y = start_y; y < end_y; y++) {
-        for (int x = start_x; x < end_x; x++) {
-            float draw_x = x * tile_size_;
-            float draw_y = y * tile_size_;
-            
-            // Always draw grass as the base layer
-            DrawTexture(textures_[TileType::GRASS], 
-                       static_cast<int>(draw_x - camera_view.x),
-                       static_cast<int>(draw_y - camera_view.y),
-                       WHITE);
-        }
-    }
+    render_frame_++;
     
-    // STEP 2: Draw all flat terrain tiles on top of grass (WATER, DIRT)
-    for (int y = start_y; y < end_y; y++) {
-        for (int x = start_x; x < end_x; x++) {
-            TileType tile = get_tile(x, y);
-            
-            if (tile == TileType::WATER || tile == TileType::DIRT) {
-                float draw_x = x * tile_size_;
-                float draw_y = y * tile_size_;
+    // STEP 1-2: Draw the ground (grass with flat terrain on top) from per-chunk bakes
+    if (start_x < end_x && start_y < end_y) {
+        int chunk_px = CHUNK_SIZE * tile_size_;
+        int min_cx = start_x >> CHUNK_SHIFT;
+        int min_cy = start_y >> CHUNK_SHIFT;
+        int max_cx = (end_x - 1) >> CHUNK_SHIFT;
+        int max_cy = (end_y - 1) >> CHUNK_SHIFT;
+        
+        for (int cy = min_cy; cy <= max_cy; cy++) {
+            for (int cx = min_cx; cx <= max_cx; cx++) {
+                int base_x = cx << CHUNK_SHIFT;
+                int base_y = cy << CHUNK_SHIFT;
                 
-                DrawTexture(textures_[tile], 
-                           static_cast<int>(draw_x - camera_view.x),
-                           static_cast<int>(draw_y - camera_view.y),
-                           WHITE);
+                GroundBake* bake = ground_bake_for(cy * chunks_x_ + cx);
+                if (!bake) {
+                    // Cache exhausted this frame (very zoomed out view): draw tiles directly
+                    draw_ground(std::max(start_x, base_x), std::max(start_y, base_y),
+                                std::min(end_x, base_x + CHUNK_SIZE) - 1,
+                                std::min(end_y, base_y + CHUNK_SIZE) - 1,
+                                camera_view.x, camera_view.y);
+                    continue;
+                }
+                if (bake->dirty) {
+                    bake_ground(*bake);
+                }
+                
+                // Render textures are stored bottom-up, so flip the source rect.
+                // Edge chunks only use the top-left part of their texture.
+                float used_w = static_cast<float>(std::min(CHUNK_SIZE, width_ - base_x) * tile_size_);
+                float used_h = static_cast<float>(std::min(CHUNK_SIZE, height_ - base_y) * tile_size_);
+                Rectangle source = { 0.0f, chunk_px - used_h, used_w, -used_h };
+                Vector2 position = {
+                    static_cast<float>(static_cast<int>(base_x * tile_size_ - camera_view.x)),
+                    static_cast<float>(static_cast<int>(base_y * tile_size_ - camera_view.y))
+                };
+                DrawTextureRec(bake->target.texture, source, position, WHITE);
             }
         }
     }
     
-    // STEP 3: Prepare a list of objects to be drawn with their y-positions for proper layering
-    struct DrawableObject {
-        TileType type;
-        float x, y;
-        float sort_y; // Y-position for sorting (bottom of object)
-    };
-    std::vector<DrawableObject> objects_to_draw;
-    
-    // Collect all objects that need to be drawn on top
-    for (int y = start_y; y < end_y; y++) {
-        for (int x = start_x; x < end_x; x++) {
-            TileType tile = get_tile(x, y);
-            
-            if (tile == TileType::TREE || tile == TileType::BUSH) {
-                const TileProperties& props = get_tile_properties(tile);
+    // STEP 3: Queue objects for the frame's depth-sorted pass, keyed by bottom edge.
+    // Objects extend right and down from their anchor, so look one footprint up/left,
+    // and only take the part of each chunk's sorted list whose bottom edge can fall in the view.
+    if (start_x < end_x && start_y < end_y) {
+        int min_cx = std::max(0, start_x - MAX_TILE_WIDTH + 1) >> CHUNK_SHIFT;
+        int min_cy = std::max(0, start_y - MAX_TILE_HEIGHT + 1) >> CHUNK_SHIFT;
+        int max_cx = (end_x - 1) >> CHUNK_SHIFT;
+        int max_cy = (end_y - 1) >> CHUNK_SHIFT;
+        auto by_sort_y = [](const ChunkObject& obj, int sort_y) { return obj.sort_y < sort_y; };
+        
+        for (int cy = min_cy; cy <= max_cy; cy++) {
+            for (int cx = min_cx; cx <= max_cx; cx++) {
+                const std::vector<ChunkObject>& objects = get_chunk_objects(cx, cy);
+                auto first = std::lower_bound(objects.begin(), objects.end(), start_y + 1, by_sort_y);
+                auto last = std::lower_bound(first, objects.end(), end_y + MAX_TILE_HEIGHT, by_sort_y);
                 
-                // For large objects, only add them once from their top-left position
-                if (props.is_large) {
-                    // Check if this is the top-left of a large object
-                    bool is_top_left = true;
-                    for (int dy = -1; dy <= 0 && is_top_left; dy++) {
-                        for (int dx = -1; dx <= 0 && is_top_left; dx++) {
-                            if (dx == 0 && dy == 0) continue; // Skip self
-                            
-                            int check_x = x + dx;
-                            int check_y = y + dy;
-                            
-                            // Skip out of bounds
-                            if (check_x < 0 || check_x >= width_ || check_y < 0 || check_y >= height_) {
-                                continue;
-                            }
-                            
-                            if (get_tile(check_x, check_y) == tile) {
-                                is_top_left = false;
-                                break;
-                            }
-                        }
+                for (auto it = first; it != last; ++it) {
+                    const ChunkObject& obj = *it;
+                    if (obj.x + obj.width <= start_x ||
+                        obj.x >= end_x || obj.y >= end_y) {
+                        continue;
                     }
                     
-                    if (is_top_left) {
-                        float draw_x = x * tile_size_;
-                        float draw_y = y * tile_size_;
-                        // Bottom of the object for sorting (bottom of the entire object)
-                        float sort_y = draw_y + (props.height_in_tiles * tile_size_);
-                        
-                        objects_to_draw.push_back({tile, draw_x, draw_y, sort_y});
-                    }
-                } else {
-                    // Regular 1x1 tile
-                    float draw_x = x * tile_size_;
-                    float draw_y = y * tile_size_;
-                    // For 1x1 tiles, sort by bottom edge
-                    float sort_y = draw_y + tile_size_;
-                    
-                    objects_to_draw.push_back({tile, draw_x, draw_y, sort_y});
+                    Vector2 position = {
+                        static_cast<float>(static_cast<int>(obj.x * tile_size_ - camera_view.x)),
+                        static_cast<float>(static_cast<int>(obj.y * tile_size_ - camera_view.y))
+                    };
+                    core::render::submit(core::render::Layer::ENTITIES,
+                                         static_cast<float>(obj.sort_y * tile_size_),
+                                         textures_[tile_index(obj.type)], position, WHITE);
                 }
             }
         }
     }
+}
+
+void Tilemap::cleanup() {
+    // Drop all resident chunks
+    drop_all_chunks();
+    release_ground_bakes();
+    
+    // Unload all textures
+    for (Texture2D& texture : textures_) {
+        if (texture.id != 0) {
+            UnloadTexture(texture);
+        }
+        texture = Texture2D{};
+    }
+}
+
+void Tilemap::draw_ground(int min_x, int min_y, int max_x, int max_y, float origin_x, float origin_y) const {
+    // Base layer: grass under everything
+    const Texture2D& grass = textures_[tile_index(TileType::GRASS)];
+    for (int y = min_y; y <= max_y; y++) {
+        for (int x = min_x; x <= max_x; x++) {
+            DrawTexture(grass,
+                       static_cast<int>(x * tile_size_ - origin_x),
+                       static_cast<int>(y * tile_size_ - origin_y),
+                       WHITE);
+        }
+    }
+    
+    // Flat terrain tiles on top of grass (WATER, DIRT)
+    for (int y = min_y; y <= max_y; y++) {
+        for (int x = min_x; x <= max_x; x++) {
+            TileType tile = get_ground(x, y);
+            if (has_tile_flag(tile, TILE_FLAG_TERRAIN)) {
+                DrawTexture(textures_[tile_index(tile)],
+                           static_cast<int>(x * tile_size_ - origin_x),
+                           static_cast<int>(y * tile_size_ - origin_y),
+                           WHITE);
+            }
+        }
+    }
+}
+
+Tilemap::GroundBake* Tilemap::ground_bake_for(int chunk_index) {
+    GroundBake* victim = nullptr;
+    for (GroundBake& bake : ground_bakes_) {
+        if (bake.chunk_index == chunk_index) {
+            bake.last_drawn = render_frame_;
+            return &bake;
+        }
+        // Least recently drawn slot not already used this frame
+        if (bake.last_drawn != render_frame_ && (!victim || bake.last_drawn < victim->last_drawn)) {
+            victim = &bake;
+        }
+    }
     
-    // STEP 4: Sort objects by their bottom y-coordinate for proper depth layering
-    std::sort(objects_to_draw.begin(), objects_to_draw.end(), 
-             [](const DrawableObject& a, const DrawableObject& b) {
-                 return a.sort_y < b.sort_y;
-             });
+    // Grow until the cache is full, then recycle the stalest slot
+    if (static_cast<int>(ground_bakes_.size()) < max_ground_bakes_) {
+        int chunk_px = CHUNK_SIZE * tile_size_;
+        GroundBake bake;
+        bake.target = LoadRenderTexture(chunk_px, chunk_px);
+        if (bake.target.id == 0) {
+            TraceLog(LOG_WARNING, "Failed to create ground bake texture");
+            return nullptr;
+        }
+        ground_bakes_.push_back(bake);
+        victim = &ground_bakes_.back();
+    }
+    if (!victim) return nullptr;
+    
+    victim->chunk_index = chunk_index;
+    victim->dirty = true;
+    victim->last_drawn = render_frame_;
+    return victim;
+}
+
+void Tilemap::bake_ground(GroundBake& bake) {
+    int chunk_x = bake.chunk_index % chunks_x_;
+    int chunk_y = bake.chunk_index / chunks_x_;
+    int base_x = chunk_x << CHUNK_SHIFT;
+    int base_y = chunk_y << CHUNK_SHIFT;
     
-    // STEP 5: Draw all objects in sorted order
-    for (const auto& obj : objects_to_draw) {
-        DrawTexture(textures_[obj.type], 
-                   static_cast<int>(obj.x - camera_view.x),
-                   static_cast<int>(obj.y - camera_view.y),
-                   WHITE);
+    BeginTextureMode(bake.target);
+    ClearBackground(BLANK);
+    draw_ground(base_x, base_y,
+                std::min(width_, base_x + CHUNK_SIZE) - 1,
+                std::min(height_, base_y + CHUNK_SIZE) - 1,
+                static_cast<float>(base_x * tile_size_),
+                static_cast<float>(base_y * tile_size_));
+    EndTextureMode();
+    
+    bake.dirty = false;
+}
+
+void Tilemap::mark_ground_dirty(int chunk_index) {
+    for (GroundBake& bake : ground_bakes_) {
+        if (bake.chunk_index == chunk_index) {
+            bake.dirty = true;
+            return;
+        }
     }
 }
 
-void Tilemap::cleanup() {
-    // Unload all textures
-    for (auto& pair : textures_) {
-        UnloadTexture(pair.second);
+void Tilemap::release_ground_bakes() {
+    for (GroundBake& bake : ground_bakes_) {
+        UnloadRenderTexture(bake.target);
     }
-    textures_.clear();
+    ground_bakes_.clear();
 }
 
 Vector2 Tilemap::world_to_tile(float world_x, float world_y) const {
@@ -318,24 +800,9 @@ Vector2 Tilemap::tile_to_world(int tile_x, int tile_y) const {
 }
 
 const TileProperties& Tilemap::get_tile_properties(TileType type) const {
-    auto it = properties_.find(type);
-    if (it != properties_.end()) {
-        return it->second;
-    }
-    
-    // Default empty property as fallback
-    static const TileProperties empty_props = { true, false, 1, 1 };
-    return empty_props;
-}
-
-void Tilemap::init_properties() {
-    // Initialize properties for each tile type
-    properties_[TileType::NONE] = { true, false, 1, 1 };
-    properties_[TileType::GRASS] = { true, false, 1, 1 };
-    properties_[TileType::DIRT] = { true, false, 1, 1 };
-    properties_[TileType::WATER] = { false, false, 1, 1 };
-    properties_[TileType::TREE] = { false, true, 2, 2 };
-    properties_[TileType::BUSH] = { false, false, 1, 1 };
+    // Direct table index; unknown values fall back to the empty tile
+    size_t index = tile_index(type);
+    return index < TILE_TYPE_COUNT ? TILE_PROPERTIES[index] : TILE_PROPERTIES[0];
 }
 
 } // namespace atoms
@@ -1,83 +1,230 @@
 /// tilemap.hpp — tilemap atom for world slice
 #pragma once
 #include <raylib.h>
+#include <array>
 #include <vector>
 #include <string>
+#include <memory>
 #include <unordered_map>
+#include "tile_types.hpp"
+#include "tile_chunk.hpp"
 
 namespace world {
 namespace atoms {
 
-// Tile types
-enum class TileType {
-    NONE,     // Empty/no tile
-    GRASS,    // Walkable grass
-    DIRT,     // Walkable dirt path
-    WATER,    // Non-walkable water
-    TREE,     // Non-walkable tree (2x2 tile)
-    BUSH      // Non-walkable bush
-};
-
-// Tile properties
-struct TileProperties {
-    bool walkable;       // Can player walk on this tile?
-    bool is_large;       // Is this a larger than 1x1 tile (like tree)?
-    int width_in_tiles;  // Width in tile units
-    int height_in_tiles; // Height in tile units
-};
-
-// Tilemap handles loading, rendering, and collision for tiles
+// Tilemap handles loading, rendering, and collision for tiles.
+// Tiles live in CHUNK_SIZE x CHUNK_SIZE chunks held in a chunk table; only
+// chunks near the camera (plus any touched by queries) stay resident, so the
+// map size is bounded by the chunk table rather than by tile memory.
 class Tilemap {
 public:
     // Initialize the tilemap
     void init(int map_width, int map_height, int tile_size);
-    
+
     // Load tile textures
     bool load_textures();
-    
+
     // Generate a simple demo map
     void generate_demo_map();
-    
-    // Set a tile at position
+
+    // Set where never-edited chunks come from (defaults to all NONE).
+    // peek_source reads a chunk without side effects, for resolving the edges
+    // of a neighbour that is paged in (defaults to source); it must give the
+    // same tiles. Drops every resident chunk and saved edit.
+    void set_chunk_source(ChunkSource source, ChunkSource peek_source = nullptr);
+
+    // Set a tile at position. Objects (TREE, BUSH) go in the object layer and
+    // replace any object overlapping their footprint; other types set the ground.
+    // Anything covering the written cell is removed first.
     void set_tile(int x, int y, TileType type);
-    
-    // Get tile at position
+
+    // Get tile at position: the object type at an object's anchor, NONE over
+    // the rest of its footprint, otherwise the ground tile
     TileType get_tile(int x, int y) const;
-    
-    // Check if position is walkable
+
+    // Ground layer only (NONE under objects)
+    TileType get_ground(int x, int y) const;
+
+    // Object covering a tile, anchor and footprint included; false if none
+    // PERF: O(1) through the cell's CellRef, independent of footprint size
+    bool get_object_at(int x, int y, ChunkObject& out_object) const;
+
+    // Check if position is walkable (out-of-bounds tiles count as walkable)
+    // PERF: O(1) bit test in the chunk's walkability bitmap
     bool is_walkable(int x, int y) const;
     bool is_walkable(float world_x, float world_y) const;
-    
-    // Render the visible portion of the tilemap
+
+    // Check if an object covering the tile blocks line of sight (tiles
+    // outside the map do)
+    // PERF: O(1) through the cell's CellRef
+    bool blocks_sight(int x, int y) const;
+
+    // Move cost of a tile (MOVE_COST_BASE on open ground, 0 if blocked;
+    // out-of-bounds tiles cost MOVE_COST_BASE, like their walkability)
+    // PERF: O(1) read from the chunk's packed cost grid
+    std::uint8_t get_move_cost(int x, int y) const;
+
+    // Move costs of count tiles of row y starting at tile x, a chunk row
+    // segment at a time
+    void get_move_costs(int x, int y, int count, std::uint8_t* out_costs) const;
+
+    // 64 walkability bits of row y starting at tile x (bit i = tile x + i)
+    std::uint64_t get_walkable_bits(int x, int y) const;
+
+    // Check that every tile in the inclusive range is walkable, 64 tiles per word
+    bool is_row_walkable(int min_x, int max_x, int y) const;
+    bool is_rect_walkable(int min_x, int min_y, int max_x, int max_y) const;
+
+    // Load chunks around the camera view and evict far ones over budget.
+    // PERF: O(chunks in window) per call, plus one source fill per page-in
+    void update_streaming(const Rectangle& camera_view);
+
+    // Maximum number of resident chunks kept outside the camera window
+    void set_streaming_budget(int max_resident_chunks) { max_resident_chunks_ = max_resident_chunks; }
+
+    // Number of chunks around the visible ones kept loaded
+    void set_streaming_margin(int margin_chunks) { stream_margin_ = margin_chunks; }
+
+    // Chunk lifecycle notifications. Chunks paged in only by queries are not
+    // active; a chunk activates the first time update_streaming covers it and
+    // stays active until it is evicted (or dropped by set_chunk_source/cleanup).
+    void set_chunk_activated_callback(ChunkEventCallback callback) { on_chunk_activated_ = std::move(callback); }
+    void set_chunk_evicted_callback(ChunkEventCallback callback) { on_chunk_evicted_ = std::move(callback); }
+
+    // Called by update_streaming for each chunk in the ring just outside the
+    // window that is neither resident nor saved, so a source can prepare it early
+    void set_chunk_prefetch_callback(ChunkEventCallback callback) { on_chunk_prefetch_ = std::move(callback); }
+
+    // Called after set_tile with the tiles it touched (the whole map when the
+    // chunk source changes), so caches derived from walkability can be dropped
+    void set_tiles_changed_callback(TileRangeCallback callback) { on_tiles_changed_ = std::move(callback); }
+
+    // Render the visible portion of the tilemap: ground is drawn immediately,
+    // objects are submitted to core::render and drawn when the queue is flushed
+    // PERF: ground layers come from per-chunk baked textures, one quad per visible chunk;
+    // objects come from binary-searched ranges of each chunk's pre-sorted list
     void render(const Rectangle& camera_view);
-    
+
+    // Maximum number of chunk ground bakes kept (each is one chunk-sized render texture)
+    void set_ground_cache_size(int max_bakes) { max_ground_bakes_ = max_bakes; }
+
     // Clean up resources
     void cleanup();
-    
+
     // Get tile properties
+    // PERF: O(1) index into the constexpr TILE_PROPERTIES table
     const TileProperties& get_tile_properties(TileType type) const;
-    
+
     // Convert world coordinates to tile coordinates and vice versa
     Vector2 world_to_tile(float world_x, float world_y) const;
     Vector2 tile_to_world(int tile_x, int tile_y) const;
-    
+
     // Map dimensions
     int get_width() const { return width_; }
     int get_height() const { return height_; }
     int get_tile_size() const { return tile_size_; }
-    
+
+    // Chunk table dimensions and residency
+    int get_chunks_x() const { return chunks_x_; }
+    int get_chunks_y() const { return chunks_y_; }
+    int get_resident_chunk_count() const { return static_cast<int>(resident_.size()); }
+    bool is_chunk_resident(int chunk_x, int chunk_y) const;
+
+    // Objects anchored in a chunk, sorted by bottom edge (pages the chunk in)
+    const std::vector<ChunkObject>& get_chunk_objects(int chunk_x, int chunk_y) const;
+
 private:
-    std::vector<TileType> tiles_;
-    std::unordered_map<TileType, Texture2D> textures_;
-    std::unordered_map<TileType, TileProperties> properties_;
-    
+    // Chunk table (nullptr = not resident); mutable so const queries can page in
+    mutable std::vector<std::unique_ptr<TileChunk>> chunks_;
+    mutable std::vector<int> resident_;   // Indices of resident chunks
+
+    // Tiles of edited chunks that were evicted, keyed by chunk index
+    mutable std::unordered_map<int, std::vector<TileType>> saved_chunks_;
+    ChunkSource source_;
+    ChunkSource peek_source_;
+    ChunkEventCallback on_chunk_activated_;
+    ChunkEventCallback on_chunk_evicted_;
+    ChunkEventCallback on_chunk_prefetch_;
+    TileRangeCallback on_tiles_changed_;
+
+    // Source output for one non-resident chunk, used to resolve chunk edges
+    mutable std::vector<TileType> peek_cache_;
+    mutable int peek_cache_index_ = -1;
+
+    // Textures indexed by TileType (id 0 = not loaded)
+    std::array<Texture2D, TILE_TYPE_COUNT> textures_ = {};
+
     int width_ = 0;
     int height_ = 0;
     int tile_size_ = 32;
-    
-    // Initialize tile properties
-    void init_properties();
+    int chunks_x_ = 0;
+    int chunks_y_ = 0;
+
+    // Streaming state
+    std::uint32_t stream_frame_ = 0;
+    int max_resident_chunks_ = 64;
+    int stream_margin_ = 1;
+
+    // Grass and flat terrain of one chunk baked into a render texture
+    struct GroundBake {
+        int chunk_index = -1;            // Chunk this slot holds, -1 = free
+        bool dirty = true;               // Tiles changed since the last bake
+        std::uint32_t last_drawn = 0;    // Render frame this slot was last drawn
+        RenderTexture2D target = {};
+    };
+    std::vector<GroundBake> ground_bakes_;
+    int max_ground_bakes_ = 9;
+    std::uint32_t render_frame_ = 0;
+
+    // Get the chunk holding tile (x, y), paging it in if needed (tile must be in bounds)
+    TileChunk& chunk_for_tile(int x, int y) const;
+
+    // Page a chunk in from saved edits or the chunk source
+    TileChunk& load_chunk(int chunk_x, int chunk_y) const;
+
+    // Write one ground tile and mark its chunk as edited (tile must be in bounds)
+    void write_ground(int x, int y, TileType type);
+
+    // Place / remove an object: footprint refs, the anchor chunk's sorted list,
+    // and NONE ground under a placed footprint (footprint must be in bounds)
+    void add_object(int x, int y, TileType type);
+    void remove_object(const ChunkObject& object);
+
+    // Split a freshly loaded chunk's single-layer tiles into ground, objects
+    // and cell refs, including footprints reaching in from neighbours
+    void build_layers(TileChunk& chunk) const;
+
+    // Drop a resident chunk, saving its tiles if it was edited
+    void evict_chunk(int index);
+
+    // Drop every resident chunk without saving edits
+    void drop_all_chunks();
+
+    // Read a tile without paging its chunk in (resident, saved or source)
+    TileType peek_tile(int x, int y) const;
+
+    // Type that decides a cell's walkability and cost: its covering object, else its ground tile
+    static TileType resolve_type(const TileChunk& chunk, int local);
+
+    // Draw grass then flat terrain for an inclusive tile range, offset by (origin_x, origin_y) pixels
+    void draw_ground(int min_x, int min_y, int max_x, int max_y, float origin_x, float origin_y) const;
+
+    // Find or claim the bake slot for a chunk (nullptr if every slot is in use this frame)
+    GroundBake* ground_bake_for(int chunk_index);
+
+    // Re-draw a chunk's ground layers into its bake slot
+    void bake_ground(GroundBake& bake);
+
+    // Flag a chunk's bake (if any) for re-baking on next render
+    void mark_ground_dirty(int chunk_index);
+
+    // Unload every bake render texture
+    void release_ground_bakes();
+
+    // Recompute walkability bits and move costs for a whole chunk or an inclusive tile range
+    void build_walk_bits(TileChunk& chunk) const;
+    void refresh_walk_bits(int min_x, int min_y, int max_x, int max_y);
 };
 
 } // namespace atoms
-} // namespace world 
\ No newline at end of file
+} // namespace world
@@ -0,0 +1,353 @@
+/// world_generator.cpp — implementation of the procedural chunk generation atom
+#include "world_generator.hpp"
+#include <algorithm>
+#include <array>
+
+namespace world {
+namespace atoms {
+
+namespace {
+    // Noise channels; each rule reads its own field so they stay independent
+    enum Salt : std::uint32_t {
+        SALT_ROCK = 1,
+        SALT_RUIN,
+        SALT_TEMPERATURE,
+        SALT_ROAD,
+        SALT_WATER,
+        SALT_GROVE,
+        SALT_WALL,
+        SALT_TREE,
+        SALT_BUSH,
+    };
+
+    // Integer hash of a lattice point; the only source of randomness, so
+    // every value depends on (seed, x, y) alone
+    std::uint32_t hash(std::uint32_t seed, std::uint32_t salt, int x, int y) {
+        std::uint32_t h = seed ^ (salt * 0x9E3779B9u);
+        h ^= static_cast<std::uint32_t>(x) * 0x85EBCA6Bu;
+        h = (h << 13) | (h >> 19);
+        h ^= static_cast<std::uint32_t>(y) * 0xC2B2AE35u;
+        h ^= h >> 16;
+        h *= 0x7FEB352Du;
+        h ^= h >> 15;
+        h *= 0x846CA68Bu;
+        h ^= h >> 16;
+        return h;
+    }
+
+    float hash_unit(std::uint32_t seed, std::uint32_t salt, int x, int y) {
+        return static_cast<float>(hash(seed, salt, x, y) >> 8) * (1.0f / 16777216.0f);
+    }
+
+    int floor_div(int value, int divisor) {
+        int q = value / divisor;
+        return (value % divisor != 0 && value < 0) ? q - 1 : q;
+    }
+
+    // Value noise over a lattice of `period` tiles, in [0, 1)
+    float value_noise(std::uint32_t seed, std::uint32_t salt, int x, int y, int period) {
+        int cell_x = floor_div(x, period);
+        int cell_y = floor_div(y, period);
+        float fx = static_cast<float>(x - cell_x * period) / period;
+        float fy = static_cast<float>(y - cell_y * period) / period;
+        fx = fx * fx * (3.0f - 2.0f * fx);
+        fy = fy * fy * (3.0f - 2.0f * fy);
+
+        float a = hash_unit(seed, salt, cell_x, cell_y);
+        float b = hash_unit(seed, salt, cell_x + 1, cell_y);
+        float c = hash_unit(seed, salt, cell_x, cell_y + 1);
+        float d = hash_unit(seed, salt, cell_x + 1, cell_y + 1);
+        float top = a + (b - a) * fx;
+        float bottom = c + (d - c) * fx;
+        return top + (bottom - top) * fy;
+    }
+
+    // Three octaves, coarsest first
+    float fbm(std::uint32_t seed, std::uint32_t salt, int x, int y, int period) {
+        return value_noise(seed, salt, x, y, period) * 0.5f +
+               value_noise(seed, salt + 100, x, y, std::max(1, period / 2)) * 0.3f +
+               value_noise(seed, salt + 200, x, y, std::max(1, period / 4)) * 0.2f;
+    }
+
+    // Placement rules per biome; densities are chances per candidate tile
+    struct BiomeRules {
+        TileType ground;
+        float water_level;     // Water where the water field exceeds this
+        float tree_chance;     // Per even anchor, scaled by the grove field
+        float bush_chance;
+        float wall_chance;     // Bush chance on wall tiles (cave rock, ruin walls)
+    };
+
+    constexpr std::array<BiomeRules, static_cast<std::size_t>(Biome::COUNT)> BIOME_RULES = {{
+        /* FOREST */ { TileType::GRASS, 0.70f, 0.45f, 0.04f, 0.00f },
+        /* CAVE   */ { TileType::DIRT,  0.76f, 0.00f, 0.03f, 0.90f },
+        /* DESERT */ { TileType::DIRT,  0.80f, 0.02f, 0.01f, 0.00f },
+        /* SNOW   */ { TileType::GRASS, 0.66f, 0.12f, 0.01f, 0.00f },
+        /* RUINS  */ { TileType::DIRT,  0.76f, 0.03f, 0.02f, 0.75f },
+    }};
+
+    const BiomeRules& rules_for(Biome biome) {
+        return BIOME_RULES[static_cast<std::size_t>(biome)];
+    }
+
+    constexpr int RUIN_GRID = 12;          // Ruin walls run along every 12th row and column
+    constexpr float SHORE_BAND = 0.02f;    // Shallows where the water field is this close below the water level
+    constexpr int APRON = 2;               // Cells computed around a chunk for objects crossing its edges
+    constexpr int GRID_SIZE = CHUNK_SIZE + APRON * 2;
+}
+
+WorldGenerator::~WorldGenerator() {
+    stop();
+}
+
+void WorldGenerator::start(const GeneratorConfig& config, int worker_count) {
+    stop();
+    config_ = config;
+
+    if (worker_count < 0) {
+        worker_count = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    }
+    stopping_ = false;
+    for (int i = 0; i < worker_count; i++) {
+        workers_.emplace_back(&WorldGenerator::worker_loop, this);
+    }
+}
+
+void WorldGenerator::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+    queue_.clear();
+    pending_.clear();
+    ready_.clear();
+    ready_order_.clear();
+}
+
+std::uint64_t WorldGenerator::chunk_key(int chunk_x, int chunk_y) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunk_y)) << 32) |
+           static_cast<std::uint32_t>(chunk_x);
+}
+
+Biome WorldGenerator::biome_at(int x, int y) const {
+    std::uint32_t seed = config_.seed;
+    if (fbm(seed, SALT_ROCK, x, y, 128) > 0.64f) return Biome::CAVE;
+    if (value_noise(seed, SALT_RUIN, x, y, 96) > 0.80f) return Biome::RUINS;
+
+    float temperature = fbm(seed, SALT_TEMPERATURE, x, y, 256);
+    if (temperature < 0.40f) return Biome::SNOW;
+    if (temperature > 0.60f) return Biome::DESERT;
+    return Biome::FOREST;
+}
+
+bool WorldGenerator::in_clearing(int x, int y) const {
+    return x >= config_.clearing_x && x < config_.clearing_x + config_.clearing_w &&
+           y >= config_.clearing_y && y < config_.clearing_y + config_.clearing_h;
+}
+
+WorldGenerator::Cell WorldGenerator::cell_at(int x, int y) const {
+    if (x < 0 || y < 0 || x >= config_.width || y >= config_.height) {
+        return { Biome::FOREST, TileType::NONE, false };
+    }
+
+    Biome biome = biome_at(x, y);
+    const BiomeRules& rules = rules_for(biome);
+    if (in_clearing(x, y)) {
+        return { biome, rules.ground, false };
+    }
+
+    // Roads follow a thin contour of one field and cut through every biome
+    float road = fbm(config_.seed, SALT_ROAD, x, y, 64);
+    if (road > 0.49f && road < 0.51f) {
+        return { biome, TileType::DIRT, false };
+    }
+    float water = fbm(config_.seed, SALT_WATER, x, y, 32);
+    if (water > rules.water_level) {
+        return { biome, TileType::WATER, false };
+    }
+    if (water > rules.water_level - SHORE_BAND) {
+        return { biome, TileType::SHALLOWS, false };
+    }
+    return { biome, rules.ground, true };
+}
+
+void WorldGenerator::generate_chunk(int chunk_x, int chunk_y, TileType* out_tiles) const {
+    const std::uint32_t seed = config_.seed;
+    const int base_x = chunk_x << CHUNK_SHIFT;
+    const int base_y = chunk_y << CHUNK_SHIFT;
+
+    // Terrain for the chunk plus an apron, so objects whose footprints cross
+    // the chunk edge are decided exactly as the neighbouring chunk decides them
+    std::vector<Cell> grid(GRID_SIZE * GRID_SIZE);
+    for (int gy = 0; gy < GRID_SIZE; gy++) {
+        for (int gx = 0; gx < GRID_SIZE; gx++) {
+            grid[gy * GRID_SIZE + gx] = cell_at(base_x + gx - APRON, base_y + gy - APRON);
+        }
+    }
+    auto cell = [&](int x, int y) -> const Cell& {
+        return grid[(y - base_y + APRON) * GRID_SIZE + (x - base_x + APRON)];
+    };
+
+    // Trees anchor on even tiles only, so 2x2 footprints can never overlap
+    auto tree_at = [&](int x, int y) {
+        if (!cell(x, y).open || !cell(x + 1, y).open || !cell(x, y + 1).open || !cell(x + 1, y + 1).open) {
+            return false;
+        }
+        float grove = fbm(seed, SALT_GROVE, x, y, 32) * 2.0f;
+        return hash_unit(seed, SALT_TREE, x, y) < rules_for(cell(x, y).biome).tree_chance * grove;
+    };
+
+    auto bush_at = [&](int x, int y) {
+        const Cell& here = cell(x, y);
+        if (!here.open || tree_at(x & ~1, y & ~1)) return false;
+
+        const BiomeRules& rules = rules_for(here.biome);
+        float chance = rules.bush_chance;
+        if (here.biome == Biome::CAVE && fbm(seed, SALT_WALL, x, y, 16) > 0.55f) {
+            chance = rules.wall_chance;      // Rock masses
+        } else if (here.biome == Biome::RUINS &&
+                   ((x % RUIN_GRID == 0) || (y % RUIN_GRID == 0)) &&
+                   value_noise(seed, SALT_WALL, x, y, 4) > 0.35f) {
+            chance = rules.wall_chance;      // Broken walls with gaps
+        }
+        return hash_unit(seed, SALT_BUSH, x, y) < chance;
+    };
+
+    for (int ly = 0; ly < CHUNK_SIZE; ly++) {
+        for (int lx = 0; lx < CHUNK_SIZE; lx++) {
+            out_tiles[ly * CHUNK_SIZE + lx] = cell(base_x + lx, base_y + ly).ground;
+        }
+    }
+
+    // Same convention as Tilemap::set_tile: type at the anchor, NONE over the rest
+    auto stamp = [&](int x, int y, TileType type) {
+        const TileProperties& props = tile_properties(type);
+        for (int dy = 0; dy < props.height_in_tiles; dy++) {
+            for (int dx = 0; dx < props.width_in_tiles; dx++) {
+                int lx = x + dx - base_x;
+                int ly = y + dy - base_y;
+                if (lx < 0 || ly < 0 || lx >= CHUNK_SIZE || ly >= CHUNK_SIZE) continue;
+                out_tiles[ly * CHUNK_SIZE + lx] = (dx == 0 && dy == 0) ? type : TileType::NONE;
+            }
+        }
+    };
+
+    // Anchors start one tile up/left so trees reaching in from neighbours are stamped
+    for (int y = base_y - 1; y < base_y + CHUNK_SIZE; y++) {
+        for (int x = base_x - 1; x < base_x + CHUNK_SIZE; x++) {
+            bool even = ((x | y) & 1) == 0;
+            if (even && tree_at(x, y)) {
+                stamp(x, y, TileType::TREE);
+            } else if (x >= base_x && y >= base_y && bush_at(x, y)) {
+                stamp(x, y, TileType::BUSH);
+            }
+        }
+    }
+}
+
+void WorldGenerator::generate_chunks(const std::vector<std::pair<int, int>>& coords,
+                                     std::vector<TileType>& out, int worker_count) const {
+    out.resize(coords.size() * CHUNK_AREA);
+    worker_count = std::max(1, std::min(worker_count, static_cast<int>(coords.size())));
+
+    // Interleaved split; each chunk writes only its own slice of out
+    auto run = [&](int first) {
+        for (std::size_t i = first; i < coords.size(); i += worker_count) {
+            generate_chunk(coords[i].first, coords[i].second, out.data() + i * CHUNK_AREA);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < worker_count; i++) {
+        threads.emplace_back(run, i);
+    }
+    run(0);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void WorldGenerator::prefetch(int chunk_x, int chunk_y) {
+    if (workers_.empty()) return;
+    std::uint64_t key = chunk_key(chunk_x, chunk_y);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (ready_.count(key) || !pending_.insert(key).second) return;
+        queue_.push_back(key);
+    }
+    wake_.notify_one();
+}
+
+bool WorldGenerator::take_ready(int chunk_x, int chunk_y, TileType* out_tiles) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = ready_.find(chunk_key(chunk_x, chunk_y));
+    if (found == ready_.end()) return false;
+
+    std::copy(found->second.begin(), found->second.end(), out_tiles);
+    ready_order_.erase(std::find(ready_order_.begin(), ready_order_.end(), found->first));
+    ready_.erase(found);
+    return true;
+}
+
+bool WorldGenerator::peek_ready(int chunk_x, int chunk_y, TileType* out_tiles) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = ready_.find(chunk_key(chunk_x, chunk_y));
+    if (found == ready_.end()) return false;
+
+    std::copy(found->second.begin(), found->second.end(), out_tiles);
+    return true;
+}
+
+void WorldGenerator::worker_loop() {
+    std::vector<TileType> tiles(CHUNK_AREA);
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        wake_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+        if (stopping_) return;
+
+        std::uint64_t key = queue_.front();
+        queue_.pop_front();
+
+        // Generate outside the lock; generation only reads config_
+        lock.unlock();
+        int chunk_x = static_cast<std::int32_t>(static_cast<std::uint32_t>(key));
+        int chunk_y = static_cast<std::int32_t>(static_cast<std::uint32_t>(key >> 32));
+        generate_chunk(chunk_x, chunk_y, tiles.data());
+        lock.lock();
+
+        pending_.erase(key);
+        ready_[key] = tiles;
+        ready_order_.push_back(key);
+
+        // Chunks prefetched but never paged in are dropped oldest first
+        while (ready_order_.size() > MAX_READY_CHUNKS) {
+            ready_.erase(ready_order_.front());
+            ready_order_.pop_front();
+        }
+    }
+}
+
+ChunkSource WorldGenerator::make_chunk_source() {
+    return [this](int chunk_x, int chunk_y, TileType* out_tiles) {
+        if (!take_ready(chunk_x, chunk_y, out_tiles)) {
+            generate_chunk(chunk_x, chunk_y, out_tiles);
+        }
+    };
+}
+
+ChunkSource WorldGenerator::make_peek_source() {
+    return [this](int chunk_x, int chunk_y, TileType* out_tiles) {
+        if (!peek_ready(chunk_x, chunk_y, out_tiles)) {
+            generate_chunk(chunk_x, chunk_y, out_tiles);
+        }
+    };
+}
+
+} // namespace atoms
+} // namespace world
@@ -0,0 +1,127 @@
+/// world_generator.hpp — procedural chunk generation atom for world slice
+#pragma once
+#include "tile_types.hpp"
+#include "tile_chunk.hpp"
+#include "features/enemies/types.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace world {
+namespace atoms {
+
+// Biome regions, one per EnemyID region prefix (WORLDBUILDING.MD §5.3)
+enum class Biome : std::uint8_t {
+    FOREST,   // FOR_*: grass, dense trees, ponds
+    CAVE,     // CAV_*: dirt floor walled in by rock (bushes)
+    DESERT,   // DES_*: open dirt, rare oases
+    SNOW,     // SNW_*: grass with sparse trees and frozen lakes
+    RUINS,    // RUN_*: dirt courtyards with broken walls
+    COUNT
+};
+
+// Region an enemy belongs to, from its EnemyID prefix
+inline Biome biome_of(enemies::EnemyID id) {
+    switch (id) {
+        case enemies::EnemyID::FOR_SLIME:
+        case enemies::EnemyID::FOR_BOAR:   return Biome::FOREST;
+        case enemies::EnemyID::CAV_BAT:    return Biome::CAVE;
+        case enemies::EnemyID::DES_SCARAB: return Biome::DESERT;
+        case enemies::EnemyID::SNW_WOLF:   return Biome::SNOW;
+        case enemies::EnemyID::RUN_DRONE:  return Biome::RUINS;
+    }
+    return Biome::FOREST;
+}
+
+struct GeneratorConfig {
+    std::uint32_t seed = 1;
+    int width = 512;                 // Map size in tiles (nothing is generated outside)
+    int height = 512;
+    int clearing_x = 0;              // Tile rect kept free of water and objects (player start)
+    int clearing_y = 0;
+    int clearing_w = 0;
+    int clearing_h = 0;
+};
+
+// Generates chunks as a pure function of (seed, tile coordinates), so any
+// chunk can be regenerated on demand instead of stored, in any order and on
+// any thread. Worker threads generate prefetched chunks in the background;
+// the chunk source hands those over or generates inline on a miss.
+class WorldGenerator {
+public:
+    WorldGenerator() = default;
+    ~WorldGenerator();
+    WorldGenerator(const WorldGenerator&) = delete;
+    WorldGenerator& operator=(const WorldGenerator&) = delete;
+
+    // Configure and start worker threads (worker_count < 0: hardware threads - 1)
+    void start(const GeneratorConfig& config, int worker_count = -1);
+    void stop();
+
+    const GeneratorConfig& get_config() const { return config_; }
+    int get_worker_count() const { return static_cast<int>(workers_.size()); }
+
+    // Biome of a tile
+    Biome biome_at(int x, int y) const;
+
+    // Fill one chunk (CHUNK_AREA tiles). Pure and thread-safe.
+    // PERF: ~0.5-1ms per chunk (a few noise lookups per tile)
+    void generate_chunk(int chunk_x, int chunk_y, TileType* out_tiles) const;
+
+    // Generate many chunks at once, split across worker_count threads.
+    // out receives coords.size() * CHUNK_AREA tiles in coords order.
+    void generate_chunks(const std::vector<std::pair<int, int>>& coords,
+                         std::vector<TileType>& out, int worker_count) const;
+
+    // Queue a chunk for background generation (ignored if queued or ready)
+    void prefetch(int chunk_x, int chunk_y);
+
+    // Move a finished background chunk out, false if it is not ready
+    bool take_ready(int chunk_x, int chunk_y, TileType* out_tiles);
+
+    // Copy a finished background chunk, leaving it for take_ready
+    bool peek_ready(int chunk_x, int chunk_y, TileType* out_tiles);
+
+    // Chunk source for Tilemap::set_chunk_source; the generator must outlive it
+    ChunkSource make_chunk_source();
+
+    // Peek source to go with it: never consumes a prefetched chunk, so only
+    // paging the chunk in takes it
+    ChunkSource make_peek_source();
+
+private:
+    GeneratorConfig config_;
+
+    // Background generation
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<std::uint64_t> queue_;                                    // Chunk keys to generate
+    std::unordered_set<std::uint64_t> pending_;                          // Queued or being generated
+    std::unordered_map<std::uint64_t, std::vector<TileType>> ready_;     // Finished, not yet taken
+    std::deque<std::uint64_t> ready_order_;                              // Oldest first, bounds ready_
+    bool stopping_ = false;
+
+    static constexpr std::size_t MAX_READY_CHUNKS = 64;
+
+    void worker_loop();
+    static std::uint64_t chunk_key(int chunk_x, int chunk_y);
+
+    // Per-tile terrain before objects are placed
+    struct Cell {
+        Biome biome;
+        TileType ground;
+        bool open;        // Objects may stand here (biome ground, not water/road/clearing)
+    };
+    Cell cell_at(int x, int y) const;
+    bool in_clearing(int x, int y) const;
+};
+
+} // namespace atoms
+} // namespace world
@@ -0,0 +1,97 @@
+/// bench_raycast.cpp — Microbenchmark: 16-ray steering fans, single vs batched raycasts
+///                     vs the per-tile steering table
+///
+/// Not registered with CTest; build and run by hand:
+///   cmake --build build --target bench_raycast && ./build/.../bench_raycast
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "../atoms/obstacle_detector.hpp"
+#include "../atoms/steering_table.hpp"
+#include "../atoms/tilemap.hpp"
+#include "../atoms/world_generator.hpp"
+
+using namespace world::atoms;
+
+namespace {
+    constexpr int FANS = 20000;       // Slimes x frames
+    constexpr int RAYS = 16;
+    constexpr float LOOKAHEAD = 150.0f;
+
+    template <typename Fn>
+    void run(const char* name, Fn&& cast_fan) {
+        auto start = std::chrono::steady_clock::now();
+        double total = 0.0;
+        for (int i = 0; i < FANS; i++) {
+            total += cast_fan(i);
+        }
+        auto end = std::chrono::steady_clock::now();
+        double us = std::chrono::duration<double, std::micro>(end - start).count();
+        std::printf("%-20s %8.3f us/fan  (sum=%.1f)\n", name, us / FANS, total);
+    }
+}
+
+int main() {
+    // A generated world with the usual mix of water, trees and bushes
+    GeneratorConfig config;
+    config.width = CHUNK_SIZE * 4;
+    config.height = CHUNK_SIZE * 4;
+    WorldGenerator generator;
+    generator.start(config, 0);
+
+    Tilemap map;
+    map.init(config.width, config.height, 32);
+    map.set_chunk_source(generator.make_chunk_source());
+    map.set_streaming_budget(64);
+
+    ObstacleDetector detector;
+    detector.init(&map);
+
+    std::vector<Vector2> directions(RAYS);
+    for (int i = 0; i < RAYS; i++) {
+        float angle = i * (2.0f * PI / RAYS);
+        directions[i] = { std::cos(angle), std::sin(angle) };
+    }
+
+    // Open-ground origins only, like live slimes
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> coord(64.0f, config.width * 32.0f - 64.0f);
+    std::vector<Vector2> origins;
+    while (static_cast<int>(origins.size()) < FANS) {
+        Vector2 p = { coord(rng), coord(rng) };
+        if (map.is_walkable(p.x, p.y)) origins.push_back(p);
+    }
+
+    float distances[RAYS];
+    run("raycast x16", [&](int i) {
+        float sum = 0.0f;
+        for (int r = 0; r < RAYS; r++) {
+            RaycastHit hit = detector.raycast(origins[i], directions[r], LOOKAHEAD);
+            sum += hit.hit ? hit.distance : LOOKAHEAD;
+        }
+        return sum;
+    });
+    run("raycast_batch(16)", [&](int i) {
+        detector.raycast_batch(origins[i], directions.data(), RAYS, LOOKAHEAD, distances);
+        float sum = 0.0f;
+        for (float d : distances) sum += d;
+        return sum;
+    });
+    
+    // Every tile is traced on its first query (cold), then read back (warm)
+    SteeringTable table;
+    table.init(&map, &detector, LOOKAHEAD);
+    table.set_page_budget(0);
+    auto read_table = [&](int i) {
+        table.get_distances(origins[i], distances);
+        float sum = 0.0f;
+        for (float d : distances) sum += d;
+        return sum;
+    };
+    run("steering table cold", read_table);
+    run("steering table warm", read_table);
+    return 0;
+}
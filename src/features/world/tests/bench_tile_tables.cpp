@@ -0,0 +1,78 @@
+/// bench_tile_tables.cpp — Microbenchmark: unordered_map vs enum-indexed tile tables
+///
+/// Not registered with CTest; build and run by hand:
+///   cmake --build build --target bench_tile_tables && ./build/.../bench_tile_tables
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "../atoms/tile_types.hpp"
+
+using namespace world::atoms;
+
+namespace {
+    constexpr int TILE_COUNT = 1 << 20;
+    constexpr int ROUNDS = 20;
+
+    // The previous layout: one hash lookup per property query
+    std::unordered_map<TileType, TileProperties> make_map_table() {
+        std::unordered_map<TileType, TileProperties> table;
+        for (size_t i = 0; i < TILE_TYPE_COUNT; i++) {
+            table[static_cast<TileType>(i)] = TILE_PROPERTIES[i];
+        }
+        return table;
+    }
+
+    template <typename Fn>
+    void run(const char* name, Fn&& count_walkable) {
+        auto start = std::chrono::steady_clock::now();
+        long long total = 0;
+        for (int round = 0; round < ROUNDS; round++) {
+            total += count_walkable();
+        }
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        std::printf("%-24s %8.3f ns/tile  (walkable=%lld)\n",
+                    name, ns / (static_cast<double>(TILE_COUNT) * ROUNDS), total / ROUNDS);
+    }
+}
+
+int main() {
+    // Random tiles, weighted towards grass like a real map
+    std::mt19937 rng(1234);
+    std::discrete_distribution<int> pick({0, 70, 10, 8, 4, 8});
+    std::vector<TileType> tiles(TILE_COUNT);
+    for (TileType& tile : tiles) {
+        tile = static_cast<TileType>(pick(rng));
+    }
+
+    auto map_table = make_map_table();
+
+    run("unordered_map", [&]() {
+        long long count = 0;
+        for (TileType tile : tiles) {
+            count += map_table.find(tile)->second.walkable;
+        }
+        return count;
+    });
+
+    run("TILE_PROPERTIES array", [&]() {
+        long long count = 0;
+        for (TileType tile : tiles) {
+            count += tile_properties(tile).walkable;
+        }
+        return count;
+    });
+
+    run("TILE_FLAGS bit test", [&]() {
+        long long count = 0;
+        for (TileType tile : tiles) {
+            count += has_tile_flag(tile, TILE_FLAG_WALKABLE);
+        }
+        return count;
+    });
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+/// test_cluster_graph.cpp — Unit tests for the hierarchical path planning atom
+
+#include <catch2/catch_all.hpp>
+#include "../atoms/cluster_graph.hpp"
+#include "../atoms/flow_field.hpp"
+#include "../atoms/path_search.hpp"
+#include "../atoms/tilemap.hpp"
+#include <algorithm>
+#include <random>
+
+using namespace world::atoms;
+
+namespace {
+    constexpr int MAP_TILES = CHUNK_SIZE * 4;
+
+    void fill_grass(int, int, TileType* out_tiles) {
+        std::fill(out_tiles, out_tiles + CHUNK_AREA, TileType::GRASS);
+    }
+
+    // Grass with scattered water and long walls
+    void fill_walls(int cx, int cy, TileType* out_tiles) {
+        std::mt19937 rng(static_cast<unsigned>(cy * 17 + cx + 3));
+        for (int i = 0; i < CHUNK_AREA; i++) {
+            out_tiles[i] = rng() % 100 < 12 ? TileType::WATER : TileType::GRASS;
+        }
+        for (int run = 0; run < 4; run++) {
+            int x = static_cast<int>(rng() % CHUNK_SIZE);
+            int y = static_cast<int>(rng() % CHUNK_SIZE);
+            for (int i = 0; i < 40; i++) {
+                int tx = run % 2 ? x : std::min(x + i, CHUNK_SIZE - 1);
+                int ty = run % 2 ? std::min(y + i, CHUNK_SIZE - 1) : y;
+                out_tiles[ty * CHUNK_SIZE + tx] = TileType::WATER;
+            }
+        }
+    }
+
+    // Refine every leg inside the box of its two end clusters; total cost or -1
+    int refine_route(const Tilemap& map, const std::vector<TilePoint>& route) {
+        PathSearch search;
+        PathGrid grid;
+        std::vector<TilePoint> waypoints;
+        int total = 0;
+        for (std::size_t i = 1; i < route.size(); i++) {
+            TilePoint a = route[i - 1];
+            TilePoint b = route[i];
+            int min_x = (std::min(a.x, b.x) >> CHUNK_SHIFT) << CHUNK_SHIFT;
+            int min_y = (std::min(a.y, b.y) >> CHUNK_SHIFT) << CHUNK_SHIFT;
+            int max_x = ((std::max(a.x, b.x) >> CHUNK_SHIFT) << CHUNK_SHIFT) + CHUNK_SIZE - 1;
+            int max_y = ((std::max(a.y, b.y) >> CHUNK_SHIFT) << CHUNK_SHIFT) + CHUNK_SIZE - 1;
+            grid.capture(map, min_x, min_y, max_x, max_y);
+            if (!search.find_path(grid, a, b, waypoints)) return -1;
+            for (std::size_t j = 1; j < waypoints.size(); j++) {
+                total += PathSearch::octile_cost(waypoints[j - 1], waypoints[j]);
+            }
+        }
+        return total;
+    }
+}
+
+TEST_CASE("Cluster graph plans long trips", "[world][path][hpa]") {
+    Tilemap map;
+    map.init(MAP_TILES, MAP_TILES, 32);
+    map.set_chunk_source(fill_walls);
+    map.set_streaming_budget(32);
+    ClusterGraph graph;
+    graph.init(&map);
+    map.set_tiles_changed_callback([&graph](int min_x, int min_y, int max_x, int max_y) {
+        graph.invalidate(min_x, min_y, max_x, max_y);
+    });
+    std::vector<TilePoint> route;
+
+    SECTION("Near trips skip the graph") {
+        REQUIRE(graph.plan({ 10, 10 }, { 100, 100 }, route));
+        REQUIRE(route.size() == 2);
+        REQUIRE(graph.get_built_cluster_count() == 0);
+    }
+
+    SECTION("Routes refine to near-shortest paths") {
+        FlowField field;
+        field.init(&map, MAP_TILES);
+        std::mt19937 rng(9);
+        std::uniform_int_distribution<int> tile(0, MAP_TILES - 1);
+        int planned = 0;
+        for (int i = 0; i < 40; i++) {
+            TilePoint start = { tile(rng) % 40, tile(rng) };
+            TilePoint goal = { MAP_TILES - 1 - tile(rng) % 40, tile(rng) };
+            if (!map.is_walkable(start.x, start.y) || !map.is_walkable(goal.x, goal.y)) continue;
+
+            field.set_target(goal.x, goal.y);
+            int shortest = field.get_cost(start.x, start.y);
+            bool ok = graph.plan(start, goal, route);
+            REQUIRE(ok == (shortest >= 0));
+            if (!ok) continue;
+
+            REQUIRE(route.front() == start);
+            REQUIRE(route.back() == goal);
+            REQUIRE(route.size() >= 4);   // At least two chunks crossed
+            int refined = refine_route(map, route);
+            REQUIRE(refined >= shortest);
+            REQUIRE(refined <= shortest * 5 / 4);
+            planned++;
+        }
+        REQUIRE(planned > 20);
+        REQUIRE(graph.get_node_count() > 0);
+    }
+
+    SECTION("Edits rebuild only the clusters they touch") {
+        map.set_chunk_source(fill_grass);
+        REQUIRE(graph.plan({ 5, 5 }, { MAP_TILES - 5, MAP_TILES - 5 }, route));
+        int built = graph.get_built_cluster_count();
+        REQUIRE(built >= 4);
+
+        // Edit inside one built cluster, away from its borders
+        TilePoint inside = route[1];
+        int cx = inside.x >> CHUNK_SHIFT;
+        int cy = inside.y >> CHUNK_SHIFT;
+        map.set_tile(cx * CHUNK_SIZE + 30, cy * CHUNK_SIZE + 30, TileType::WATER);
+        REQUIRE(graph.get_built_cluster_count() == built - 1);
+
+        // Wall off the whole column between the first and second cluster
+        // columns: no route can exist
+        for (int y = 0; y < MAP_TILES; y++) map.set_tile(CHUNK_SIZE - 1, y, TileType::WATER);
+        REQUIRE_FALSE(graph.plan({ 5, 5 }, { MAP_TILES - 5, MAP_TILES - 5 }, route));
+
+        // Reopen one tile: the route goes through it
+        map.set_tile(CHUNK_SIZE - 1, 100, TileType::GRASS);
+        REQUIRE(graph.plan({ 5, 5 }, { MAP_TILES - 5, MAP_TILES - 5 }, route));
+        REQUIRE(std::find(route.begin(), route.end(), TilePoint{ CHUNK_SIZE, 100 }) != route.end());
+        REQUIRE(refine_route(map, route) > 0);
+    }
+}
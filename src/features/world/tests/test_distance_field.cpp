@@ -0,0 +1,129 @@
+/// test_distance_field.cpp — Unit tests for the obstacle distance field atom
+
+#include <catch2/catch_all.hpp>
+#include "../atoms/distance_field.hpp"
+#include "../atoms/obstacle_detector.hpp"
+#include "../atoms/tilemap.hpp"
+#include <cmath>
+#include <random>
+
+using namespace world::atoms;
+using Catch::Approx;
+
+namespace {
+    // Grass with a scatter of water tiles, denser in some chunks than others
+    void fill_scattered(int cx, int cy, TileType* out_tiles) {
+        std::mt19937 rng(static_cast<unsigned>(cy * 31 + cx));
+        int per_mille = 4 + 25 * ((cx + cy) % 3);
+        for (int i = 0; i < CHUNK_AREA; i++) {
+            out_tiles[i] = static_cast<int>(rng() % 1000) < per_mille ? TileType::WATER : TileType::GRASS;
+        }
+    }
+
+    // Reference clearance: every blocked tile in the map as a square
+    float brute_clearance(const Tilemap& map, Vector2 p, float max_distance) {
+        float ts = static_cast<float>(map.get_tile_size());
+        float best = max_distance;
+        for (int y = 0; y < map.get_height(); y++) {
+            for (int x = 0; x < map.get_width(); x++) {
+                if (map.is_walkable(x, y)) continue;
+                float gx = std::max(std::max(x * ts - p.x, p.x - (x + 1) * ts), 0.0f);
+                float gy = std::max(std::max(y * ts - p.y, p.y - (y + 1) * ts), 0.0f);
+                best = std::min(best, std::sqrt(gx * gx + gy * gy));
+            }
+        }
+        return best;
+    }
+
+    float brute_tile_distance(const Tilemap& map, int tx, int ty) {
+        int best = -1;
+        for (int y = ty - DistanceField::MAX_TILES; y <= ty + DistanceField::MAX_TILES; y++) {
+            for (int x = tx - DistanceField::MAX_TILES; x <= tx + DistanceField::MAX_TILES; x++) {
+                if (x < 0 || x >= map.get_width() || y < 0 || y >= map.get_height()) continue;
+                if (map.is_walkable(x, y)) continue;
+                int d = (x - tx) * (x - tx) + (y - ty) * (y - ty);
+                if (d <= DistanceField::MAX_TILES * DistanceField::MAX_TILES && (best < 0 || d < best)) best = d;
+            }
+        }
+        return best < 0 ? -1.0f : std::sqrt(static_cast<float>(best));
+    }
+
+    void require_matches_brute_force(Tilemap& map, DistanceField& field, std::mt19937& rng) {
+        for (int y = 0; y < map.get_height(); y += 3) {
+            for (int x = 0; x < map.get_width(); x += 5) {
+                REQUIRE(field.get_tile_distance(x, y) == brute_tile_distance(map, x, y));
+            }
+        }
+
+        float extent = static_cast<float>(map.get_width() * map.get_tile_size());
+        std::uniform_real_distribution<float> coord(-40.0f, extent + 40.0f);
+        for (int i = 0; i < 400; i++) {
+            Vector2 p = { coord(rng), coord(rng) };
+            for (float max_distance : { 20.0f, 90.0f, 600.0f }) {
+                REQUIRE(field.get_clearance(p, max_distance) == Approx(brute_clearance(map, p, max_distance)).margin(1e-3));
+            }
+        }
+    }
+}
+
+TEST_CASE("Distance field matches brute force", "[world][obstacles][distance]") {
+    Tilemap map;
+    map.init(CHUNK_SIZE * 2, CHUNK_SIZE * 2, 32);
+    map.set_chunk_source(fill_scattered);
+    DistanceField field;
+    field.init(&map);
+    map.set_tiles_changed_callback([&field](int min_x, int min_y, int max_x, int max_y) {
+        field.update(min_x, min_y, max_x, max_y);
+    });
+
+    std::mt19937 rng(11);
+    require_matches_brute_force(map, field, rng);
+    REQUIRE(field.get_page_count() == 4);
+
+    SECTION("Edits are patched into built pages") {
+        std::uniform_int_distribution<int> tile(0, CHUNK_SIZE * 2 - 1);
+        for (int i = 0; i < 40; i++) {
+            map.set_tile(tile(rng), tile(rng), i % 3 == 0 ? TileType::GRASS : TileType::BUSH);
+        }
+        map.set_tile(CHUNK_SIZE - 2, CHUNK_SIZE - 2, TileType::TREE);   // Footprint in four pages
+        REQUIRE(field.get_page_count() == 4);
+        require_matches_brute_force(map, field, rng);
+    }
+
+    SECTION("Open ground reports no blocked tile") {
+        map.set_chunk_source([](int, int, TileType* out_tiles) {
+            std::fill(out_tiles, out_tiles + CHUNK_AREA, TileType::GRASS);
+        });
+        REQUIRE(field.get_page_count() == 0);
+        REQUIRE(field.get_tile_distance(10, 10) == -1.0f);
+        REQUIRE(field.get_clearance({ 500.0f, 500.0f }, 300.0f) == 300.0f);
+    }
+}
+
+TEST_CASE("Circle overlap uses exact square tiles", "[world][obstacles][distance]") {
+    Tilemap map;
+    map.init(CHUNK_SIZE, CHUNK_SIZE, 32);
+    map.set_chunk_source([](int, int, TileType* out_tiles) {
+        std::fill(out_tiles, out_tiles + CHUNK_AREA, TileType::GRASS);
+    });
+    map.set_tile(10, 10, TileType::WATER);   // Square [320, 352)
+    ObstacleDetector detector;
+    detector.init(&map);
+    map.set_tiles_changed_callback([&detector](int min_x, int min_y, int max_x, int max_y) {
+        detector.on_tiles_changed(min_x, min_y, max_x, max_y);
+    });
+
+    // Beside a face, and diagonally off a corner where a circle around the
+    // tile centre would wrongly report a hit
+    REQUIRE(detector.get_nearest_obstacle({ 300.0f, 336.0f }) == Approx(20.0f));
+    REQUIRE_FALSE(detector.check_circle_overlap({ 300.0f, 336.0f }, 20.0f));
+    REQUIRE(detector.check_circle_overlap({ 300.0f, 336.0f }, 20.5f));
+    REQUIRE_FALSE(detector.check_circle_overlap({ 310.0f, 310.0f }, 14.0f));
+    REQUIRE(detector.check_circle_overlap({ 310.0f, 310.0f }, 14.2f));
+
+    // Edits through the tilemap reach the field
+    map.set_tile(10, 10, TileType::GRASS);
+    REQUIRE(detector.get_nearest_obstacle({ 300.0f, 336.0f }) == 100.0f);
+    map.set_tile(9, 10, TileType::BUSH);
+    REQUIRE(detector.check_circle_overlap({ 300.0f, 336.0f }, 1.0f));
+}
@@ -0,0 +1,151 @@
+/// test_flow_field.cpp — Unit tests for the shared flow field atom
+
+#include <catch2/catch_all.hpp>
+#include "../atoms/flow_field.hpp"
+#include "../atoms/tilemap.hpp"
+#include <algorithm>
+
+using namespace world::atoms;
+
+namespace {
+    void fill_grass(int, int, TileType* out_tiles) {
+        std::fill(out_tiles, out_tiles + CHUNK_AREA, TileType::GRASS);
+    }
+
+    // Follow directions from a tile; returns the number of steps to the goal, -1 if lost
+    int follow(const Tilemap& map, const FlowField& field, int x, int y) {
+        for (int steps = 0; steps < 1000; steps++) {
+            std::uint8_t code = field.get_direction_code(x, y);
+            if (code == FlowField::DIR_GOAL) return steps;
+            if (code == FlowField::DIR_NONE) return -1;
+            Vector2 step = FlowField::step_of(code);
+            x += static_cast<int>(step.x);
+            y += static_cast<int>(step.y);
+            if (!map.is_walkable(x, y)) return -1;
+        }
+        return -1;
+    }
+}
+
+TEST_CASE("Flow field follows shortest walkable paths", "[world][flow]") {
+    Tilemap map;
+    map.init(CHUNK_SIZE * 2, CHUNK_SIZE, 32);
+    map.set_chunk_source(fill_grass);
+    FlowField field;
+    field.init(&map, 16);
+
+    SECTION("Open ground costs octile distance") {
+        REQUIRE(field.set_target(70, 30));
+        REQUIRE(field.get_direction_code(70, 30) == FlowField::DIR_GOAL);
+        REQUIRE(field.get_cost(75, 30) == 50);
+        REQUIRE(field.get_cost(73, 34) == 3 * 14 + 10);
+        REQUIRE(FlowField::step_of(field.get_direction_code(75, 30)).x == -1.0f);
+        REQUIRE(follow(map, field, 60, 22) == 10);
+
+        // Outside the window
+        REQUIRE(field.get_direction_code(70 + 17, 30) == FlowField::DIR_NONE);
+        REQUIRE(field.get_cost(70, 30 - 17) == -1);
+    }
+
+    SECTION("Paths bend around walls and through gaps") {
+        // A wall at x = 40 from y = 10 to 40 with a one-tile gap at y = 20
+        for (int y = 10; y <= 40; y++) {
+            if (y != 20) map.set_tile(40, y, TileType::WATER);
+        }
+        field.set_target(45, 30);
+        REQUIRE(field.get_direction_code(40, 30) == FlowField::DIR_NONE);
+
+        // From behind the wall the path runs up through the gap
+        int cost = field.get_cost(35, 30);
+        REQUIRE(cost > 0);
+        REQUIRE(follow(map, field, 35, 30) > 0);
+        int x = 35, y = 30;
+        bool through_gap = false;
+        while (field.get_direction_code(x, y) != FlowField::DIR_GOAL) {
+            Vector2 step = FlowField::step_of(field.get_direction_code(x, y));
+            x += static_cast<int>(step.x);
+            y += static_cast<int>(step.y);
+            through_gap = through_gap || (x == 40 && y == 20);
+        }
+        REQUIRE(through_gap);
+    }
+
+    SECTION("Diagonals never cut a blocked corner") {
+        map.set_tile(51, 30, TileType::BUSH);
+        map.set_tile(50, 31, TileType::BUSH);
+        field.set_target(50, 30);
+        // (51, 31) touches the goal only diagonally between the two bushes
+        REQUIRE(field.get_cost(51, 31) > 14);
+        REQUIRE(follow(map, field, 51, 31) > 1);
+    }
+
+    SECTION("Enclosed tiles and the map edge have no direction") {
+        for (int y = 4; y <= 6; y++) {
+            for (int x = 4; x <= 6; x++) {
+                if (x != 5 || y != 5) map.set_tile(x, y, TileType::WATER);
+            }
+        }
+        field.set_target(1, 1);
+        REQUIRE(field.get_direction_code(5, 5) == FlowField::DIR_NONE);
+        REQUIRE(field.get_direction_code(-1, 1) == FlowField::DIR_NONE);
+        REQUIRE(field.get_cost(1, 10) == 90);
+    }
+}
+
+TEST_CASE("Flow field weighs slow terrain", "[world][flow][cost]") {
+    Tilemap map;
+    map.init(CHUNK_SIZE, CHUNK_SIZE, 32);
+    map.set_chunk_source(fill_grass);
+    FlowField field;
+    field.init(&map, 32);
+    map.set_tiles_changed_callback([&field](int min_x, int min_y, int max_x, int max_y) {
+        field.invalidate(min_x, min_y, max_x, max_y);
+    });
+
+    // A band of shallows across the map between start and target: crossing
+    // it costs 15 in and 15 out instead of 10 each
+    for (int x = 0; x < CHUNK_SIZE; x++) map.set_tile(x, 15, TileType::SHALLOWS);
+    field.set_target(10, 10);
+    REQUIRE(field.get_cost(10, 20) == 8 * 10 + 2 * 15);
+    REQUIRE(follow(map, field, 10, 20) == 10);
+
+    // A gap one tile over is worth two diagonals: 2 * (14 + 4 * 10) < 110
+    map.set_tile(11, 15, TileType::GRASS);
+    field.set_target(10, 10);
+    REQUIRE(field.get_cost(10, 20) == 108);
+
+    // The detour is not worth it two tiles over: 2 * (28 + 3 * 10) > 110
+    map.set_tile(11, 15, TileType::SHALLOWS);
+    map.set_tile(12, 15, TileType::GRASS);
+    field.set_target(10, 10);
+    REQUIRE(field.get_cost(10, 20) == 110);
+}
+
+TEST_CASE("Flow field rebuilds only when needed", "[world][flow]") {
+    Tilemap map;
+    map.init(CHUNK_SIZE * 2, CHUNK_SIZE, 32);
+    map.set_chunk_source(fill_grass);
+    FlowField field;
+    field.init(&map, 8);
+    map.set_tiles_changed_callback([&field](int min_x, int min_y, int max_x, int max_y) {
+        field.invalidate(min_x, min_y, max_x, max_y);
+    });
+
+    REQUIRE(field.set_target(20, 20));
+    REQUIRE_FALSE(field.set_target(20, 20));
+
+    // Edits outside the window leave it alone
+    map.set_tile(40, 20, TileType::WATER);
+    REQUIRE_FALSE(field.set_target(20, 20));
+
+    // Edits inside it are picked up on the next set_target
+    map.set_tile(21, 20, TileType::WATER);
+    REQUIRE(field.set_target(20, 20));
+    REQUIRE(field.get_direction_code(21, 20) == FlowField::DIR_NONE);
+    REQUIRE(field.get_cost(22, 20) == 40);   // Around the water, no corner cutting
+
+    // Crossing into a new tile moves the window with the target
+    REQUIRE(field.set_target(30, 20));
+    REQUIRE(field.get_direction_code(38, 20) != FlowField::DIR_NONE);
+    REQUIRE(field.get_direction_code(21, 20) == FlowField::DIR_NONE);
+}
@@ -0,0 +1,92 @@
+/// test_fov_field.cpp — Unit tests for the field of view atom
+
+#include <catch2/catch_all.hpp>
+#include "../atoms/fov_field.hpp"
+#include "../atoms/tilemap.hpp"
+#include <algorithm>
+
+using namespace world::atoms;
+
+namespace {
+    constexpr int MAP_TILES = CHUNK_SIZE * 2;
+    constexpr int RADIUS = 10;
+
+    void fill_grass(int, int, TileType* out_tiles) {
+        std::fill(out_tiles, out_tiles + CHUNK_AREA, TileType::GRASS);
+    }
+}
+
+TEST_CASE("Field of view", "[world][fov]") {
+    Tilemap map;
+    map.init(MAP_TILES, MAP_TILES, 32);
+    map.set_chunk_source(fill_grass);
+    FovField fov;
+    fov.init(&map, RADIUS);
+    map.set_tiles_changed_callback([&fov](int min_x, int min_y, int max_x, int max_y) {
+        fov.invalidate(min_x, min_y, max_x, max_y);
+    });
+
+    const int ox = 60;
+    const int oy = 60;
+
+    SECTION("Open ground is visible within the radius") {
+        REQUIRE_FALSE(fov.is_visible(ox, oy));
+        REQUIRE(fov.set_origin(ox, oy));
+        for (int dy = -RADIUS - 2; dy <= RADIUS + 2; dy++) {
+            for (int dx = -RADIUS - 2; dx <= RADIUS + 2; dx++) {
+                bool in_range = dx * dx + dy * dy <= RADIUS * RADIUS;
+                bool beyond = dx * dx + dy * dy > RADIUS * RADIUS + RADIUS;
+                bool visible = fov.is_visible(ox + dx, oy + dy);
+                if (in_range) REQUIRE(visible);
+                if (beyond) REQUIRE_FALSE(visible);
+            }
+        }
+    }
+
+    SECTION("Water does not block sight, bushes and trees do") {
+        map.set_tile(ox + 2, oy, TileType::WATER);
+        map.set_tile(ox, oy + 2, TileType::BUSH);
+        map.set_tile(ox - 3, oy, TileType::TREE);   // Covers ox-3..ox-2, oy..oy+1
+        fov.set_origin(ox, oy);
+
+        REQUIRE(fov.is_visible(ox + 6, oy));
+        REQUIRE(fov.is_visible(ox, oy + 2));        // The blocker itself is seen
+        for (int d = 3; d <= 8; d++) {
+            REQUIRE_FALSE(fov.is_visible(ox, oy + d));
+        }
+        REQUIRE(fov.is_visible(ox - 2, oy));
+        for (int d = 4; d <= 8; d++) {
+            REQUIRE_FALSE(fov.is_visible(ox - d, oy));
+        }
+        // Beside the shadow
+        REQUIRE(fov.is_visible(ox + 3, oy + 5));
+        REQUIRE(fov.is_visible(ox - 4, oy - 3));
+    }
+
+    SECTION("Recast only on a new tile or a nearby edit") {
+        REQUIRE(fov.set_origin(ox, oy));
+        REQUIRE_FALSE(fov.set_origin(ox, oy));
+        REQUIRE(fov.get_recompute_count() == 1);
+
+        // Edit outside the window
+        map.set_tile(ox + RADIUS + 5, oy, TileType::BUSH);
+        REQUIRE_FALSE(fov.set_origin(ox, oy));
+
+        // Edit inside the window
+        REQUIRE(fov.is_visible(ox + 5, oy));
+        map.set_tile(ox + 3, oy, TileType::BUSH);
+        REQUIRE(fov.set_origin(ox, oy));
+        REQUIRE_FALSE(fov.is_visible(ox + 5, oy));
+
+        REQUIRE(fov.set_origin(ox + 1, oy));
+        REQUIRE(fov.get_recompute_count() == 3);
+    }
+
+    SECTION("Map edges block sight") {
+        fov.set_origin(1, 1);
+        REQUIRE(fov.is_visible(0, 0));
+        REQUIRE(fov.is_visible(-1, 1));          // The edge is seen, nothing past it
+        REQUIRE_FALSE(fov.is_visible(-2, 1));
+        REQUIRE(fov.is_visible(8, 1));
+    }
+}
@@ -0,0 +1,134 @@
+/// test_map_file.cpp — Unit tests for the memory-mapped map file atom
+
+#include <catch2/catch_all.hpp>
+#include "../atoms/map_file.hpp"
+#include "../atoms/tilemap.hpp"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace world::atoms;
+
+namespace {
+    // Build a 2x1-chunk map in memory: chunk 0 is a grass fill with a tree on
+    // the chunk edge, chunk 1 stores a tile block with a water column.
+    std::vector<std::uint8_t> make_test_map() {
+        MapFileHeader header = {};
+        std::memcpy(header.magic, MAP_FILE_MAGIC, sizeof(header.magic));
+        header.version = MAP_FILE_VERSION;
+        header.tile_size = 32;
+        header.width = CHUNK_SIZE + 10;
+        header.height = 20;
+        header.chunk_size = CHUNK_SIZE;
+        header.object_count = 2;
+        header.directory_offset = sizeof(MapFileHeader);
+        header.objects_offset = header.directory_offset + 2 * sizeof(MapChunkEntry);
+        std::uint32_t block_offset = header.objects_offset + 2 * sizeof(MapObject);
+
+        MapChunkEntry entries[2] = {};
+        entries[0] = { 0, 0, 2, static_cast<std::uint8_t>(TileType::GRASS), 0 };
+        entries[1] = { block_offset, 2, 0, 0, 0 };
+
+        MapObject objects[2] = {};
+        objects[0] = { CHUNK_SIZE - 1, 5, static_cast<std::uint8_t>(TileType::TREE), {} };
+        objects[1] = { 3, 7, static_cast<std::uint8_t>(TileType::BUSH), {} };
+
+        std::vector<std::uint8_t> block(CHUNK_AREA, static_cast<std::uint8_t>(TileType::GRASS));
+        for (int y = 0; y < CHUNK_SIZE; y++) {
+            block[y * CHUNK_SIZE + 4] = static_cast<std::uint8_t>(TileType::WATER);
+        }
+        block[0] = 200;   // Unknown tile ID
+
+        std::vector<std::uint8_t> bytes(block_offset + CHUNK_AREA);
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        std::memcpy(bytes.data() + header.directory_offset, entries, sizeof(entries));
+        std::memcpy(bytes.data() + header.objects_offset, objects, sizeof(objects));
+        std::memcpy(bytes.data() + block_offset, block.data(), block.size());
+        return bytes;
+    }
+
+    std::string write_temp(const std::vector<std::uint8_t>& bytes, const char* name) {
+        std::string path = std::string("test_") + name + ".plmap";
+        FILE* file = std::fopen(path.c_str(), "wb");
+        std::fwrite(bytes.data(), 1, bytes.size(), file);
+        std::fclose(file);
+        return path;
+    }
+}
+
+TEST_CASE("MapFile reads chunks and objects", "[world][mapfile]") {
+    std::string path = write_temp(make_test_map(), "valid");
+    MapFile map_file;
+    REQUIRE(map_file.open(path));
+    REQUIRE(map_file.get_width() == CHUNK_SIZE + 10);
+    REQUIRE(map_file.get_chunks_x() == 2);
+    REQUIRE(map_file.get_chunks_y() == 1);
+
+    std::vector<TileType> tiles(CHUNK_AREA);
+
+    SECTION("Fill chunks and anchored objects") {
+        map_file.read_chunk(0, 0, tiles.data());
+        REQUIRE(tiles[0] == TileType::GRASS);
+        REQUIRE(tiles[7 * CHUNK_SIZE + 3] == TileType::BUSH);
+        REQUIRE(tiles[5 * CHUNK_SIZE + CHUNK_SIZE - 1] == TileType::TREE);
+        REQUIRE(tiles[6 * CHUNK_SIZE + CHUNK_SIZE - 1] == TileType::NONE);
+    }
+
+    SECTION("Tile blocks and footprints reaching in from the previous chunk") {
+        map_file.read_chunk(1, 0, tiles.data());
+        REQUIRE(tiles[0] == TileType::NONE);              // Unknown ID
+        REQUIRE(tiles[1] == TileType::GRASS);
+        REQUIRE(tiles[9 * CHUNK_SIZE + 4] == TileType::WATER);
+        REQUIRE(tiles[5 * CHUNK_SIZE + 0] == TileType::NONE);   // Tree footprint
+        REQUIRE(tiles[6 * CHUNK_SIZE + 0] == TileType::NONE);
+        REQUIRE(tiles[7 * CHUNK_SIZE + 0] == TileType::GRASS);
+    }
+
+    SECTION("Drives a tilemap as its chunk source") {
+        Tilemap map;
+        map.init(map_file.get_width(), map_file.get_height(), map_file.get_tile_size());
+        map.set_chunk_source(map_file.make_chunk_source());
+        REQUIRE_FALSE(map.is_walkable(CHUNK_SIZE, 6));
+        REQUIRE_FALSE(map.is_walkable(CHUNK_SIZE + 4, 0));
+        REQUIRE(map.is_walkable(CHUNK_SIZE + 5, 0));
+        REQUIRE(map.get_chunk_objects(0, 0).size() == 2);
+    }
+
+    map_file.close();
+    std::remove(path.c_str());
+}
+
+TEST_CASE("MapFile rejects malformed files", "[world][mapfile]") {
+    std::vector<std::uint8_t> bytes = make_test_map();
+    MapFile map_file;
+
+    SECTION("Missing file") {
+        REQUIRE_FALSE(map_file.open("does_not_exist.plmap"));
+        REQUIRE_FALSE(map_file.get_error().empty());
+    }
+
+    SECTION("Bad magic") {
+        bytes[0] = 'X';
+        std::string path = write_temp(bytes, "magic");
+        REQUIRE_FALSE(map_file.open(path));
+        REQUIRE_FALSE(map_file.is_open());
+        std::remove(path.c_str());
+    }
+
+    SECTION("Truncated tile block") {
+        bytes.resize(bytes.size() - 1);
+        std::string path = write_temp(bytes, "truncated");
+        REQUIRE_FALSE(map_file.open(path));
+        std::remove(path.c_str());
+    }
+
+    SECTION("Object range past the object layer") {
+        MapChunkEntry entry;
+        std::memcpy(&entry, bytes.data() + sizeof(MapFileHeader), sizeof(entry));
+        entry.object_count = 3;
+        std::memcpy(bytes.data() + sizeof(MapFileHeader), &entry, sizeof(entry));
+        std::string path = write_temp(bytes, "objects");
+        REQUIRE_FALSE(map_file.open(path));
+        std::remove(path.c_str());
+    }
+}
@@ -0,0 +1,111 @@
+/// test_obstacle_detector.cpp — Unit tests for obstacle detector queries
+
+#include <catch2/catch_all.hpp>
+#include "../atoms/obstacle_detector.hpp"
+#include "../atoms/tilemap.hpp"
+
+using namespace world::atoms;
+using Catch::Approx;
+
+namespace {
+    void fill_grass(int, int, TileType* out_tiles) {
+        std::fill(out_tiles, out_tiles + CHUNK_AREA, TileType::GRASS);
+    }
+}
+
+TEST_CASE("Raycasts stop exactly at the first blocked tile face", "[world][obstacles][raycast]") {
+    Tilemap map;
+    map.init(CHUNK_SIZE * 2, CHUNK_SIZE, 32);
+    map.set_chunk_source(fill_grass);
+    ObstacleDetector detector;
+    detector.init(&map);
+
+    map.set_tile(10, 5, TileType::WATER);
+
+    SECTION("Axis-aligned ray reports the entry distance and face normal") {
+        RaycastHit hit = detector.raycast({ 100.0f, 5 * 32 + 7.0f }, { 1.0f, 0.0f });
+        REQUIRE(hit.hit);
+        REQUIRE(hit.distance == Approx(10 * 32 - 100.0f));
+        REQUIRE(hit.point.x == Approx(320.0f));
+        REQUIRE(hit.normal.x == -1.0f);
+        REQUIRE(hit.normal.y == 0.0f);
+    }
+
+    SECTION("Approaching from below hits the bottom face") {
+        RaycastHit hit = detector.raycast({ 10 * 32 + 16.0f, 300.0f }, { 0.0f, -2.0f });
+        REQUIRE(hit.hit);
+        REQUIRE(hit.distance == Approx(300.0f - 6 * 32));
+        REQUIRE(hit.normal.y == 1.0f);
+    }
+
+    SECTION("Diagonal rays do not slip between touching corners") {
+        map.set_tile(20, 20, TileType::WATER);
+        map.set_tile(21, 21, TileType::WATER);
+        map.set_tile(10, 5, TileType::GRASS);
+
+        // Exactly through the shared corner at (21*32, 21*32)
+        RaycastHit hit = detector.raycast({ 22 * 32 + 16.0f, 19 * 32 + 16.0f }, { -1.0f, 1.0f });
+        REQUIRE(hit.hit);
+        REQUIRE(hit.distance == Approx(std::sqrt(2.0f) * 48.0f));
+    }
+
+    SECTION("Misses return max distance; the map edge is a wall") {
+        RaycastHit miss = detector.raycast({ 100.0f, 100.0f }, { 0.0f, 1.0f }, 50.0f);
+        REQUIRE_FALSE(miss.hit);
+        REQUIRE(miss.distance == 50.0f);
+
+        RaycastHit edge = detector.raycast({ 100.0f, 100.0f }, { -1.0f, 0.0f });
+        REQUIRE(edge.hit);
+        REQUIRE(edge.distance == Approx(100.0f));
+        REQUIRE(edge.normal.x == 1.0f);
+    }
+
+    SECTION("Starting inside an obstacle hits at zero") {
+        RaycastHit hit = detector.raycast({ 10 * 32 + 5.0f, 5 * 32 + 5.0f }, { 1.0f, 0.0f });
+        REQUIRE(hit.hit);
+        REQUIRE(hit.distance == 0.0f);
+    }
+}
+
+TEST_CASE("Batched raycasts match single raycasts", "[world][obstacles][raycast]") {
+    Tilemap map;
+    map.init(CHUNK_SIZE * 2, CHUNK_SIZE * 2, 32);
+    map.set_chunk_source(fill_grass);
+    ObstacleDetector detector;
+    detector.init(&map);
+
+    // Scattered walls around the chunk corner, a tree straddling it
+    for (int i = 0; i < 40; i++) {
+        map.set_tile(50 + (i * 7) % 30, 50 + (i * 13) % 30, TileType::WATER);
+    }
+    map.set_tile(CHUNK_SIZE - 1, CHUNK_SIZE - 1, TileType::TREE);
+
+    const int count = 16;
+    std::vector<Vector2> directions;
+    for (int i = 0; i < count; i++) {
+        float angle = i * (2.0f * PI / count) + 0.01f;
+        directions.push_back({ std::cos(angle), std::sin(angle) });
+    }
+
+    for (float max_distance : { 150.0f, 400.0f, 5000.0f }) {
+        for (int k = 0; k < 25; k++) {
+            Vector2 origin = { 48 * 32 + k * 37.3f, 47 * 32 + k * 23.9f };
+            std::vector<float> batch(count);
+            detector.raycast_batch(origin, directions.data(), count, max_distance, batch.data());
+
+            for (int i = 0; i < count; i++) {
+                RaycastHit hit = detector.raycast(origin, directions[i], max_distance);
+                REQUIRE(batch[i] == (hit.hit ? hit.distance : max_distance));
+            }
+        }
+    }
+
+    SECTION("Odd counts and the map edge") {
+        float out[3];
+        Vector2 fan[3] = { { -1.0f, 0.0f }, { 0.0f, -1.0f }, { 0.0f, 0.0f } };
+        detector.raycast_batch({ 40.0f, 20.0f }, fan, 3, 150.0f, out);
+        REQUIRE(out[0] == Approx(40.0f));
+        REQUIRE(out[1] == Approx(20.0f));
+        REQUIRE(out[2] == 150.0f);
+    }
+}
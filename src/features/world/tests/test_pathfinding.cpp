@@ -0,0 +1,249 @@
+/// test_pathfinding.cpp — Unit tests for the path search and pathfinding service atoms
+
+#include <catch2/catch_all.hpp>
+#include "../atoms/path_search.hpp"
+#include "../atoms/path_service.hpp"
+#include "../atoms/flow_field.hpp"
+#include "../atoms/tilemap.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <thread>
+
+using namespace world::atoms;
+
+namespace {
+    void fill_grass(int, int, TileType* out_tiles) {
+        std::fill(out_tiles, out_tiles + CHUNK_AREA, TileType::GRASS);
+    }
+
+    // Grass with random water tiles and a few wall runs
+    void fill_maze(int cx, int cy, TileType* out_tiles) {
+        std::mt19937 rng(static_cast<unsigned>(cy * 131 + cx + 7));
+        for (int i = 0; i < CHUNK_AREA; i++) {
+            out_tiles[i] = rng() % 100 < 22 ? TileType::WATER : TileType::GRASS;
+        }
+        for (int run = 0; run < 6; run++) {
+            int x = static_cast<int>(rng() % CHUNK_SIZE);
+            int y = static_cast<int>(rng() % CHUNK_SIZE);
+            for (int i = 0; i < 20; i++) {
+                int tx = run % 2 ? x : std::min(x + i, CHUNK_SIZE - 1);
+                int ty = run % 2 ? std::min(y + i, CHUNK_SIZE - 1) : y;
+                out_tiles[ty * CHUNK_SIZE + tx] = TileType::WATER;
+            }
+        }
+    }
+
+    // fill_maze with a quarter of the open tiles turned to shallows
+    void fill_marsh(int cx, int cy, TileType* out_tiles) {
+        fill_maze(cx, cy, out_tiles);
+        std::mt19937 rng(static_cast<unsigned>(cy * 71 + cx + 2));
+        for (int i = 0; i < CHUNK_AREA; i++) {
+            if (out_tiles[i] == TileType::GRASS && rng() % 4 == 0) out_tiles[i] = TileType::SHALLOWS;
+        }
+    }
+
+    // Walk the waypoints tile by tile: every step is open and no diagonal cuts
+    // a corner. Returns the path cost, or -1 if the path is invalid.
+    int walk_cost(const Tilemap& map, const std::vector<TilePoint>& waypoints) {
+        int cost = 0;
+        for (std::size_t i = 1; i < waypoints.size(); i++) {
+            TilePoint a = waypoints[i - 1];
+            TilePoint b = waypoints[i];
+            int dx = (b.x > a.x) - (b.x < a.x);
+            int dy = (b.y > a.y) - (b.y < a.y);
+            if (a.x != b.x && a.y != b.y && std::abs(b.x - a.x) != std::abs(b.y - a.y)) return -1;
+            while (a != b) {
+                if (dx != 0 && dy != 0 && !(map.is_walkable(a.x + dx, a.y) && map.is_walkable(a.x, a.y + dy))) {
+                    return -1;
+                }
+                a.x += dx;
+                a.y += dy;
+                if (!map.is_walkable(a.x, a.y)) return -1;
+                cost += (dx != 0 && dy != 0) ? 14 : 10;
+            }
+        }
+        return cost;
+    }
+
+    // Poll until the search leaves PENDING
+    PathStatus wait_for(PathService& service, PathHandle handle, std::vector<TilePoint>* out) {
+        for (int i = 0; i < 2000; i++) {
+            PathStatus status = service.poll(handle, out);
+            if (status != PathStatus::PENDING) return status;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return PathStatus::PENDING;
+    }
+}
+
+TEST_CASE("Jump point search finds shortest paths", "[world][path]") {
+    Tilemap map;
+    map.init(CHUNK_SIZE * 2, CHUNK_SIZE * 2, 32);
+    PathSearch search;
+    std::vector<TilePoint> path;
+
+    SECTION("Open ground is one straight and one diagonal run") {
+        map.set_chunk_source(fill_grass);
+        PathGrid grid;
+        grid.capture(map, 0, 0, 127, 127);
+        REQUIRE(search.find_path(grid, { 10, 10 }, { 60, 30 }, path));
+        REQUIRE(path.front() == TilePoint{ 10, 10 });
+        REQUIRE(path.back() == TilePoint{ 60, 30 });
+        REQUIRE(path.size() <= 3);
+        REQUIRE(walk_cost(map, path) == PathSearch::octile_cost({ 10, 10 }, { 60, 30 }));
+
+        REQUIRE(search.find_path(grid, { 5, 5 }, { 5, 5 }, path));
+        REQUIRE(path.size() == 1);
+    }
+
+    SECTION("Costs match the flow field on cluttered maps") {
+        map.set_chunk_source(fill_maze);
+        PathGrid grid;
+        grid.capture(map, 0, 0, 127, 127);
+        FlowField field;
+        field.init(&map, 127);
+
+        std::mt19937 rng(5);
+        std::uniform_int_distribution<int> tile(0, 127);
+        int found = 0;
+        for (int i = 0; i < 60; i++) {
+            TilePoint goal = { tile(rng), tile(rng) };
+            if (!map.is_walkable(goal.x, goal.y)) continue;
+            field.set_target(goal.x, goal.y);
+            for (int j = 0; j < 10; j++) {
+                TilePoint start = { tile(rng), tile(rng) };
+                if (!map.is_walkable(start.x, start.y)) continue;
+                int expected = field.get_cost(start.x, start.y);
+                bool ok = search.find_path(grid, start, goal, path);
+                REQUIRE(ok == (expected >= 0));
+                if (ok) {
+                    REQUIRE(walk_cost(map, path) == expected);
+                    found++;
+                }
+            }
+        }
+        REQUIRE(found > 100);
+    }
+
+    SECTION("Slow terrain costs match the flow field") {
+        map.set_chunk_source(fill_marsh);
+        PathGrid grid;
+        grid.capture(map, 0, 0, 127, 127);
+        REQUIRE_FALSE(grid.uniform);
+        FlowField field;
+        field.init(&map, 127);
+
+        std::mt19937 rng(8);
+        std::uniform_int_distribution<int> tile(0, 127);
+        int found = 0;
+        for (int i = 0; i < 30; i++) {
+            TilePoint goal = { tile(rng), tile(rng) };
+            if (!map.is_walkable(goal.x, goal.y)) continue;
+            field.set_target(goal.x, goal.y);
+            for (int j = 0; j < 10; j++) {
+                TilePoint start = { tile(rng), tile(rng) };
+                if (!map.is_walkable(start.x, start.y)) continue;
+                int expected = field.get_cost(start.x, start.y);
+                bool ok = search.find_path(grid, start, goal, path);
+                REQUIRE(ok == (expected >= 0));
+                if (ok) {
+                    REQUIRE(walk_cost(map, path) >= 0);
+                    REQUIRE(PathSearch::path_cost(grid, path) == expected);
+                    found++;
+                }
+            }
+        }
+        REQUIRE(found > 50);
+    }
+
+    SECTION("Walls outside the window and blocked goals") {
+        map.set_chunk_source(fill_grass);
+        for (int y = 0; y < 40; y++) map.set_tile(20, y, TileType::WATER);
+
+        // Inside a window that stops at y = 39 the wall cannot be rounded
+        PathGrid grid;
+        grid.capture(map, 0, 0, 40, 39);
+        REQUIRE_FALSE(search.find_path(grid, { 10, 10 }, { 30, 10 }, path));
+        grid.capture(map, 0, 0, 40, 45);
+        REQUIRE(search.find_path(grid, { 10, 10 }, { 30, 10 }, path));
+        REQUIRE(walk_cost(map, path) > 0);
+
+        REQUIRE_FALSE(search.find_path(grid, { 10, 10 }, { 20, 5 }, path));
+        REQUIRE_FALSE(search.find_path(grid, { 10, 10 }, { 90, 5 }, path));
+    }
+}
+
+TEST_CASE("Path service answers requests", "[world][path]") {
+    Tilemap map;
+    map.init(CHUNK_SIZE * 2, CHUNK_SIZE * 2, 32);
+    map.set_chunk_source(fill_grass);
+    for (int y = 0; y < 25; y++) map.set_tile(40, y, TileType::WATER);
+
+    PathService service;
+    map.set_tiles_changed_callback([&service](int min_x, int min_y, int max_x, int max_y) {
+        service.invalidate(min_x, min_y, max_x, max_y);
+    });
+    std::vector<TilePoint> path;
+
+    SECTION("Inline searches and the cache") {
+        service.start(&map, 0, 4);
+        PathHandle handle = service.request({ 30, 20 }, { 50, 20 });
+        REQUIRE(handle != 0);
+        REQUIRE(service.poll(handle, &path) == PathStatus::FOUND);
+        REQUIRE(walk_cost(map, path) > 200);   // Around the end of the wall
+        REQUIRE(service.poll(handle, &path) == PathStatus::NONE);
+
+        // Same tiles again: answered from the cache
+        REQUIRE(service.get_cached_count() == 1);
+        std::vector<TilePoint> again;
+        REQUIRE(service.poll(service.request({ 30, 20 }, { 50, 20 }), &again) == PathStatus::FOUND);
+        REQUIRE(service.get_cache_hits() == 1);
+        REQUIRE(again.size() == path.size());
+
+        // An edit in the window drops the cached path; the new one goes through the gap
+        map.set_tile(40, 20, TileType::GRASS);
+        REQUIRE(service.get_cached_count() == 0);
+        REQUIRE(service.poll(service.request({ 30, 20 }, { 50, 20 }), &path) == PathStatus::FOUND);
+        REQUIRE(walk_cost(map, path) == 200);
+
+        // Unreachable goals
+        map.set_tile(60, 60, TileType::WATER);
+        REQUIRE(service.poll(service.request({ 30, 20 }, { 60, 60 }), &path) == PathStatus::NOT_FOUND);
+        REQUIRE(service.poll(service.request({ 0, 0 }, { 127, 0 }), &path) == PathStatus::FOUND);
+
+        // Least recently used entries leave first
+        for (int i = 0; i < 6; i++) {
+            service.poll(service.request({ 1, 1 }, { 2 + i, 30 }), nullptr);
+        }
+        REQUIRE(service.get_cached_count() == 4);
+    }
+
+    SECTION("Worker threads") {
+        service.start(&map, 2);
+        REQUIRE(service.get_worker_count() == 2);
+
+        std::vector<PathHandle> handles;
+        for (int i = 0; i < 40; i++) {
+            handles.push_back(service.request({ 30, i }, { 50, 49 - i }));
+        }
+        service.cancel(handles[3]);
+        for (int i = 0; i < 40; i++) {
+            PathStatus status = wait_for(service, handles[i], &path);
+            if (i == 3) {
+                REQUIRE(status == PathStatus::NONE);
+            } else {
+                REQUIRE(status == PathStatus::FOUND);
+                REQUIRE(walk_cost(map, path) > 0);
+            }
+        }
+
+        // Requests in flight when a wall closes are searched again on the new tiles
+        PathHandle handle = service.request({ 30, 60 }, { 50, 60 });
+        for (int y = 25; y < CHUNK_SIZE * 2; y++) map.set_tile(40, y, TileType::WATER);
+        REQUIRE(wait_for(service, handle, &path) == PathStatus::NOT_FOUND);
+        service.stop();
+        REQUIRE(service.request({ 1, 1 }, { 2, 2 }) == 0);
+    }
+}
@@ -0,0 +1,238 @@
+/// test_region_map.cpp — Unit tests for the connected region labels atom
+
+#include <catch2/catch_all.hpp>
+#include "../atoms/region_map.hpp"
+#include "../atoms/tilemap.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace world::atoms;
+
+namespace {
+    constexpr int MAP_TILES = CHUNK_SIZE * 3;
+
+    void fill_grass(int, int, TileType* out_tiles) {
+        std::fill(out_tiles, out_tiles + CHUNK_AREA, TileType::GRASS);
+    }
+
+    // Dense enough water to break the map into many regions
+    void fill_islands(int cx, int cy, TileType* out_tiles) {
+        std::mt19937 rng(static_cast<unsigned>(cy * 31 + cx + 7));
+        for (int i = 0; i < CHUNK_AREA; i++) {
+            out_tiles[i] = rng() % 100 < 42 ? TileType::WATER : TileType::GRASS;
+        }
+    }
+
+    // Reference labels from a whole-map 4-connected flood, 0 for blocked
+    std::vector<int> flood_labels(const Tilemap& map) {
+        std::vector<int> labels(MAP_TILES * MAP_TILES, 0);
+        std::vector<int> stack;
+        int next = 0;
+        for (int start = 0; start < MAP_TILES * MAP_TILES; start++) {
+            if (labels[start] != 0 || !map.is_walkable(start % MAP_TILES, start / MAP_TILES)) continue;
+            labels[start] = ++next;
+            stack.assign(1, start);
+            while (!stack.empty()) {
+                int tile = stack.back();
+                stack.pop_back();
+                int x = tile % MAP_TILES;
+                int y = tile / MAP_TILES;
+                const int offsets[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+                for (const auto& offset : offsets) {
+                    int nx = x + offset[0];
+                    int ny = y + offset[1];
+                    if (nx < 0 || ny < 0 || nx >= MAP_TILES || ny >= MAP_TILES) continue;
+                    int neighbour = ny * MAP_TILES + nx;
+                    if (labels[neighbour] != 0 || !map.is_walkable(nx, ny)) continue;
+                    labels[neighbour] = next;
+                    stack.push_back(neighbour);
+                }
+            }
+        }
+        return labels;
+    }
+
+    // Both labellings split the map the same way
+    bool same_partition(RegionMap& regions, const Tilemap& map) {
+        std::vector<int> expected = flood_labels(map);
+        std::vector<std::uint32_t> seen(MAP_TILES * MAP_TILES + 1, 0);
+        int expected_count = 0;
+        for (int tile = 0; tile < MAP_TILES * MAP_TILES; tile++) {
+            std::uint32_t region = regions.get_region(tile % MAP_TILES, tile / MAP_TILES);
+            if ((expected[tile] == 0) != (region == 0)) return false;
+            if (expected[tile] == 0) continue;
+            expected_count = std::max(expected_count, expected[tile]);
+            if (seen[expected[tile]] == 0) seen[expected[tile]] = region;
+            if (seen[expected[tile]] != region) return false;
+        }
+        return regions.get_region_count() == expected_count;
+    }
+}
+
+TEST_CASE("Region map labels connected tiles", "[world][regions]") {
+    Tilemap map;
+    map.init(MAP_TILES, MAP_TILES, 32);
+    map.set_chunk_source(fill_islands);
+    map.set_streaming_budget(16);
+    RegionMap regions;
+    regions.init(&map);
+    map.set_tiles_changed_callback([&regions](int min_x, int min_y, int max_x, int max_y) {
+        regions.on_tiles_changed(min_x, min_y, max_x, max_y);
+    });
+
+    SECTION("Labels match a whole-map flood") {
+        REQUIRE(same_partition(regions, map));
+        REQUIRE(regions.get_region(-1, 0) == 0);
+        REQUIRE(regions.get_region(0, MAP_TILES) == 0);
+    }
+
+    SECTION("Random edits keep labels exact") {
+        std::mt19937 rng(5);
+        std::uniform_int_distribution<int> tile(0, MAP_TILES - 1);
+        regions.get_region(0, 0);
+        for (int i = 0; i < 200; i++) {
+            map.set_tile(tile(rng), tile(rng), rng() % 2 ? TileType::WATER : TileType::GRASS);
+        }
+        REQUIRE(same_partition(regions, map));
+    }
+
+    SECTION("Chunk source change discards labels") {
+        regions.get_region(0, 0);
+        map.set_chunk_source(fill_grass);
+        REQUIRE(regions.get_region_count() == 1);
+        REQUIRE(regions.is_reachable(0, 0, MAP_TILES - 1, MAP_TILES - 1));
+    }
+}
+
+TEST_CASE("Reachability labels chunks on demand", "[world][regions]") {
+    SECTION("Answers match a whole-map flood") {
+        Tilemap map;
+        map.init(MAP_TILES, MAP_TILES, 32);
+        map.set_chunk_source(fill_islands);
+        RegionMap regions;
+        regions.init(&map);
+        map.set_tiles_changed_callback([&regions](int min_x, int min_y, int max_x, int max_y) {
+            regions.on_tiles_changed(min_x, min_y, max_x, max_y);
+        });
+
+        std::mt19937 rng(11);
+        std::uniform_int_distribution<int> tile(0, MAP_TILES - 1);
+        for (int round = 0; round < 3; round++) {
+            std::vector<int> expected = flood_labels(map);
+            for (int i = 0; i < 500; i++) {
+                int from_x = tile(rng), from_y = tile(rng), to_x = tile(rng), to_y = tile(rng);
+                int from = expected[from_y * MAP_TILES + from_x];
+                int to = expected[to_y * MAP_TILES + to_x];
+                if (from == 0) continue;   // Blocked starts are covered by the edit tests
+                REQUIRE(regions.is_reachable(from_x, from_y, to_x, to_y) == (to != 0 && from == to));
+            }
+            for (int i = 0; i < 100; i++) {
+                map.set_tile(tile(rng), tile(rng), rng() % 2 ? TileType::WATER : TileType::GRASS);
+            }
+        }
+    }
+
+    // Grass, with a walled-in pond of grass in chunk (1, 1)
+    Tilemap map;
+    map.init(CHUNK_SIZE * 8, CHUNK_SIZE * 8, 32);
+    map.set_chunk_source(fill_grass);
+    const int pond = CHUNK_SIZE + 10;
+    for (int i = 0; i < 6; i++) {
+        map.set_tile(pond + i, pond, TileType::WATER);
+        map.set_tile(pond + i, pond + 5, TileType::WATER);
+        map.set_tile(pond, pond + i, TileType::WATER);
+        map.set_tile(pond + 5, pond + i, TileType::WATER);
+    }
+    RegionMap regions;
+    regions.init(&map);
+
+    REQUIRE(regions.is_reachable(3, 3, 40, 50));
+    REQUIRE(regions.get_labelled_chunk_count() == 1);
+
+    // Neighbouring chunks join as soon as both are labelled
+    REQUIRE(regions.is_reachable(3, 3, CHUNK_SIZE + 3, 3));
+    REQUIRE(regions.get_labelled_chunk_count() == 2);
+
+    // Far apart: labels the chunks between, not the whole map
+    REQUIRE(regions.is_reachable(3, 3, CHUNK_SIZE * 3 + 3, 3));
+    REQUIRE(regions.get_labelled_chunk_count() < 8 * 8 / 2);
+
+    // The pond is closed inside its chunk, however big the region outside is
+    int labelled = regions.get_labelled_chunk_count();
+    REQUIRE_FALSE(regions.is_reachable(3, 3, pond + 2, pond + 2));
+    REQUIRE_FALSE(regions.is_reachable(pond + 2, pond + 2, CHUNK_SIZE * 7, CHUNK_SIZE * 7));
+    REQUIRE(regions.get_labelled_chunk_count() <= labelled + 2);
+    REQUIRE(regions.is_reachable(pond + 1, pond + 1, pond + 4, pond + 4));
+}
+
+TEST_CASE("Region map edits", "[world][regions]") {
+    Tilemap map;
+    map.init(MAP_TILES, MAP_TILES, 32);
+    map.set_chunk_source(fill_grass);
+    RegionMap regions;
+    regions.init(&map);
+    map.set_tiles_changed_callback([&regions](int min_x, int min_y, int max_x, int max_y) {
+        regions.on_tiles_changed(min_x, min_y, max_x, max_y);
+    });
+
+    // Water column along the first chunk border, leaving a two-tile gap
+    for (int y = 0; y < MAP_TILES; y++) {
+        if (y != 100 && y != 101) map.set_tile(CHUNK_SIZE, y, TileType::WATER);
+    }
+    REQUIRE(regions.get_region_count() == 1);
+    REQUIRE(regions.is_reachable(10, 10, CHUNK_SIZE + 10, 10));
+
+    SECTION("Blocking a corridor splits the region") {
+        map.set_tile(CHUNK_SIZE, 100, TileType::WATER);
+        REQUIRE(regions.is_reachable(10, 10, CHUNK_SIZE + 10, 10));
+        map.set_tile(CHUNK_SIZE, 101, TileType::WATER);
+        REQUIRE(regions.get_region_count() == 2);
+        REQUIRE_FALSE(regions.is_reachable(10, 10, CHUNK_SIZE + 10, 10));
+        REQUIRE_FALSE(regions.is_reachable(CHUNK_SIZE + 10, 10, 10, 10));
+
+        // A blocked start takes an open neighbour's region; blocked goals never match
+        REQUIRE(regions.is_reachable(CHUNK_SIZE, 10, CHUNK_SIZE + 10, 10));
+        REQUIRE_FALSE(regions.is_reachable(10, 10, CHUNK_SIZE, 10));
+
+        SECTION("Opening beside one region joins it in place") {
+            int relabels = regions.get_relabel_count();
+            map.set_tile(CHUNK_SIZE, 50, TileType::GRASS);
+            REQUIRE(regions.get_relabel_count() == relabels);
+            REQUIRE(regions.get_region_count() == 1);
+            REQUIRE(regions.is_reachable(10, 10, CHUNK_SIZE + 10, 10));
+            REQUIRE(same_partition(regions, map));
+        }
+    }
+}
+
+TEST_CASE("Spawn candidates on blocked tiles are rejected", "[world][regions]") {
+    Tilemap map;
+    map.init(MAP_TILES, MAP_TILES, 32);
+    map.set_chunk_source(fill_grass);
+    RegionMap regions;
+    regions.init(&map);
+    map.set_tiles_changed_callback([&regions](int min_x, int min_y, int max_x, int max_y) {
+        regions.on_tiles_changed(min_x, min_y, max_x, max_y);
+    });
+
+    // The enemy spawners' test: an open tile from which the player is reachable
+    auto can_spawn = [&](int x, int y, int player_x, int player_y) {
+        return map.is_walkable(x, y) && regions.is_reachable(x, y, player_x, player_y);
+    };
+
+    const int player_x = 100;
+    const int player_y = 100;
+    map.set_tile(20, 20, TileType::WATER);
+    map.set_tile(30, 20, TileType::BUSH);
+    map.set_tile(40, 20, TileType::TREE);       // Covers 40..41, 20..21
+
+    const int blocked[][2] = { { 20, 20 }, { 30, 20 }, { 40, 20 }, { 41, 21 } };
+    for (const auto& tile : blocked) {
+        // Reachability alone borrows the open neighbours' region
+        REQUIRE(regions.is_reachable(tile[0], tile[1], player_x, player_y));
+        REQUIRE_FALSE(can_spawn(tile[0], tile[1], player_x, player_y));
+    }
+    REQUIRE(can_spawn(21, 20, player_x, player_y));
+    REQUIRE(can_spawn(42, 20, player_x, player_y));
+}
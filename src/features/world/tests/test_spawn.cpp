@@ -0,0 +1,134 @@
+/// test_spawn.cpp — Unit tests for the streaming spawn loader atom
+
+#include <catch2/catch_all.hpp>
+#include "../atoms/spawn_loader.hpp"
+#include "../atoms/tilemap.hpp"
+#include <map>
+
+using namespace world::atoms;
+using enemies::EnemyID;
+using enemies::EnemySpawnRequest;
+
+namespace {
+    // Stand-in enemy slice: live enemies by handle, with a kill switch
+    struct FakeEnemies {
+        std::map<int, bool> alive;
+        int next_handle = 0;
+        int spawned = 0;
+
+        void hook(SpawnLoader& loader) {
+            loader.set_handlers(
+                [this](const EnemySpawnRequest&) { spawned++; alive[next_handle] = true; return next_handle++; },
+                [this](const EnemySpawnRequest&, int handle) {
+                    bool was_alive = alive[handle];
+                    alive.erase(handle);
+                    return was_alive;
+                });
+        }
+    };
+}
+
+TEST_CASE("Spawn schema parsing", "[world][spawn]") {
+    SpawnLoader loader;
+    loader.init(32);
+
+    SECTION("WORLDBUILDING §6 example") {
+        REQUIRE(loader.load_json(R"({
+            "spawns": [
+                { "id": "FOR_SLIME", "x": 12, "y": 7, "respawnable": true },
+                { "id": "CAV_BAT", "x": 100, "y": 3, "note": { "ignored": [1, 2] } }
+            ],
+            "version": "0.2"
+        })"));
+        REQUIRE(loader.get_spawn_count() == 2);
+    }
+
+    SECTION("Errors add nothing and name the spawn") {
+        REQUIRE_FALSE(loader.load_json(R"({ "spawns": [ { "id": "FOR_SLIME", "x": 1, "y": 1 },
+                                                         { "id": "FOR_DRAGON", "x": 2, "y": 2 } ] })"));
+        REQUIRE(loader.get_spawn_count() == 0);
+        REQUIRE(loader.get_error().find("spawn 1") != std::string::npos);
+
+        REQUIRE_FALSE(loader.load_json(R"({ "spawns": [ { "id": "FOR_SLIME", "x": 1 } ] })"));
+        REQUIRE_FALSE(loader.load_json(R"({ "spawns": [ )"));
+        REQUIRE_FALSE(loader.load_file("does_not_exist.json"));
+        REQUIRE(loader.get_spawn_count() == 0);
+    }
+}
+
+TEST_CASE("Spawns follow chunk activation and eviction", "[world][spawn][streaming]") {
+    SpawnLoader loader;
+    loader.init(32);
+    REQUIRE(loader.load_json(R"({ "spawns": [
+        { "id": "FOR_SLIME", "x": 5, "y": 5, "respawnable": true },
+        { "id": "FOR_SLIME", "x": 6, "y": 5 },
+        { "id": "FOR_SLIME", "x": 200, "y": 5 }
+    ] })"));
+
+    FakeEnemies fake;
+    fake.hook(loader);
+
+    Tilemap map;
+    map.init(CHUNK_SIZE * 4, CHUNK_SIZE, 32);
+    map.set_chunk_activated_callback([&](int cx, int cy) { loader.activate_chunk(cx, cy); });
+    map.set_chunk_evicted_callback([&](int cx, int cy) { loader.retire_chunk(cx, cy); });
+    map.set_streaming_budget(1);
+    map.set_streaming_margin(0);
+
+    float chunk_px = static_cast<float>(CHUNK_SIZE * 32);
+    Rectangle first_chunk = { 0.0f, 0.0f, chunk_px - 1, chunk_px - 1 };
+    Rectangle last_chunk = { chunk_px * 3, 0.0f, chunk_px - 1, chunk_px - 1 };
+
+    // Queries page chunks in without activating them
+    map.get_tile(5, 5);
+    REQUIRE(loader.get_live_count() == 0);
+
+    map.update_streaming(first_chunk);
+    REQUIRE(loader.get_live_count() == 2);
+
+    // Staying in view does not spawn again
+    map.update_streaming(first_chunk);
+    REQUIRE(fake.spawned == 2);
+
+    SECTION("Eviction retires and reactivation respawns") {
+        map.update_streaming(last_chunk);
+        REQUIRE_FALSE(map.is_chunk_resident(0, 0));
+        REQUIRE(loader.get_live_count() == 1);
+        REQUIRE(fake.alive.size() == 1);
+
+        // Chunk 3's spawn came and went on the way
+        map.update_streaming(first_chunk);
+        REQUIRE(loader.get_live_count() == 2);
+        REQUIRE(fake.spawned == 5);
+    }
+
+    SECTION("Killed non-respawnable spawns stay dead") {
+        for (auto& entry : fake.alive) entry.second = false;   // Both die
+
+        map.update_streaming(last_chunk);
+        map.update_streaming(first_chunk);
+        REQUIRE(loader.get_live_count() == 1);                 // Only the respawnable one
+    }
+
+    SECTION("Clearing retires live spawns") {
+        loader.clear();
+        REQUIRE(fake.alive.empty());
+        REQUIRE(loader.get_spawn_count() == 0);
+    }
+}
+
+TEST_CASE("Handlers set after activation catch up", "[world][spawn]") {
+    SpawnLoader loader;
+    loader.init(32);
+    loader.add_spawn({ EnemyID::FOR_SLIME, { 40.0f, 40.0f }, false });
+    loader.activate_chunk(0, 0);
+    REQUIRE(loader.get_live_count() == 0);
+
+    FakeEnemies fake;
+    fake.hook(loader);
+    REQUIRE(loader.get_live_count() == 1);
+
+    // Spawns added into a live chunk materialise immediately
+    loader.add_spawn({ EnemyID::FOR_SLIME, { 80.0f, 40.0f }, false });
+    REQUIRE(loader.get_live_count() == 2);
+}
@@ -0,0 +1,157 @@
+/// test_steering_table.cpp — Unit tests for the cached steering distances atom
+
+#include <catch2/catch_all.hpp>
+#include "../atoms/steering_table.hpp"
+#include "../atoms/obstacle_detector.hpp"
+#include "../atoms/tilemap.hpp"
+#include <random>
+
+using namespace world::atoms;
+using Catch::Approx;
+
+namespace {
+    void fill_grass(int, int, TileType* out_tiles) {
+        std::fill(out_tiles, out_tiles + CHUNK_AREA, TileType::GRASS);
+    }
+
+    constexpr int N = SteeringTable::NUM_DIRECTIONS;
+}
+
+TEST_CASE("Steering table matches raycasts from tile centres", "[world][obstacles][steering]") {
+    Tilemap map;
+    map.init(CHUNK_SIZE * 2, CHUNK_SIZE, 32);
+    map.set_chunk_source(fill_grass);
+    map.set_tile(10, 5, TileType::WATER);
+    map.set_tile(6, 9, TileType::TREE);
+    map.set_tile(CHUNK_SIZE + 2, 4, TileType::BUSH);
+    ObstacleDetector detector;
+    detector.init(&map);
+
+    SteeringTable table;
+    table.init(&map, &detector, 150.0f);
+
+    Vector2 directions[N];
+    for (int i = 0; i < N; i++) {
+        float angle = i * (2.0f * PI / N);
+        directions[i] = { cosf(angle), sinf(angle) };
+    }
+
+    for (int tile_y = 0; tile_y < 12; tile_y++) {
+        for (int tile_x = CHUNK_SIZE - 6; tile_x < CHUNK_SIZE + 6; tile_x += 3) {
+            Vector2 centre = { tile_x * 32 + 16.0f, tile_y * 32 + 16.0f };
+            float cached[N], traced[N];
+            table.get_distances(centre, cached);
+            table.get_distances(centre, cached);   // Second read comes from the table
+            detector.raycast_batch(centre, directions, N, 150.0f, traced);
+            for (int i = 0; i < N; i++) {
+                REQUIRE(cached[i] == Approx(traced[i]).margin(0.125f));
+            }
+        }
+    }
+    REQUIRE(table.get_page_count() == 2);
+    REQUIRE(table.get_cached_tile_count() == 12 * 4);
+
+    SECTION("Offsets inside a tile are corrected along each ray") {
+        // Facing the water tile's left face at x = 320 from anywhere in tile (8, 5)
+        for (float x : { 257.0f, 272.0f, 287.5f }) {
+            float cached[N];
+            table.get_distances({ x, 5 * 32 + 3.0f }, cached);
+            REQUIRE(cached[0] == Approx(320.0f - x).margin(0.125f));
+        }
+    }
+
+    SECTION("Blocked tiles read zero in every direction") {
+        float cached[N];
+        table.get_distances({ 10 * 32 + 2.0f, 5 * 32 + 30.0f }, cached);
+        for (float d : cached) REQUIRE(d == 0.0f);
+    }
+
+    SECTION("Clear rays read the maximum distance") {
+        float cached[N];
+        table.get_distances({ 30 * 32 + 16.0f, 30 * 32 + 16.0f }, cached);
+        for (float d : cached) REQUIRE(d == 150.0f);
+    }
+}
+
+TEST_CASE("Steering table never reads past raycasts off the tile centre", "[world][obstacles][steering]") {
+    Tilemap map;
+    map.init(CHUNK_SIZE, CHUNK_SIZE, 32);
+    map.set_chunk_source(fill_grass);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> tile(0, CHUNK_SIZE - 1);
+    for (int i = 0; i < 400; i++) {
+        map.set_tile(tile(rng), tile(rng), TileType::BUSH);
+    }
+    ObstacleDetector detector;
+    detector.init(&map);
+
+    SteeringTable table;
+    table.init(&map, &detector, 200.0f);
+
+    Vector2 directions[N];
+    for (int i = 0; i < N; i++) {
+        float angle = i * (2.0f * PI / N);
+        directions[i] = { cosf(angle), sinf(angle) };
+    }
+
+    // Positions anywhere in a tile, so the rays run beside the centre's rays
+    std::uniform_real_distribution<float> coord(0.0f, CHUNK_SIZE * 32.0f);
+    int exact = 0;
+    for (int sample = 0; sample < 4000; sample++) {
+        Vector2 position = { coord(rng), coord(rng) };
+        float cached[N], traced[N];
+        table.get_distances(position, cached);
+        detector.raycast_batch(position, directions, N, 200.0f, traced);
+        for (int i = 0; i < N; i++) {
+            REQUIRE(cached[i] <= traced[i] + 0.125f);
+            if (cached[i] >= traced[i] - 0.125f) exact++;
+        }
+    }
+    // Conservative, but not by giving up on the corrected reads
+    REQUIRE(exact > 4000 * N * 98 / 100);
+}
+
+TEST_CASE("Steering table entries are invalidated around edits", "[world][obstacles][steering]") {
+    Tilemap map;
+    map.init(CHUNK_SIZE * 2, CHUNK_SIZE * 2, 32);
+    map.set_chunk_source(fill_grass);
+    ObstacleDetector detector;
+    detector.init(&map);
+
+    SteeringTable table;
+    table.init(&map, &detector, 100.0f);
+    map.set_tiles_changed_callback([&table](int min_x, int min_y, int max_x, int max_y) {
+        table.invalidate(min_x, min_y, max_x, max_y);
+    });
+
+    float cached[N];
+    Vector2 near = { 20 * 32 + 16.0f, 20 * 32 + 16.0f };
+    Vector2 far = { 100 * 32 + 16.0f, 100 * 32 + 16.0f };
+    table.get_distances(near, cached);
+    REQUIRE(cached[0] == 100.0f);
+    table.get_distances(far, cached);
+    REQUIRE(table.get_cached_tile_count() == 2);
+
+    // A bush two tiles to the right of the near tile
+    map.set_tile(22, 20, TileType::BUSH);
+    REQUIRE(table.get_cached_tile_count() == 1);
+    table.get_distances(near, cached);
+    REQUIRE(cached[0] == Approx(2 * 32 - 16.0f).margin(0.125f));
+
+    // Clearing it again restores the open ray
+    map.set_tile(22, 20, TileType::GRASS);
+    table.get_distances(near, cached);
+    REQUIRE(cached[0] == 100.0f);
+
+    SECTION("Changing the chunk source drops everything") {
+        map.set_chunk_source(fill_grass);
+        REQUIRE(table.get_cached_tile_count() == 0);
+    }
+
+    SECTION("Pages past the budget are dropped least recently used first") {
+        table.set_page_budget(1);
+        table.get_distances({ (CHUNK_SIZE + 5) * 32.0f, 5 * 32.0f }, cached);
+        REQUIRE(table.get_page_count() == 1);
+        REQUIRE(table.get_cached_tile_count() == 1);
+    }
+}
@@ -0,0 +1,290 @@
+/// test_tilemap.cpp — Unit tests for the chunked tilemap atom
+
+#include <catch2/catch_all.hpp>
+#include "../atoms/tilemap.hpp"
+#include <utility>
+#include <vector>
+
+using world::atoms::Tilemap;
+using world::atoms::TileType;
+using world::atoms::CHUNK_SIZE;
+using world::atoms::MOVE_COST_BASE;
+using world::atoms::tile_properties;
+
+namespace {
+    // Grass everywhere, the same source generate_demo_map installs
+    void fill_grass(int, int, TileType* out_tiles) {
+        std::fill(out_tiles, out_tiles + world::atoms::CHUNK_AREA, TileType::GRASS);
+    }
+}
+
+TEST_CASE("Tilemap pages chunks in on first access", "[world][tilemap][chunks]") {
+    Tilemap map;
+    map.init(CHUNK_SIZE * 4, CHUNK_SIZE * 4, 32);
+    map.set_chunk_source(fill_grass);
+
+    REQUIRE(map.get_chunks_x() == 4);
+    REQUIRE(map.get_resident_chunk_count() == 0);
+
+    REQUIRE(map.get_tile(CHUNK_SIZE * 2 + 3, 5) == TileType::GRASS);
+    REQUIRE(map.get_resident_chunk_count() == 1);
+    REQUIRE(map.is_chunk_resident(2, 0));
+    REQUIRE_FALSE(map.is_chunk_resident(0, 0));
+
+    // Out of bounds never pages anything in
+    REQUIRE(map.get_tile(-1, 0) == TileType::NONE);
+    REQUIRE(map.get_tile(CHUNK_SIZE * 4, 0) == TileType::NONE);
+    REQUIRE(map.get_resident_chunk_count() == 1);
+}
+
+TEST_CASE("Tilemap queries work across chunk boundaries", "[world][tilemap][chunks]") {
+    Tilemap map;
+    map.init(CHUNK_SIZE * 2, CHUNK_SIZE * 2, 32);
+    map.set_chunk_source(fill_grass);
+
+    // A 2x2 tree whose footprint straddles all four chunks
+    int edge = CHUNK_SIZE - 1;
+    map.set_tile(edge, edge, TileType::TREE);
+
+    REQUIRE(map.get_tile(edge, edge) == TileType::TREE);
+    REQUIRE_FALSE(map.is_walkable(edge, edge));
+    REQUIRE_FALSE(map.is_walkable(edge + 1, edge));
+    REQUIRE_FALSE(map.is_walkable(edge, edge + 1));
+    REQUIRE_FALSE(map.is_walkable(edge + 1, edge + 1));
+    REQUIRE(map.is_walkable(edge + 2, edge + 1));
+    REQUIRE(map.get_resident_chunk_count() == 4);
+}
+
+TEST_CASE("Chunk edges are resolved through the peek source", "[world][tilemap][chunks]") {
+    // Chunk (0, 0) holds a tree whose footprint reaches into chunk (1, 0)
+    auto tree_source = [](int chunk_x, int chunk_y, TileType* out_tiles) {
+        std::fill(out_tiles, out_tiles + world::atoms::CHUNK_AREA, TileType::NONE);
+        if (chunk_x == 0 && chunk_y == 0) out_tiles[5 * CHUNK_SIZE + CHUNK_SIZE - 1] = TileType::TREE;
+    };
+    std::vector<std::pair<int, int>> loaded;
+    std::vector<std::pair<int, int>> peeked;
+
+    Tilemap map;
+    map.init(CHUNK_SIZE * 2, CHUNK_SIZE, 32);
+    map.set_chunk_source(
+        [&](int chunk_x, int chunk_y, TileType* out_tiles) {
+            loaded.push_back({ chunk_x, chunk_y });
+            tree_source(chunk_x, chunk_y, out_tiles);
+        },
+        [&](int chunk_x, int chunk_y, TileType* out_tiles) {
+            peeked.push_back({ chunk_x, chunk_y });
+            tree_source(chunk_x, chunk_y, out_tiles);
+        });
+
+    // Paging chunk (1, 0) in peeks at (0, 0) but only loads itself
+    REQUIRE_FALSE(map.is_walkable(CHUNK_SIZE, 6));
+    REQUIRE(loaded == std::vector<std::pair<int, int>>{ { 1, 0 } });
+    REQUIRE(peeked == std::vector<std::pair<int, int>>{ { 0, 0 } });
+
+    REQUIRE_FALSE(map.is_walkable(CHUNK_SIZE - 1, 5));
+    REQUIRE(loaded == std::vector<std::pair<int, int>>{ { 1, 0 }, { 0, 0 } });
+}
+
+TEST_CASE("Tilemap streaming respects the budget and keeps edits", "[world][tilemap][streaming]") {
+    Tilemap map;
+    map.init(CHUNK_SIZE * 8, CHUNK_SIZE * 8, 32);
+    map.set_chunk_source(fill_grass);
+    map.set_streaming_budget(4);
+    map.set_streaming_margin(0);
+
+    // Edit a tile in chunk (0, 0)
+    map.set_tile(3, 3, TileType::WATER);
+
+    // A view the size of one chunk, parked well away from the edit
+    float chunk_px = static_cast<float>(CHUNK_SIZE * 32);
+    for (int step = 0; step < 6; step++) {
+        Rectangle view = { chunk_px * (2 + step % 5), chunk_px * 5, chunk_px - 1, chunk_px - 1 };
+        map.update_streaming(view);
+        REQUIRE(map.get_resident_chunk_count() <= 4);
+    }
+
+    SECTION("Edited chunks are evicted but not lost") {
+        REQUIRE_FALSE(map.is_chunk_resident(0, 0));
+        REQUIRE(map.get_tile(3, 3) == TileType::WATER);
+        REQUIRE_FALSE(map.is_walkable(3, 3));
+        REQUIRE(map.get_tile(4, 3) == TileType::GRASS);
+    }
+
+    SECTION("Chunks inside the view are never evicted") {
+        Rectangle view = { 0.0f, 0.0f, chunk_px * 3 - 1, chunk_px * 2 - 1 };
+        map.update_streaming(view);
+        REQUIRE(map.get_resident_chunk_count() == 6);
+        REQUIRE(map.is_chunk_resident(0, 0));
+        REQUIRE(map.is_chunk_resident(2, 1));
+    }
+}
+
+TEST_CASE("Walkability bitmap tracks set_tile", "[world][tilemap][walkable]") {
+    Tilemap map;
+    map.init(CHUNK_SIZE * 2, CHUNK_SIZE, 32);
+    map.set_chunk_source(fill_grass);
+
+    SECTION("Replacing a tree uncovers its footprint") {
+        map.set_tile(10, 10, TileType::TREE);
+        REQUIRE_FALSE(map.is_walkable(11, 11));
+
+        map.set_tile(10, 10, TileType::GRASS);
+        REQUIRE(map.is_walkable(10, 10));
+        REQUIRE(map.is_walkable(11, 10));
+        REQUIRE(map.is_walkable(11, 11));
+    }
+
+    SECTION("Trees that do not fit are not placed") {
+        map.set_tile(CHUNK_SIZE * 2 - 1, 5, TileType::TREE);
+        REQUIRE(map.get_tile(CHUNK_SIZE * 2 - 1, 5) == TileType::GRASS);
+        REQUIRE(map.is_walkable(CHUNK_SIZE * 2 - 1, 5));
+    }
+
+    SECTION("Row and rect queries span chunk words") {
+        int wall_x = CHUNK_SIZE + 3;
+        map.set_tile(wall_x, 20, TileType::WATER);
+
+        REQUIRE(map.is_row_walkable(0, wall_x - 1, 20));
+        REQUIRE_FALSE(map.is_row_walkable(0, wall_x, 20));
+        REQUIRE_FALSE(map.is_row_walkable(wall_x - 70, wall_x + 70, 20));
+        REQUIRE(map.is_rect_walkable(CHUNK_SIZE - 10, 0, wall_x - 1, CHUNK_SIZE - 1));
+        REQUIRE_FALSE(map.is_rect_walkable(CHUNK_SIZE - 10, 19, wall_x, 21));
+
+        std::uint64_t bits = map.get_walkable_bits(wall_x - 5, 20);
+        REQUIRE((bits & (1ull << 5)) == 0);
+        REQUIRE((bits & ~(1ull << 5)) == ~(1ull << 5));
+    }
+
+    SECTION("Tiles outside the map read as walkable") {
+        REQUIRE(map.is_walkable(-1, -1));
+        REQUIRE(map.get_walkable_bits(-64, -1) == ~0ull);
+        REQUIRE(map.is_rect_walkable(-10, -10, -1, -1));
+    }
+}
+
+TEST_CASE("Move cost grid tracks set_tile", "[world][tilemap][cost]") {
+    Tilemap map;
+    map.init(CHUNK_SIZE * 2, CHUNK_SIZE, 32);
+    map.set_chunk_source(fill_grass);
+
+    REQUIRE(map.get_move_cost(5, 5) == MOVE_COST_BASE);
+    map.set_tile(5, 5, TileType::SHALLOWS);
+    REQUIRE(map.get_move_cost(5, 5) == tile_properties(TileType::SHALLOWS).move_cost);
+    REQUIRE(map.is_walkable(5, 5));
+    map.set_tile(5, 5, TileType::WATER);
+    REQUIRE(map.get_move_cost(5, 5) == 0);
+
+    // A tree's whole footprint is blocked, and uncovered again when replaced
+    map.set_tile(20, 20, TileType::TREE);
+    REQUIRE(map.get_move_cost(21, 21) == 0);
+    map.set_tile(20, 20, TileType::GRASS);
+    REQUIRE(map.get_move_cost(21, 21) == MOVE_COST_BASE);
+
+    // Row copies span chunks and read open ground outside the map
+    map.set_tile(CHUNK_SIZE, 7, TileType::SHALLOWS);
+    std::uint8_t row[CHUNK_SIZE * 2 + 8];
+    map.get_move_costs(-4, 7, CHUNK_SIZE * 2 + 8, row);
+    REQUIRE(row[0] == MOVE_COST_BASE);
+    REQUIRE(row[4 + CHUNK_SIZE] == tile_properties(TileType::SHALLOWS).move_cost);
+    REQUIRE(row[4 + CHUNK_SIZE - 1] == MOVE_COST_BASE);
+    REQUIRE(row[CHUNK_SIZE * 2 + 7] == MOVE_COST_BASE);
+    REQUIRE(map.get_move_cost(-1, 7) == MOVE_COST_BASE);
+}
+
+TEST_CASE("Chunk object index stays sorted through set_tile", "[world][tilemap][objects]") {
+    Tilemap map;
+    map.init(CHUNK_SIZE * 2, CHUNK_SIZE, 32);
+    map.set_chunk_source(fill_grass);
+
+    map.set_tile(10, 20, TileType::BUSH);     // bottom edge 21
+    map.set_tile(5, 19, TileType::TREE);      // bottom edge 21, further left
+    map.set_tile(30, 4, TileType::BUSH);      // bottom edge 5
+    map.set_tile(CHUNK_SIZE + 1, 1, TileType::BUSH);
+
+    const auto& objects = map.get_chunk_objects(0, 0);
+    REQUIRE(objects.size() == 3);
+    REQUIRE(objects[0].x == 30);
+    REQUIRE(objects[1].x == 5);
+    REQUIRE(objects[1].sort_y == 21);
+    REQUIRE(objects[2].x == 10);
+    REQUIRE(map.get_chunk_objects(1, 0).size() == 1);
+
+    SECTION("Replacing an object removes it from the index") {
+        map.set_tile(5, 19, TileType::DIRT);
+        REQUIRE(objects.size() == 2);
+        REQUIRE(objects[1].type == TileType::BUSH);
+    }
+
+    SECTION("A tree footprint covering a bush removes the bush") {
+        map.set_tile(9, 19, TileType::TREE);
+        REQUIRE(objects.size() == 3);
+        REQUIRE(objects[2].x == 9);
+        REQUIRE(objects[2].type == TileType::TREE);
+        REQUIRE(map.get_tile(10, 20) == TileType::NONE);
+    }
+
+    SECTION("The index is rebuilt when an edited chunk is paged back in") {
+        map.set_streaming_budget(0);
+        map.set_streaming_margin(0);
+        float chunk_px = static_cast<float>(CHUNK_SIZE * 32);
+        map.update_streaming({ chunk_px, 0.0f, chunk_px - 1, chunk_px - 1 });
+        REQUIRE_FALSE(map.is_chunk_resident(0, 0));
+        REQUIRE(map.get_chunk_objects(0, 0).size() == 3);
+    }
+}
+
+TEST_CASE("Object footprints are resolved through cell refs", "[world][tilemap][objects]") {
+    using world::atoms::ChunkObject;
+    using world::atoms::CHUNK_AREA;
+
+    // A tree anchored in the last cell of chunk (0, 0); the other chunks leave
+    // its footprint NONE, as map files and the generator do
+    int edge = CHUNK_SIZE - 1;
+    Tilemap map;
+    map.init(CHUNK_SIZE * 2, CHUNK_SIZE * 2, 32);
+    map.set_chunk_source([edge](int cx, int cy, TileType* out_tiles) {
+        std::fill(out_tiles, out_tiles + CHUNK_AREA, TileType::GRASS);
+        if (cx == 0 && cy == 0) out_tiles[edge * CHUNK_SIZE + edge] = TileType::TREE;
+        if (cx == 1 && cy == 0) out_tiles[edge * CHUNK_SIZE] = TileType::NONE;
+        if (cx == 0 && cy == 1) out_tiles[edge] = TileType::NONE;
+        if (cx == 1 && cy == 1) out_tiles[0] = TileType::NONE;
+    });
+
+    // The covered chunk knows about the tree without paging its anchor chunk in
+    ChunkObject object;
+    REQUIRE(map.get_object_at(edge + 1, edge + 1, object));
+    REQUIRE_FALSE(map.is_chunk_resident(0, 0));
+    REQUIRE(object.x == edge);
+    REQUIRE(object.y == edge);
+    REQUIRE(object.type == TileType::TREE);
+    REQUIRE(object.width == 2);
+    REQUIRE(object.sort_y == edge + 2);
+    REQUIRE_FALSE(map.is_walkable(edge + 1, edge + 1));
+    REQUIRE(map.get_tile(edge + 1, edge + 1) == TileType::NONE);
+    REQUIRE(map.get_ground(edge, edge) == TileType::NONE);
+    REQUIRE_FALSE(map.get_object_at(edge + 2, edge + 1, object));
+
+    SECTION("Writing any covered cell removes the whole object") {
+        map.set_tile(edge + 1, edge + 1, TileType::DIRT);
+        REQUIRE(map.get_chunk_objects(0, 0).empty());
+        REQUIRE(map.is_walkable(edge, edge));
+        REQUIRE(map.is_walkable(edge + 1, edge));
+        REQUIRE(map.get_tile(edge + 1, edge + 1) == TileType::DIRT);
+        REQUIRE(map.get_ground(edge + 1, edge + 1) == TileType::DIRT);
+    }
+
+    SECTION("Refs survive eviction of either side") {
+        map.set_tile(2, 2, TileType::TREE);
+        map.set_streaming_budget(0);
+        map.set_streaming_margin(0);
+        float chunk_px = static_cast<float>(CHUNK_SIZE * 32);
+        map.update_streaming({ chunk_px * 2, chunk_px * 2, 1.0f, 1.0f });
+        REQUIRE(map.get_resident_chunk_count() == 0);
+
+        REQUIRE(map.get_object_at(3, 3, object));
+        REQUIRE(object.x == 2);
+        REQUIRE(map.get_object_at(edge + 1, edge, object));
+        REQUIRE(object.x == edge);
+        REQUIRE(map.get_chunk_objects(0, 0).size() == 2);
+    }
+}
@@ -0,0 +1,143 @@
+/// test_world_generator.cpp — Unit tests for the procedural world generator atom
+
+#include <catch2/catch_all.hpp>
+#include "../atoms/world_generator.hpp"
+#include "../atoms/tilemap.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+using namespace world::atoms;
+
+namespace {
+    GeneratorConfig make_config(std::uint32_t seed) {
+        GeneratorConfig config;
+        config.seed = seed;
+        config.width = CHUNK_SIZE * 8;
+        config.height = CHUNK_SIZE * 8;
+        config.clearing_x = 10;
+        config.clearing_y = 10;
+        config.clearing_w = 12;
+        config.clearing_h = 12;
+        return config;
+    }
+
+    std::vector<TileType> chunk(const WorldGenerator& generator, int cx, int cy) {
+        std::vector<TileType> tiles(CHUNK_AREA);
+        generator.generate_chunk(cx, cy, tiles.data());
+        return tiles;
+    }
+
+    std::vector<std::pair<int, int>> all_chunks() {
+        std::vector<std::pair<int, int>> coords;
+        for (int cy = 0; cy < 8; cy++) {
+            for (int cx = 0; cx < 8; cx++) {
+                coords.push_back({ cx, cy });
+            }
+        }
+        return coords;
+    }
+}
+
+TEST_CASE("Generation is deterministic per seed", "[world][generator]") {
+    WorldGenerator a, b, other;
+    a.start(make_config(42), 0);
+    b.start(make_config(42), 0);
+    other.start(make_config(43), 0);
+
+    REQUIRE(chunk(a, 3, 2) == chunk(b, 3, 2));
+    REQUIRE(chunk(a, 3, 2) == chunk(a, 3, 2));   // Regenerating gives the same chunk
+    REQUIRE(chunk(a, 3, 2) != chunk(other, 3, 2));
+
+    SECTION("Thread count and order do not matter") {
+        std::vector<std::pair<int, int>> coords = all_chunks();
+        std::vector<TileType> serial, parallel;
+        a.generate_chunks(coords, serial, 1);
+        a.generate_chunks(coords, parallel, 4);
+        REQUIRE(serial == parallel);
+
+        std::reverse(coords.begin(), coords.end());
+        std::vector<TileType> reversed;
+        a.generate_chunks(coords, reversed, 3);
+        REQUIRE(std::equal(reversed.begin(), reversed.begin() + CHUNK_AREA,
+                           serial.end() - CHUNK_AREA));
+    }
+}
+
+TEST_CASE("Generated world is a valid tilemap", "[world][generator]") {
+    WorldGenerator generator;
+    generator.start(make_config(7), 0);
+
+    Tilemap map;
+    map.init(CHUNK_SIZE * 8, CHUNK_SIZE * 8, 32);
+    map.set_chunk_source(generator.make_chunk_source());
+
+    int biome_counts[static_cast<int>(Biome::COUNT)] = {};
+    int trees = 0;
+    for (int y = 0; y < map.get_height(); y++) {
+        for (int x = 0; x < map.get_width(); x++) {
+            biome_counts[static_cast<int>(generator.biome_at(x, y))]++;
+            if (map.get_tile(x, y) != TileType::TREE) continue;
+            trees++;
+
+            // Footprints never overlap anything, even across chunk edges
+            REQUIRE(x + 1 < map.get_width());
+            REQUIRE(y + 1 < map.get_height());
+            REQUIRE(map.get_tile(x + 1, y) == TileType::NONE);
+            REQUIRE(map.get_tile(x, y + 1) == TileType::NONE);
+            REQUIRE(map.get_tile(x + 1, y + 1) == TileType::NONE);
+        }
+    }
+    REQUIRE(trees > 0);
+    REQUIRE(biome_counts[static_cast<int>(Biome::FOREST)] > 0);
+
+    // The clearing is open ground
+    for (int y = 10; y < 22; y++) {
+        for (int x = 10; x < 22; x++) {
+            REQUIRE(map.is_walkable(x, y));
+        }
+    }
+
+    // Nothing outside the map
+    std::vector<TileType> outside = chunk(generator, 8, 0);
+    REQUIRE(std::all_of(outside.begin(), outside.end(), [](TileType t) { return t == TileType::NONE; }));
+}
+
+TEST_CASE("Prefetched chunks come from the workers", "[world][generator][threads]") {
+    WorldGenerator generator;
+    generator.start(make_config(9), 2);
+    REQUIRE(generator.get_worker_count() == 2);
+
+    std::vector<TileType> tiles(CHUNK_AREA);
+    REQUIRE_FALSE(generator.take_ready(1, 1, tiles.data()));
+
+    generator.prefetch(1, 1);
+    bool ready = false;
+    for (int i = 0; i < 500 && !ready; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        ready = generator.take_ready(1, 1, tiles.data());
+    }
+    REQUIRE(ready);
+    REQUIRE(tiles == chunk(generator, 1, 1));
+
+    // Peeking copies a ready chunk and leaves it for the chunk source
+    generator.prefetch(3, 1);
+    ready = false;
+    for (int i = 0; i < 500 && !ready; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        ready = generator.peek_ready(3, 1, tiles.data());
+    }
+    REQUIRE(ready);
+    REQUIRE(tiles == chunk(generator, 3, 1));
+    std::fill(tiles.begin(), tiles.end(), TileType::NONE);
+    generator.make_peek_source()(3, 1, tiles.data());
+    REQUIRE(tiles == chunk(generator, 3, 1));
+    REQUIRE(generator.take_ready(3, 1, tiles.data()));
+    REQUIRE_FALSE(generator.peek_ready(3, 1, tiles.data()));
+
+    // Taken chunks are gone; stop drops anything still queued
+    REQUIRE_FALSE(generator.take_ready(1, 1, tiles.data()));
+    generator.prefetch(2, 2);
+    generator.stop();
+    REQUIRE(generator.get_worker_count() == 0);
+}
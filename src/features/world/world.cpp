@@ -3,6 +3,17 @@
 #include "atoms/tilemap.hpp"
 #include "atoms/camera.hpp"
 #include "atoms/obstacle_detector.hpp"
+#include "atoms/steering_table.hpp"
+#include "atoms/flow_field.hpp"
+#include "atoms/path_service.hpp"
+#include "atoms/cluster_graph.hpp"
+#include "atoms/region_map.hpp"
+#include "atoms/fov_field.hpp"
+#include "atoms/map_file.hpp"
+#include "atoms/spawn_loader.hpp"
+#include "atoms/world_generator.hpp"
+#include <algorithm>
+#include <cmath>
 #include <memory>
 
 namespace world {
@@ -12,11 +23,28 @@ namespace {
     std::unique_ptr<atoms::Tilemap> tilemap;
     std::unique_ptr<atoms::Camera> camera;
     std::unique_ptr<atoms::ObstacleDetector> obstacle_detector;
+    std::unique_ptr<atoms::SteeringTable> steering_table;
+    std::unique_ptr<atoms::FlowField> flow_field;
+    std::unique_ptr<atoms::PathService> path_service;
+    std::unique_ptr<atoms::ClusterGraph> cluster_graph;
+    std::unique_ptr<atoms::RegionMap> region_map;
+    std::unique_ptr<atoms::FovField> fov_field;
+    std::unique_ptr<atoms::MapFile> map_file;
+    std::unique_ptr<atoms::SpawnLoader> spawn_loader;
+    std::unique_ptr<atoms::WorldGenerator> generator;
     
-    // Map configuration
-    constexpr int MAP_WIDTH = 50;
-    constexpr int MAP_HEIGHT = 50;
+    // Map configuration (procedural world used when MAP_PATH is missing)
+    constexpr const char* MAP_PATH = "assets/maps/world.plmap";
+    constexpr const char* SPAWNS_PATH = "assets/maps/spawns.json";
+    constexpr int MAP_WIDTH = 512;
+    constexpr int MAP_HEIGHT = 512;
     constexpr int TILE_SIZE = 32;
+    constexpr std::uint32_t WORLD_SEED = 0x5EED1u;
+    constexpr int START_CLEARING = 6;    // Tiles kept open around the player start
+    constexpr float STEERING_CACHE_DISTANCE = 200.0f;   // get_steering_distances default
+    constexpr int FLOW_RADIUS = 32;      // Flow field reach in tiles around its target
+    constexpr int PATH_WORKERS = 1;      // Threads searching point-to-point paths
+    constexpr int SIGHT_RADIUS = 16;     // Line of sight reach in tiles around its origin
     
     // Debug flags
     bool show_obstacle_debug = false;
@@ -25,9 +53,54 @@ namespace {
 void init() {
     // Initialize tilemap
     tilemap = std::make_unique<atoms::Tilemap>();
-    tilemap->init(MAP_WIDTH, MAP_HEIGHT, TILE_SIZE);
+    
+    // Prefer the authored map; chunks are read from the mapping as they stream in
+    map_file = std::make_unique<atoms::MapFile>();
+    if (map_file->open(MAP_PATH)) {
+        tilemap->init(map_file->get_width(), map_file->get_height(), map_file->get_tile_size());
+        tilemap->set_chunk_source(map_file->make_chunk_source());
+        TraceLog(LOG_INFO, "Loaded map %s (%dx%d tiles)", MAP_PATH, map_file->get_width(), map_file->get_height());
+    } else {
+        TraceLog(LOG_INFO, "No map at %s (%s), generating world", MAP_PATH, map_file->get_error().c_str());
+        map_file.reset();
+        tilemap->init(MAP_WIDTH, MAP_HEIGHT, TILE_SIZE);
+        
+        // The player starts at the screen centre; keep it out of water and trees
+        atoms::GeneratorConfig config;
+        config.seed = WORLD_SEED;
+        config.width = MAP_WIDTH;
+        config.height = MAP_HEIGHT;
+        config.clearing_x = GetScreenWidth() / 2 / TILE_SIZE - START_CLEARING;
+        config.clearing_y = GetScreenHeight() / 2 / TILE_SIZE - START_CLEARING;
+        config.clearing_w = START_CLEARING * 2;
+        config.clearing_h = START_CLEARING * 2;
+        
+        // Chunks are regenerated on demand; workers prepare the ones just outside the view
+        generator = std::make_unique<atoms::WorldGenerator>();
+        generator->start(config);
+        tilemap->set_chunk_source(generator->make_chunk_source(), generator->make_peek_source());
+        tilemap->set_chunk_prefetch_callback([](int chunk_x, int chunk_y) {
+            generator->prefetch(chunk_x, chunk_y);
+        });
+        TraceLog(LOG_INFO, "Generating %dx%d world, seed %u, %d workers",
+                 MAP_WIDTH, MAP_HEIGHT, WORLD_SEED, generator->get_worker_count());
+    }
     tilemap->load_textures();
-    tilemap->generate_demo_map();
+    
+    // Authored spawns, bucketed per chunk and driven by chunk streaming
+    spawn_loader = std::make_unique<atoms::SpawnLoader>();
+    spawn_loader->init(tilemap->get_tile_size());
+    if (spawn_loader->load_file(SPAWNS_PATH)) {
+        TraceLog(LOG_INFO, "Loaded %d spawns from %s", spawn_loader->get_spawn_count(), SPAWNS_PATH);
+    } else {
+        TraceLog(LOG_INFO, "No spawns loaded from %s (%s)", SPAWNS_PATH, spawn_loader->get_error().c_str());
+    }
+    tilemap->set_chunk_activated_callback([](int chunk_x, int chunk_y) {
+        spawn_loader->activate_chunk(chunk_x, chunk_y);
+    });
+    tilemap->set_chunk_evicted_callback([](int chunk_x, int chunk_y) {
+        spawn_loader->retire_chunk(chunk_x, chunk_y);
+    });
     
     // Initialize camera
     camera = std::make_unique<atoms::Camera>();
@@ -36,42 +109,110 @@ void init() {
     // Set camera bounds to match world size
     camera->set_bounds(
         0, 0,
-        MAP_WIDTH * TILE_SIZE,
-        MAP_HEIGHT * TILE_SIZE
+        tilemap->get_width() * tilemap->get_tile_size(),
+        tilemap->get_height() * tilemap->get_tile_size()
     );
     
     // Initialize obstacle detector
     obstacle_detector = std::make_unique<atoms::ObstacleDetector>();
     obstacle_detector->init(tilemap.get());
+    
+    // 16-ray steering fans are served from per-tile cached distances
+    set_steering_cache(STEERING_CACHE_DISTANCE);
+    
+    // One flow field toward the chase target, shared by every enemy
+    flow_field = std::make_unique<atoms::FlowField>();
+    flow_field->init(tilemap.get(), FLOW_RADIUS);
+    
+    // Point-to-point paths are searched off the main thread
+    path_service = std::make_unique<atoms::PathService>();
+    path_service->start(tilemap.get(), PATH_WORKERS);
+    
+    // Long trips are planned over chunk entrances first
+    cluster_graph = std::make_unique<atoms::ClusterGraph>();
+    cluster_graph->init(tilemap.get());
+    
+    // Connected regions answer reachability before any search starts
+    region_map = std::make_unique<atoms::RegionMap>();
+    region_map->init(tilemap.get());
+    
+    // One field of view from the player answers every line-of-sight check
+    fov_field = std::make_unique<atoms::FovField>();
+    fov_field->init(tilemap.get(), SIGHT_RADIUS);
+    
+    // Edits patch the obstacle distance field, drop nearby steering entries,
+    // rebuild the flow field if they land in it, drop paths crossing them,
+    // mark the chunks they touch for re-summarising, update region labels
+    // and recast the field of view if they land in it
+    tilemap->set_tiles_changed_callback([](int min_x, int min_y, int max_x, int max_y) {
+        obstacle_detector->on_tiles_changed(min_x, min_y, max_x, max_y);
+        flow_field->invalidate(min_x, min_y, max_x, max_y);
+        path_service->invalidate(min_x, min_y, max_x, max_y);
+        cluster_graph->invalidate(min_x, min_y, max_x, max_y);
+        region_map->on_tiles_changed(min_x, min_y, max_x, max_y);
+        fov_field->invalidate(min_x, min_y, max_x, max_y);
+        if (steering_table) {
+            steering_table->invalidate(min_x, min_y, max_x, max_y);
+        }
+    });
 }
 
 void update(float dt) {
     if (camera) {
         camera->update(dt);
+        
+        // Keep the chunks around the view resident, evict far ones
+        if (tilemap) {
+            tilemap->update_streaming(camera->get_view());
+        }
     }
 }
 
 void render() {
     if (tilemap && camera) {
         tilemap->render(camera->get_view());
-        
-        // Draw obstacle debug visualization if enabled
-        if (show_obstacle_debug && obstacle_detector) {
-            obstacle_detector->draw_debug(true);
-        }
+    }
+}
+
+void render_debug() {
+    // Draw obstacle debug visualization if enabled
+    if (show_obstacle_debug && obstacle_detector) {
+        obstacle_detector->draw_debug(true);
     }
 }
 
 void cleanup() {
+    // Workers search their own snapshots, but stop them before anything else goes
+    path_service.reset();
+    
+    // Evicting the chunks retires their spawns, so the loader goes after the tilemap
     if (tilemap) {
         tilemap->cleanup();
         tilemap.reset();
     }
+    spawn_loader.reset();
+    
+    // The tilemap's chunk source reads from the mapping or the generator,
+    // so those go after it
+    map_file.reset();
+    generator.reset();
     
     camera.reset();
+    fov_field.reset();
+    region_map.reset();
+    cluster_graph.reset();
+    flow_field.reset();
+    steering_table.reset();
     obstacle_detector.reset();
 }
 
+void set_spawn_handlers(std::function<int(const enemies::EnemySpawnRequest&)> spawn,
+                        std::function<bool(const enemies::EnemySpawnRequest&, int)> retire) {
+    if (spawn_loader) {
+        spawn_loader->set_handlers(std::move(spawn), std::move(retire));
+    }
+}
+
 void set_camera_target(const Vector2& target) {
     if (camera) {
         camera->set_target(target);
@@ -85,6 +226,15 @@ bool is_walkable(float world_x, float world_y) {
     return true; // Default if no tilemap
 }
 
+float get_speed_factor(float world_x, float world_y) {
+    if (!tilemap) return 1.0f;
+    
+    float tile_size = static_cast<float>(tilemap->get_tile_size());
+    std::uint8_t cost = tilemap->get_move_cost(static_cast<int>(std::floor(world_x / tile_size)),
+                                               static_cast<int>(std::floor(world_y / tile_size)));
+    return cost > atoms::MOVE_COST_BASE ? static_cast<float>(atoms::MOVE_COST_BASE) / cost : 1.0f;
+}
+
 void get_world_bounds(float* out_min_x, float* out_min_y, float* out_max_x, float* out_max_y) {
     if (tilemap) {
         if (out_min_x) *out_min_x = 0;
@@ -118,10 +268,151 @@ float raycast(Vector2 origin, Vector2 direction, float max_distance) {
     return max_distance;
 }
 
+void raycast_batch(Vector2 origin, const Vector2* directions, int count, float max_distance, float* out_distances) {
+    if (!out_distances) return;
+    if (obstacle_detector) {
+        obstacle_detector->raycast_batch(origin, directions, count, max_distance, out_distances);
+    } else {
+        std::fill(out_distances, out_distances + count, max_distance);
+    }
+}
+
 void get_steering_distances(Vector2 position, float* out_distances, int num_rays, float max_distance) {
-    if (obstacle_detector && out_distances) {
-        obstacle_detector->create_steering_grid(position, out_distances, num_rays, max_distance);
+    if (!obstacle_detector || !out_distances) return;
+    
+    // The cache holds the 16 standard directions; shorter lookaheads clamp its distances
+    if (steering_table && num_rays == atoms::SteeringTable::NUM_DIRECTIONS &&
+        max_distance <= steering_table->get_max_distance()) {
+        steering_table->get_distances(position, out_distances);
+        for (int i = 0; i < num_rays; i++) {
+            out_distances[i] = std::min(out_distances[i], max_distance);
+        }
+        return;
+    }
+    obstacle_detector->create_steering_grid(position, out_distances, num_rays, max_distance);
+}
+
+void set_steering_cache(float max_distance) {
+    if (max_distance <= 0.0f || !tilemap || !obstacle_detector) {
+        steering_table.reset();
+        return;
+    }
+    steering_table = std::make_unique<atoms::SteeringTable>();
+    steering_table->init(tilemap.get(), obstacle_detector.get(), max_distance);
+}
+
+void set_flow_target(Vector2 target) {
+    if (flow_field && tilemap) {
+        float tile_size = static_cast<float>(tilemap->get_tile_size());
+        flow_field->set_target(static_cast<int>(std::floor(target.x / tile_size)),
+                               static_cast<int>(std::floor(target.y / tile_size)));
+    }
+}
+
+bool get_flow_direction(Vector2 position, Vector2* out_direction) {
+    if (!flow_field || !tilemap || !out_direction) return false;
+    
+    float tile_size = static_cast<float>(tilemap->get_tile_size());
+    int tile_x = static_cast<int>(std::floor(position.x / tile_size));
+    int tile_y = static_cast<int>(std::floor(position.y / tile_size));
+    std::uint8_t code = flow_field->get_direction_code(tile_x, tile_y);
+    if (code == atoms::FlowField::DIR_GOAL || code == atoms::FlowField::DIR_NONE) return false;
+    
+    // Head for the centre of the next tile, which keeps followers off the
+    // corners the path bends around
+    Vector2 step = atoms::FlowField::step_of(code);
+    float dx = (tile_x + step.x + 0.5f) * tile_size - position.x;
+    float dy = (tile_y + step.y + 0.5f) * tile_size - position.y;
+    float len = std::sqrt(dx * dx + dy * dy);
+    if (len <= 0.0f) return false;
+    *out_direction = { dx / len, dy / len };
+    return true;
+}
+
+void set_sight_origin(Vector2 origin) {
+    if (fov_field && tilemap) {
+        float tile_size = static_cast<float>(tilemap->get_tile_size());
+        fov_field->set_origin(static_cast<int>(std::floor(origin.x / tile_size)),
+                              static_cast<int>(std::floor(origin.y / tile_size)));
+    }
+}
+
+bool has_line_of_sight(Vector2 position) {
+    if (!fov_field || !tilemap) return false;
+    
+    float tile_size = static_cast<float>(tilemap->get_tile_size());
+    return fov_field->is_visible(static_cast<int>(std::floor(position.x / tile_size)),
+                                 static_cast<int>(std::floor(position.y / tile_size)));
+}
+
+bool is_reachable(Vector2 from, Vector2 to) {
+    if (!region_map || !tilemap) return false;
+    
+    float tile_size = static_cast<float>(tilemap->get_tile_size());
+    return region_map->is_reachable(static_cast<int>(std::floor(from.x / tile_size)),
+                                    static_cast<int>(std::floor(from.y / tile_size)),
+                                    static_cast<int>(std::floor(to.x / tile_size)),
+                                    static_cast<int>(std::floor(to.y / tile_size)));
+}
+
+unsigned request_path(Vector2 from, Vector2 to) {
+    if (!path_service || !tilemap) return 0;
+    
+    float tile_size = static_cast<float>(tilemap->get_tile_size());
+    atoms::TilePoint start = { static_cast<int>(std::floor(from.x / tile_size)),
+                               static_cast<int>(std::floor(from.y / tile_size)) };
+    atoms::TilePoint goal = { static_cast<int>(std::floor(to.x / tile_size)),
+                              static_cast<int>(std::floor(to.y / tile_size)) };
+    if (!region_map->is_reachable(start.x, start.y, goal.x, goal.y)) return 0;
+    return path_service->request(start, goal);
+}
+
+PathStatus poll_path(unsigned handle, std::vector<Vector2>* out_waypoints) {
+    if (!path_service || !tilemap) return PathStatus::NONE;
+    
+    std::vector<atoms::TilePoint> tiles;
+    switch (path_service->poll(handle, &tiles)) {
+        case atoms::PathStatus::PENDING:   return PathStatus::PENDING;
+        case atoms::PathStatus::NOT_FOUND: return PathStatus::NOT_FOUND;
+        case atoms::PathStatus::NONE:      return PathStatus::NONE;
+        case atoms::PathStatus::FOUND:     break;
+    }
+    
+    if (out_waypoints) {
+        float tile_size = static_cast<float>(tilemap->get_tile_size());
+        out_waypoints->clear();
+        for (std::size_t i = 1; i < tiles.size(); i++) {
+            out_waypoints->push_back({ (tiles[i].x + 0.5f) * tile_size, (tiles[i].y + 0.5f) * tile_size });
+        }
+    }
+    return PathStatus::FOUND;
+}
+
+void cancel_path(unsigned handle) {
+    if (path_service) {
+        path_service->cancel(handle);
+    }
+}
+
+bool plan_route(Vector2 from, Vector2 to, std::vector<Vector2>* out_route) {
+    if (!cluster_graph || !tilemap || !out_route) return false;
+    
+    float tile_size = static_cast<float>(tilemap->get_tile_size());
+    atoms::TilePoint start = { static_cast<int>(std::floor(from.x / tile_size)),
+                               static_cast<int>(std::floor(from.y / tile_size)) };
+    atoms::TilePoint goal = { static_cast<int>(std::floor(to.x / tile_size)),
+                              static_cast<int>(std::floor(to.y / tile_size)) };
+    std::vector<atoms::TilePoint> tiles;
+    if (!region_map->is_reachable(start.x, start.y, goal.x, goal.y)) return false;
+    if (!cluster_graph->plan(start, goal, tiles)) return false;
+    
+    // The goal itself rather than its tile centre
+    out_route->clear();
+    for (std::size_t i = 1; i + 1 < tiles.size(); i++) {
+        out_route->push_back({ (tiles[i].x + 0.5f) * tile_size, (tiles[i].y + 0.5f) * tile_size });
     }
+    out_route->push_back(to);
+    return true;
 }
 
 bool check_circle_collision(Vector2 center, float radius) {
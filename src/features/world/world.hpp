@@ -1,20 +1,36 @@
 /// world.hpp — public API for World slice (tilemap, camera)
 #pragma once
 #include <raylib.h>
+#include <functional>
+#include <vector>
+
+namespace enemies { struct EnemySpawnRequest; }
 
 namespace world {
 
 void init();
 void update(float dt);
-void render();
+void render();        // Ground now, objects into the core::render queue
+void render_debug();  // Debug overlays, drawn after the queue is flushed
 void cleanup();
 
+// Enemy factories for authored spawns (WORLDBUILDING.MD §6). Spawns materialise
+// when their map chunk streams in and are retired when it is evicted.
+// spawn returns a live handle (or -1); retire returns true if the enemy was still alive.
+void set_spawn_handlers(std::function<int(const enemies::EnemySpawnRequest&)> spawn,
+                        std::function<bool(const enemies::EnemySpawnRequest&, int)> retire);
+
 // Set player position for camera to follow
 void set_camera_target(const Vector2& target);
 
 // Check if a position is walkable
 bool is_walkable(float world_x, float world_y);
 
+// Movement speed multiplier of the ground at a position: 1 on open ground,
+// less on slow terrain (shallows); 1 on blocked tiles
+// PERF: O(1), one read from the packed cost grid
+float get_speed_factor(float world_x, float world_y);
+
 // Get world bounds for collision checking
 void get_world_bounds(float* out_min_x, float* out_min_y, float* out_max_x, float* out_max_y);
 
@@ -30,11 +46,76 @@ Vector2 world_to_screen(const Vector2& world_pos);
 /// Returns distance to nearest obstacle in the specified direction
 float raycast(Vector2 origin, Vector2 direction, float max_distance = 1000.0f);
 
+/// Cast a fan of rays from one origin in a single call
+/// Fills out_distances[i] with the distance to the nearest obstacle along
+/// directions[i], or max_distance if the ray is clear
+void raycast_batch(Vector2 origin, const Vector2* directions, int count, float max_distance, float* out_distances);
+
 /// Get steering distances around a point for navigation
 /// Fills out_distances array with distances to obstacles in evenly spaced directions
 /// Array must have space for num_rays entries
+/// With the steering cache on, 16-ray queries up to its distance are table lookups
 void get_steering_distances(Vector2 position, float* out_distances, int num_rays, float max_distance = 200.0f);
 
+/// Cache 16-direction steering distances per tile, up to max_distance
+/// (on by default at 200; 0 turns it off). Entries near edited tiles are
+/// recomputed on their next query.
+void set_steering_cache(float max_distance);
+
+/// Point the shared flow field at a target (the chase target, once per frame).
+/// The field is rebuilt only when the target enters a new tile or an edit lands near it.
+void set_flow_target(Vector2 target);
+
+/// Direction along the shortest walkable path from position to the flow target.
+/// False in the target's tile, where the target is unreachable, and beyond the
+/// field's reach (32 tiles); seek the target directly then.
+/// PERF: O(1), one packed direction read
+bool get_flow_direction(Vector2 position, Vector2* out_direction);
+
+/// Move the origin of the shared field of view (the player, once per frame).
+/// The field is recast only when the origin enters a new tile or an edit lands near it.
+void set_sight_origin(Vector2 origin);
+
+/// True if position's tile can be seen from the sight origin: trees and bushes
+/// cast shadows, water does not. False beyond the sight range (16 tiles).
+/// PERF: O(1), one bit test
+bool has_line_of_sight(Vector2 position);
+
+/// True if a walkable path joins the two points (a start brushing an
+/// obstacle counts from the open tile beside it, so this does not check
+/// that from itself is walkable; spawns must test is_walkable too)
+/// PERF: O(1) region label comparison once regions are labelled
+bool is_reachable(Vector2 from, Vector2 to);
+
+/// State of a path request
+enum class PathStatus {
+    NONE,        // Unknown handle (collected, cancelled or expired)
+    PENDING,     // Still searching
+    FOUND,
+    NOT_FOUND
+};
+
+/// Ask for a walkable path between two points. The search (A* with jump point
+/// search) runs on a worker thread; repeated requests between the same tiles
+/// are answered from a cache of recent paths. Returns 0 before init and when
+/// the goal is unreachable (no search is started).
+unsigned request_path(Vector2 from, Vector2 to);
+
+/// Collect a requested path. FOUND fills out_waypoints with the centres of the
+/// tiles where the path turns, ending with the goal tile (the start is left
+/// out); FOUND and NOT_FOUND free the handle. Unclaimed results expire.
+PathStatus poll_path(unsigned handle, std::vector<Vector2>* out_waypoints);
+
+/// Drop a request that is no longer wanted
+void cancel_path(unsigned handle);
+
+/// Plan a long trip over chunk entrances (HPA*). out_route receives the goal,
+/// preceded by the first tile centre of each chunk crossed on the way; walk
+/// it one leg at a time with request_path. Near trips get just the goal.
+/// PERF: chunks are summarised the first time a plan reaches them (one flood
+/// per entrance); later plans search entrances only
+bool plan_route(Vector2 from, Vector2 to, std::vector<Vector2>* out_route);
+
 /// Check if a circle overlaps with any obstacles
 bool check_circle_collision(Vector2 center, float radius);
 
@@ -0,0 +1,314 @@
+#!/usr/bin/env python3
+"""Convert a Tiled map (.json/.tmj or .tmx) into the binary .plmap format.
+
+Usage:
+    tools/tiled_to_plmap.py input.tmx assets/maps/world.plmap [--map GID=NAME ...]
+
+Tile types are resolved per tileset tile from its class/type ("grass", "dirt",
+"water", "tree", "bush") or a custom "tile" property. --map overrides or adds
+mappings for global tile IDs. Tile layers are composited in order (later
+non-empty tiles win); tree and bush tiles, and tile objects in object layers,
+go to the object layer anchored at their top-left tile.
+
+The layout must match src/features/world/atoms/map_file.hpp.
+"""
+
+import argparse
+import base64
+import gzip
+import json
+import os
+import struct
+import sys
+import xml.etree.ElementTree as ET
+import zlib
+
+MAGIC = b"PLMP"
+VERSION = 1
+CHUNK_SIZE = 64
+CHUNK_AREA = CHUNK_SIZE * CHUNK_SIZE
+
+# TileType IDs, in enum order
+TILE_IDS = {"none": 0, "grass": 1, "dirt": 2, "water": 3, "tree": 4, "bush": 5, "shallows": 6}
+OBJECT_TILES = {TILE_IDS["tree"], TILE_IDS["bush"]}
+
+HEADER = struct.Struct("<4sHHIIIIII")     # MapFileHeader, 32 bytes
+CHUNK_ENTRY = struct.Struct("<IIHBB")     # MapChunkEntry, 12 bytes
+MAP_OBJECT = struct.Struct("<IIB3x")      # MapObject, 12 bytes
+
+GID_MASK = 0x0FFFFFFF                     # Strip Tiled flip/rotation flags
+
+
+def fail(message):
+    sys.exit("tiled_to_plmap: " + message)
+
+
+def tile_name(value):
+    """Normalise a class/type/property string to a TILE_IDS key, or None."""
+    if not value:
+        return None
+    name = str(value).strip().lower()
+    return name if name in TILE_IDS else None
+
+
+# --- Tiled JSON -----------------------------------------------------------
+
+def decode_json_data(layer):
+    data = layer.get("data")
+    if isinstance(data, list):
+        return data
+    raw = base64.b64decode(data)
+    compression = layer.get("compression", "")
+    if compression == "zlib":
+        raw = zlib.decompress(raw)
+    elif compression == "gzip":
+        raw = gzip.decompress(raw)
+    elif compression:
+        fail("unsupported layer compression " + compression)
+    return list(struct.unpack("<%dI" % (len(raw) // 4), raw))
+
+
+def load_json_tileset(entry, base_dir):
+    tileset = entry
+    if "source" in entry:
+        path = os.path.join(base_dir, entry["source"])
+        if path.endswith(".tsx"):
+            return parse_tsx(ET.parse(path).getroot())
+        with open(path) as f:
+            tileset = json.load(f)
+    names = {}
+    for tile in tileset.get("tiles", []):
+        name = tile_name(tile.get("class") or tile.get("type"))
+        for prop in tile.get("properties", []):
+            if prop.get("name") == "tile":
+                name = tile_name(prop.get("value")) or name
+        if name:
+            names[tile["id"]] = name
+    return names
+
+
+def read_json(path):
+    with open(path) as f:
+        doc = json.load(f)
+    if doc.get("infinite"):
+        fail("infinite maps are not supported, resize the map to a fixed size")
+    base_dir = os.path.dirname(path)
+    gids = {}
+    for entry in doc.get("tilesets", []):
+        for local_id, name in load_json_tileset(entry, base_dir).items():
+            gids[entry["firstgid"] + local_id] = name
+
+    tile_layers, objects = [], []
+
+    def walk(layers):
+        for layer in layers:
+            if not layer.get("visible", True):
+                continue
+            if layer["type"] == "tilelayer":
+                tile_layers.append(decode_json_data(layer))
+            elif layer["type"] == "objectgroup":
+                for obj in layer.get("objects", []):
+                    objects.append((obj.get("gid", 0), obj.get("class") or obj.get("type"),
+                                    obj["x"], obj["y"], obj.get("height", 0)))
+            elif layer["type"] == "group":
+                walk(layer.get("layers", []))
+
+    walk(doc.get("layers", []))
+    return doc["width"], doc["height"], doc["tilewidth"], doc["tileheight"], gids, tile_layers, objects
+
+
+# --- Tiled TMX ------------------------------------------------------------
+
+def parse_tsx(root):
+    names = {}
+    for tile in root.findall("tile"):
+        name = tile_name(tile.get("class") or tile.get("type"))
+        for prop in tile.findall("properties/property"):
+            if prop.get("name") == "tile":
+                name = tile_name(prop.get("value")) or name
+        if name:
+            names[int(tile.get("id"))] = name
+    return names
+
+
+def decode_tmx_data(data):
+    encoding = data.get("encoding")
+    if encoding == "csv":
+        return [int(v) for v in data.text.replace("\n", "").split(",") if v.strip()]
+    if encoding == "base64":
+        raw = base64.b64decode(data.text.strip())
+        compression = data.get("compression")
+        if compression == "zlib":
+            raw = zlib.decompress(raw)
+        elif compression == "gzip":
+            raw = gzip.decompress(raw)
+        elif compression:
+            fail("unsupported layer compression " + compression)
+        return list(struct.unpack("<%dI" % (len(raw) // 4), raw))
+    if data.findall("chunk"):
+        fail("infinite maps are not supported, resize the map to a fixed size")
+    return [int(tile.get("gid", 0)) for tile in data.findall("tile")]
+
+
+def read_tmx(path):
+    root = ET.parse(path).getroot()
+    if root.get("infinite") == "1":
+        fail("infinite maps are not supported, resize the map to a fixed size")
+    base_dir = os.path.dirname(path)
+    gids = {}
+    for tileset in root.findall("tileset"):
+        first = int(tileset.get("firstgid"))
+        source = tileset.get("source")
+        if source:
+            source_path = os.path.join(base_dir, source)
+            if source_path.endswith(".tsx"):
+                names = parse_tsx(ET.parse(source_path).getroot())
+            else:
+                names = load_json_tileset({"source": source}, base_dir)
+        else:
+            names = parse_tsx(tileset)
+        for local_id, name in names.items():
+            gids[first + local_id] = name
+
+    tile_layers, objects = [], []
+
+    def walk(node):
+        for child in node:
+            if child.get("visible") == "0":
+                continue
+            if child.tag == "layer":
+                tile_layers.append(decode_tmx_data(child.find("data")))
+            elif child.tag == "objectgroup":
+                for obj in child.findall("object"):
+                    objects.append((int(obj.get("gid", 0)), obj.get("class") or obj.get("type"),
+                                    float(obj.get("x", 0)), float(obj.get("y", 0)),
+                                    float(obj.get("height", 0))))
+            elif child.tag == "group":
+                walk(child)
+
+    walk(root)
+    return (int(root.get("width")), int(root.get("height")),
+            int(root.get("tilewidth")), int(root.get("tileheight")), gids, tile_layers, objects)
+
+
+# --- Conversion -----------------------------------------------------------
+
+def convert(width, height, tile_w, tile_h, gids, tile_layers, raw_objects):
+    def resolve(gid):
+        name = gids.get(gid & GID_MASK)
+        return TILE_IDS[name] if name else None
+
+    tiles = bytearray([TILE_IDS["grass"]]) * (width * height)
+    placed = {}   # (x, y) -> tile id, later placements win like set_tile
+    unknown = set()
+
+    for data in tile_layers:
+        if len(data) != width * height:
+            fail("tile layer size does not match the map")
+        for i, gid in enumerate(data):
+            if gid == 0:
+                continue
+            tile = resolve(gid)
+            if tile is None:
+                unknown.add(gid & GID_MASK)
+            elif tile in OBJECT_TILES:
+                placed[(i % width, i // width)] = tile
+            else:
+                tiles[i] = tile
+
+    for gid, cls, px, py, obj_h in raw_objects:
+        tile = resolve(gid) if gid else None
+        if tile is None:
+            name = tile_name(cls)
+            tile = TILE_IDS[name] if name else None
+        if tile not in OBJECT_TILES:
+            continue
+        # Tile objects are anchored at their bottom-left corner
+        top = py - obj_h if gid else py
+        x, y = int(px // tile_w), int(round(top / tile_h))
+        if 0 <= x < width and 0 <= y < height:
+            placed[(x, y)] = tile
+
+    if unknown:
+        print("tiled_to_plmap: warning: no tile type for GIDs %s (kept grass)" % sorted(unknown),
+              file=sys.stderr)
+    return tiles, placed
+
+
+def write_plmap(path, width, height, tile_size, tiles, placed):
+    chunks_x = (width + CHUNK_SIZE - 1) // CHUNK_SIZE
+    chunks_y = (height + CHUNK_SIZE - 1) // CHUNK_SIZE
+
+    # Group objects by anchor chunk in directory order
+    by_chunk = {}
+    for (x, y), tile in sorted(placed.items(), key=lambda item: (item[0][1], item[0][0])):
+        by_chunk.setdefault((x // CHUNK_SIZE, y // CHUNK_SIZE), []).append((x, y, tile))
+
+    directory_offset = HEADER.size
+    objects_offset = directory_offset + chunks_x * chunks_y * CHUNK_ENTRY.size
+    blocks_offset = objects_offset + len(placed) * MAP_OBJECT.size
+
+    entries, objects, blocks = [], [], []
+    shared = {}   # Identical blocks are stored once
+    next_offset = blocks_offset
+    for cy in range(chunks_y):
+        for cx in range(chunks_x):
+            block = bytearray(CHUNK_AREA)   # Past the map edge stays NONE
+            for ly in range(min(CHUNK_SIZE, height - cy * CHUNK_SIZE)):
+                row = (cy * CHUNK_SIZE + ly) * width + cx * CHUNK_SIZE
+                count = min(CHUNK_SIZE, width - cx * CHUNK_SIZE)
+                block[ly * CHUNK_SIZE:ly * CHUNK_SIZE + count] = tiles[row:row + count]
+            block = bytes(block)
+
+            fill, offset = 0, 0
+            if block.count(block[0]) == CHUNK_AREA:
+                fill = block[0]
+            elif block in shared:
+                offset = shared[block]
+            else:
+                offset = shared[block] = next_offset
+                blocks.append(block)
+                next_offset += CHUNK_AREA
+
+            chunk_objects = by_chunk.get((cx, cy), [])
+            if len(chunk_objects) > 0xFFFF:
+                fail("more than 65535 objects in chunk (%d, %d)" % (cx, cy))
+            entries.append(CHUNK_ENTRY.pack(offset, len(objects), len(chunk_objects), fill, 0))
+            objects.extend(MAP_OBJECT.pack(x, y, tile) for x, y, tile in chunk_objects)
+
+    with open(path, "wb") as f:
+        f.write(HEADER.pack(MAGIC, VERSION, tile_size, width, height, CHUNK_SIZE,
+                            len(objects), directory_offset, objects_offset))
+        f.writelines(entries)
+        f.writelines(objects)
+        f.writelines(blocks)
+    return chunks_x * chunks_y, len(blocks), len(objects)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="Tiled map (.json, .tmj or .tmx)")
+    parser.add_argument("output", help="output .plmap file")
+    parser.add_argument("--map", action="append", default=[], metavar="GID=NAME",
+                        help="map a global tile ID to a tile type (%s)" % ", ".join(TILE_IDS))
+    args = parser.parse_args()
+
+    reader = read_tmx if args.input.endswith(".tmx") else read_json
+    width, height, tile_w, tile_h, gids, tile_layers, objects = reader(args.input)
+    if tile_w != tile_h:
+        fail("tiles must be square")
+
+    for mapping in args.map:
+        gid, _, name = mapping.partition("=")
+        if not tile_name(name):
+            fail("unknown tile type " + name)
+        gids[int(gid)] = tile_name(name)
+
+    tiles, placed = convert(width, height, tile_w, tile_h, gids, tile_layers, objects)
+    chunks, blocks, object_count = write_plmap(args.output, width, height, tile_w, tiles, placed)
+    print("Wrote %s: %dx%d tiles, %d chunks (%d stored), %d objects"
+          % (args.output, width, height, chunks, blocks, object_count))
+
+
+if __name__ == "__main__":
+    main()